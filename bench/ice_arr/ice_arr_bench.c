@@ -0,0 +1,594 @@
+// Benchmark suite of all public ice_arr functions (And hot paths of typed arrays) at 1e2..1e7 elements, With regression check against stored baseline
+// Build: cc -O2 -I../.. ice_arr_bench.c -o ice_arr_bench -lm -pthread
+//
+// Usage: ice_arr_bench [--csv | --json] [--max-size N] [--min-time SEC] [--filter TEXT] [--baseline FILE] [--threshold PERCENT]
+//
+// Reports best ns per call, ns per element and allocations per call (Counted by hooking ICE_ARR_MALLOC/CALLOC/REALLOC).
+// Ex. storing baseline before change and checking against it after:
+//
+//     ./ice_arr_bench --csv > base.csv
+//     ./ice_arr_bench --baseline base.csv --threshold 10
+//
+// Rows that got slower (ns/elem) by more than threshold percent or allocate more per call are reported as regressions,
+// And exit code is 1 if there is any. Sizes of 1e7 need about 1 GB of memory, Use --max-size to skip them.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static long long allocs = 0;
+
+static void* count_malloc(size_t sz) {
+    allocs++;
+    return malloc(sz);
+}
+
+static void* count_calloc(size_t n, size_t sz) {
+    allocs++;
+    return calloc(n, sz);
+}
+
+static void* count_realloc(void* ptr, size_t sz) {
+    allocs++;
+    return realloc(ptr, sz);
+}
+
+#define ICE_ARR_MALLOC(sz) count_malloc(sz)
+#define ICE_ARR_CALLOC(n, sz) count_calloc(n, sz)
+#define ICE_ARR_REALLOC(ptr, sz) count_realloc(ptr, sz)
+#define ICE_ARR_FREE(ptr) free(ptr)
+#define ICE_ARR_IMPL
+#include "ice_arr.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+// Same inputs as ice_arr_array ones below converted to element type of typed array (u8 values wrap at 256)
+#define BENCH_TYPED_CTX(t) struct { ice_arr_##t src, src2, sorted, sorted2, work, dst; } t
+
+// Inputs shared by all cases of same size, work is restored from src before each call of case that modifies it
+typedef struct bench_ctx {
+    ice_arr_array src;      // Random integers in [0, n) as doubles, About 1/8 of them are 0
+    ice_arr_array src2;     // Same as src but with other seed (Overlaps with src)
+    ice_arr_array sorted;   // src sorted
+    ice_arr_array sorted2;  // src2 sorted
+    ice_arr_array work;     // Array modified by case
+    ice_arr_array dst;      // Destination of _into functions (Keeps its memory between calls)
+    BENCH_TYPED_CTX(f32);
+    BENCH_TYPED_CTX(i32);
+    BENCH_TYPED_CTX(i64);
+    BENCH_TYPED_CTX(u8);
+    int n;
+} bench_ctx;
+
+typedef void (*bench_func)(bench_ctx* c);
+
+typedef struct bench_case {
+    const char* name;
+    bench_func f;
+    int modifies;           // 1 if case modifies c->work (Then each call is timed alone, After restoring work)
+} bench_case;
+
+static volatile double sink = 0;
+
+static void iter_sink(double n) { sink += n; }
+static void ctx_iter_sink(double n, void* ctx) { (void) ctx; if (n < 0) sink = n; }
+static double map_twice(double n, void* ctx) { (void) ctx; return n * 2; }
+static double reduce_add(double acc, double n, void* ctx) { (void) ctx; return acc + n; }
+static ice_arr_bool pred_odd(double n, void* ctx) { (void) ctx; return ((long long) n & 1) ? ICE_ARR_TRUE : ICE_ARR_FALSE; }
+static int cmp_asc(double a, double b) { return a > b; }
+
+// Each case calls function once (Results are freed inside case, So their allocations are counted too)
+static void b_new(bench_ctx* c) { ice_arr_free(ice_arr_new(c->n)); }
+static void b_get(bench_ctx* c) { double s = 0; for (int i = 0; i < c->n; i++) s += ice_arr_get(c->src, i); sink = s; }
+static void b_set(bench_ctx* c) { for (int i = 0; i < c->n; i++) ice_arr_set(&c->work, i, i); }
+static void b_len(bench_ctx* c) { sink = ice_arr_len(c->src); }
+static void b_pop(bench_ctx* c) { for (int i = 0; i < c->n; i++) ice_arr_pop(&c->work); }
+static void b_shift(bench_ctx* c) { for (int i = 0; i < c->n; i++) ice_arr_shift(&c->work); }
+static void b_push(bench_ctx* c) { for (int i = 0; i < c->n; i++) ice_arr_push(&c->work, i); }
+static void b_unshift(bench_ctx* c) { for (int i = 0; i < c->n; i++) ice_arr_unshift(&c->work, i); }
+static void b_rev(bench_ctx* c) { ice_arr_rev(&c->work); }
+static void b_fill(bench_ctx* c) { ice_arr_fill(&c->work, 1); }
+static void b_clear(bench_ctx* c) { ice_arr_clear(&c->work); }
+static void b_sum(bench_ctx* c) { sink = ice_arr_sum(c->src); }
+static void b_sum_kahan(bench_ctx* c) { sink = ice_arr_sum_kahan(c->src); }
+static void b_sum_pairwise(bench_ctx* c) { sink = ice_arr_sum_pairwise(c->src); }
+static void b_min(bench_ctx* c) { sink = ice_arr_min(c->src); }
+static void b_max(bench_ctx* c) { sink = ice_arr_max(c->src); }
+static void b_match(bench_ctx* c) { sink = ice_arr_match(c->src, c->src); }
+static void b_includes(bench_ctx* c) { sink = ice_arr_includes(c->src, -1); }
+static void b_matches(bench_ctx* c) { sink = ice_arr_matches(c->src, 0); }
+static void b_first_index(bench_ctx* c) { sink = ice_arr_first_index(c->src, -1); }
+static void b_last_index(bench_ctx* c) { sink = ice_arr_last_index(c->src, -1); }
+static void b_foreach(bench_ctx* c) { ice_arr_foreach(c->src, iter_sink); }
+static void b_rem(bench_ctx* c) { ice_arr_rem(&c->work, c->n / 2); }
+static void b_rotate(bench_ctx* c) { ice_arr_rotate(&c->work, c->n / 3); }
+static void b_move(bench_ctx* c) { ice_arr_move(&c->src, 0, c->n / 2, c->n / 4, &c->work); }
+static void b_reserve(bench_ctx* c) { ice_arr_reserve(&c->work, c->n * 2); }
+static void b_shrink_to_fit(bench_ctx* c) { ice_arr_shrink_to_fit(&c->work); }
+static void b_sort(bench_ctx* c) { ice_arr_sort(&c->work); }
+static void b_sort_desc(bench_ctx* c) { ice_arr_sort_desc(&c->work); }
+static void b_sort_ex(bench_ctx* c) { ice_arr_sort_ex(&c->work, cmp_asc); }
+static void b_sort_ex_stable(bench_ctx* c) { ice_arr_sort_ex_stable(&c->work, cmp_asc); }
+static void b_parallel_sort(bench_ctx* c) { ice_arr_parallel_sort(&c->work); }
+static void b_first(bench_ctx* c) { ice_arr_free(ice_arr_first(c->src, c->n / 2)); }
+static void b_last(bench_ctx* c) { ice_arr_free(ice_arr_last(c->src, c->n / 2)); }
+static void b_concat(bench_ctx* c) { ice_arr_free(ice_arr_concat(c->src, c->src2)); }
+static void b_sub(bench_ctx* c) { ice_arr_free(ice_arr_sub(c->src, c->n / 4, c->n / 4 * 3)); }
+static void b_without(bench_ctx* c) { ice_arr_free(ice_arr_without(c->src, 0)); }
+static void b_clone(bench_ctx* c) { ice_arr_free(ice_arr_clone(c->src, 2)); }
+static void b_rest(bench_ctx* c) { ice_arr_free(ice_arr_rest(c->src, c->n / 2)); }
+static void b_unique(bench_ctx* c) { ice_arr_free(ice_arr_unique(c->src)); }
+static void b_diff(bench_ctx* c) { ice_arr_free(ice_arr_diff(c->src, c->src2)); }
+static void b_range(bench_ctx* c) { ice_arr_free(ice_arr_range(c->n)); }
+static void b_compact(bench_ctx* c) { ice_arr_free(ice_arr_compact(c->src)); }
+static void b_tail(bench_ctx* c) { ice_arr_free(ice_arr_tail(c->src)); }
+static void b_intersect(bench_ctx* c) { ice_arr_free(ice_arr_intersect(c->src, c->src2)); }
+static void b_union(bench_ctx* c) { ice_arr_free(ice_arr_union(c->src, c->src2)); }
+static void b_unique_sorted(bench_ctx* c) { ice_arr_free(ice_arr_unique_sorted(c->sorted)); }
+static void b_diff_sorted(bench_ctx* c) { ice_arr_free(ice_arr_diff_sorted(c->sorted, c->sorted2)); }
+static void b_intersect_sorted(bench_ctx* c) { ice_arr_free(ice_arr_intersect_sorted(c->sorted, c->sorted2)); }
+static void b_union_sorted(bench_ctx* c) { ice_arr_free(ice_arr_union_sorted(c->sorted, c->sorted2)); }
+static void b_first_into(bench_ctx* c) { ice_arr_first_into(&c->dst, c->src, c->n / 2); }
+static void b_last_into(bench_ctx* c) { ice_arr_last_into(&c->dst, c->src, c->n / 2); }
+static void b_concat_into(bench_ctx* c) { ice_arr_concat_into(&c->dst, c->src, c->src2); }
+static void b_sub_into(bench_ctx* c) { ice_arr_sub_into(&c->dst, c->src, c->n / 4, c->n / 4 * 3); }
+static void b_without_into(bench_ctx* c) { ice_arr_without_into(&c->dst, c->src, 0); }
+static void b_clone_into(bench_ctx* c) { ice_arr_clone_into(&c->dst, c->src, 2); }
+static void b_rest_into(bench_ctx* c) { ice_arr_rest_into(&c->dst, c->src, c->n / 2); }
+static void b_unique_into(bench_ctx* c) { ice_arr_unique_into(&c->dst, c->src); }
+static void b_diff_into(bench_ctx* c) { ice_arr_diff_into(&c->dst, c->src, c->src2); }
+static void b_range_into(bench_ctx* c) { ice_arr_range_into(&c->dst, c->n); }
+static void b_compact_into(bench_ctx* c) { ice_arr_compact_into(&c->dst, c->src); }
+static void b_tail_into(bench_ctx* c) { ice_arr_tail_into(&c->dst, c->src); }
+static void b_intersect_into(bench_ctx* c) { ice_arr_intersect_into(&c->dst, c->src, c->src2); }
+static void b_union_into(bench_ctx* c) { ice_arr_union_into(&c->dst, c->src, c->src2); }
+static void b_unique_sorted_into(bench_ctx* c) { ice_arr_unique_sorted_into(&c->dst, c->sorted); }
+static void b_diff_sorted_into(bench_ctx* c) { ice_arr_diff_sorted_into(&c->dst, c->sorted, c->sorted2); }
+static void b_intersect_sorted_into(bench_ctx* c) { ice_arr_intersect_sorted_into(&c->dst, c->sorted, c->sorted2); }
+static void b_union_sorted_into(bench_ctx* c) { ice_arr_union_sorted_into(&c->dst, c->sorted, c->sorted2); }
+static void b_view_of(bench_ctx* c) { sink = ice_arr_view_of(c->src).len; }
+static void b_view_sub(bench_ctx* c) { sink = ice_arr_view_sub(c->src, 1, c->n / 2).len; }
+static void b_view_first(bench_ctx* c) { sink = ice_arr_view_first(c->src, c->n / 2).len; }
+static void b_view_last(bench_ctx* c) { sink = ice_arr_view_last(c->src, c->n / 2).len; }
+static void b_view_tail(bench_ctx* c) { sink = ice_arr_view_tail(c->src).len; }
+static void b_view_from(bench_ctx* c) { sink = ice_arr_view_from(c->src, c->n / 2).len; }
+static void b_from_view(bench_ctx* c) { sink = ice_arr_from_view(ice_arr_view_tail(c->src)).len; }
+static void b_parallel_foreach(bench_ctx* c) { ice_arr_parallel_foreach(c->src, ctx_iter_sink, NULL); }
+static void b_map(bench_ctx* c) { ice_arr_free(ice_arr_map(c->src, map_twice, NULL)); }
+static void b_map_into(bench_ctx* c) { ice_arr_map_into(&c->dst, c->src, map_twice, NULL); }
+static void b_reduce(bench_ctx* c) { sink = ice_arr_reduce(c->src, reduce_add, 0, NULL); }
+
+static void b_pipe_sum(bench_ctx* c) {
+    ice_arr_pipe p = ice_arr_pipe_new(c->src);
+    ice_arr_pipe_filter(&p, pred_odd, NULL);
+    ice_arr_pipe_map(&p, map_twice, NULL);
+    sink = ice_arr_pipe_sum(&p);
+}
+
+static void b_pipe_count(bench_ctx* c) {
+    ice_arr_pipe p = ice_arr_pipe_new(c->src);
+    ice_arr_pipe_compact(&p);
+    ice_arr_pipe_skip(&p, c->n / 4);
+    sink = ice_arr_pipe_count(&p);
+}
+
+static void b_pipe_min_max(bench_ctx* c) {
+    ice_arr_pipe p = ice_arr_pipe_new(c->src);
+    ice_arr_pipe_without(&p, 0);
+    ice_arr_pipe_take(&p, c->n / 2);
+    sink = ice_arr_pipe_min(&p) + ice_arr_pipe_max(&p);
+}
+
+static void b_pipe_reduce(bench_ctx* c) {
+    ice_arr_pipe p = ice_arr_pipe_new(c->src);
+    ice_arr_pipe_map(&p, map_twice, NULL);
+    sink = ice_arr_pipe_reduce(&p, reduce_add, 0, NULL);
+}
+
+static void b_pipe_foreach(bench_ctx* c) {
+    ice_arr_pipe p = ice_arr_pipe_new(c->src);
+    ice_arr_pipe_filter(&p, pred_odd, NULL);
+    ice_arr_pipe_foreach(&p, ctx_iter_sink, NULL);
+}
+
+static void b_pipe_to_array(bench_ctx* c) {
+    ice_arr_pipe p = ice_arr_pipe_new(c->src);
+    ice_arr_pipe_dedupe(&p);
+    ice_arr_free(ice_arr_pipe_to_array(&p));
+}
+
+static void b_pipe_into(bench_ctx* c) {
+    ice_arr_pipe p = ice_arr_pipe_new(c->src);
+    ice_arr_pipe_filter(&p, pred_odd, NULL);
+    ice_arr_pipe_map(&p, map_twice, NULL);
+    ice_arr_pipe_into(&c->dst, &p);
+}
+
+// Typed arrays share implementation with ice_arr_array, So only hot paths that depend on element type get measured:
+// Reductions and searches (Vectorized by compiler instead of SIMD kernels), push, Radix sort (Fewer passes) and set operations
+// Typed arrays have no map/reduce, So foreach stands for them.
+#define BENCH_TYPED_CASES(t, T)                                                                                     \
+static void t##_iter_sink(T n) { sink += n; }                                                                       \
+static void b_##t##_sum(bench_ctx* c) { sink = (double) ice_arr_##t##_sum(c->t.src); }                              \
+static void b_##t##_min_max(bench_ctx* c) { sink = (double) ice_arr_##t##_min(c->t.src) + ice_arr_##t##_max(c->t.src); } \
+static void b_##t##_matches(bench_ctx* c) { sink = ice_arr_##t##_matches(c->t.src, 0); }                           \
+static void b_##t##_includes(bench_ctx* c) { sink = ice_arr_##t##_includes(c->t.src, (T) -1); }                    \
+static void b_##t##_foreach(bench_ctx* c) { ice_arr_##t##_foreach(c->t.src, t##_iter_sink); }                       \
+static void b_##t##_push(bench_ctx* c) { for (int i = 0; i < c->n; i++) ice_arr_##t##_push(&c->t.work, (T) i); }   \
+static void b_##t##_sort(bench_ctx* c) { ice_arr_##t##_sort(&c->t.work); }                                          \
+static void b_##t##_sort_desc(bench_ctx* c) { ice_arr_##t##_sort_desc(&c->t.work); }                                \
+static void b_##t##_unique_into(bench_ctx* c) { ice_arr_##t##_unique_into(&c->t.dst, c->t.src); }                  \
+static void b_##t##_diff_into(bench_ctx* c) { ice_arr_##t##_diff_into(&c->t.dst, c->t.src, c->t.src2); }           \
+static void b_##t##_intersect_into(bench_ctx* c) { ice_arr_##t##_intersect_into(&c->t.dst, c->t.src, c->t.src2); } \
+static void b_##t##_union_into(bench_ctx* c) { ice_arr_##t##_union_into(&c->t.dst, c->t.src, c->t.src2); }         \
+static void b_##t##_intersect_sorted_into(bench_ctx* c) { ice_arr_##t##_intersect_sorted_into(&c->t.dst, c->t.sorted, c->t.sorted2); } \
+static void b_##t##_union_sorted_into(bench_ctx* c) { ice_arr_##t##_union_sorted_into(&c->t.dst, c->t.sorted, c->t.sorted2); }
+
+#define BENCH_TYPED_ENTRIES(t)                                                                                      \
+    { #t "_sum", b_##t##_sum, 0 },                                                                                  \
+    { #t "_min_max", b_##t##_min_max, 0 },                                                                          \
+    { #t "_matches", b_##t##_matches, 0 },                                                                          \
+    { #t "_includes", b_##t##_includes, 0 },                                                                        \
+    { #t "_foreach", b_##t##_foreach, 0 },                                                                          \
+    { #t "_push", b_##t##_push, 1 },                                                                                \
+    { #t "_sort", b_##t##_sort, 1 },                                                                                \
+    { #t "_sort_desc", b_##t##_sort_desc, 1 },                                                                      \
+    { #t "_unique_into", b_##t##_unique_into, 0 },                                                                  \
+    { #t "_diff_into", b_##t##_diff_into, 0 },                                                                      \
+    { #t "_intersect_into", b_##t##_intersect_into, 0 },                                                            \
+    { #t "_union_into", b_##t##_union_into, 0 },                                                                    \
+    { #t "_intersect_sorted_into", b_##t##_intersect_sorted_into, 0 },                                              \
+    { #t "_union_sorted_into", b_##t##_union_sorted_into, 0 },
+
+BENCH_TYPED_CASES(f32, float)
+BENCH_TYPED_CASES(i32, int)
+BENCH_TYPED_CASES(i64, long long)
+BENCH_TYPED_CASES(u8, unsigned char)
+
+static const bench_case cases[] = {
+    { "new", b_new, 0 },
+    { "get", b_get, 0 },
+    { "set", b_set, 1 },
+    { "len", b_len, 0 },
+    { "pop", b_pop, 1 },
+    { "shift", b_shift, 1 },
+    { "push", b_push, 1 },
+    { "unshift", b_unshift, 1 },
+    { "rev", b_rev, 1 },
+    { "fill", b_fill, 1 },
+    { "clear", b_clear, 1 },
+    { "sum", b_sum, 0 },
+    { "sum_kahan", b_sum_kahan, 0 },
+    { "sum_pairwise", b_sum_pairwise, 0 },
+    { "min", b_min, 0 },
+    { "max", b_max, 0 },
+    { "match", b_match, 0 },
+    { "includes", b_includes, 0 },
+    { "matches", b_matches, 0 },
+    { "first_index", b_first_index, 0 },
+    { "last_index", b_last_index, 0 },
+    { "foreach", b_foreach, 0 },
+    { "rem", b_rem, 1 },
+    { "rotate", b_rotate, 1 },
+    { "move", b_move, 1 },
+    { "reserve", b_reserve, 1 },
+    { "shrink_to_fit", b_shrink_to_fit, 1 },
+    { "sort", b_sort, 1 },
+    { "sort_desc", b_sort_desc, 1 },
+    { "sort_ex", b_sort_ex, 1 },
+    { "sort_ex_stable", b_sort_ex_stable, 1 },
+    { "parallel_sort", b_parallel_sort, 1 },
+    { "first", b_first, 0 },
+    { "last", b_last, 0 },
+    { "concat", b_concat, 0 },
+    { "sub", b_sub, 0 },
+    { "without", b_without, 0 },
+    { "clone", b_clone, 0 },
+    { "rest", b_rest, 0 },
+    { "unique", b_unique, 0 },
+    { "diff", b_diff, 0 },
+    { "range", b_range, 0 },
+    { "compact", b_compact, 0 },
+    { "tail", b_tail, 0 },
+    { "intersect", b_intersect, 0 },
+    { "union", b_union, 0 },
+    { "unique_sorted", b_unique_sorted, 0 },
+    { "diff_sorted", b_diff_sorted, 0 },
+    { "intersect_sorted", b_intersect_sorted, 0 },
+    { "union_sorted", b_union_sorted, 0 },
+    { "first_into", b_first_into, 0 },
+    { "last_into", b_last_into, 0 },
+    { "concat_into", b_concat_into, 0 },
+    { "sub_into", b_sub_into, 0 },
+    { "without_into", b_without_into, 0 },
+    { "clone_into", b_clone_into, 0 },
+    { "rest_into", b_rest_into, 0 },
+    { "unique_into", b_unique_into, 0 },
+    { "diff_into", b_diff_into, 0 },
+    { "range_into", b_range_into, 0 },
+    { "compact_into", b_compact_into, 0 },
+    { "tail_into", b_tail_into, 0 },
+    { "intersect_into", b_intersect_into, 0 },
+    { "union_into", b_union_into, 0 },
+    { "unique_sorted_into", b_unique_sorted_into, 0 },
+    { "diff_sorted_into", b_diff_sorted_into, 0 },
+    { "intersect_sorted_into", b_intersect_sorted_into, 0 },
+    { "union_sorted_into", b_union_sorted_into, 0 },
+    { "view_of", b_view_of, 0 },
+    { "view_sub", b_view_sub, 0 },
+    { "view_first", b_view_first, 0 },
+    { "view_last", b_view_last, 0 },
+    { "view_tail", b_view_tail, 0 },
+    { "view_from", b_view_from, 0 },
+    { "from_view", b_from_view, 0 },
+    { "parallel_foreach", b_parallel_foreach, 0 },
+    { "map", b_map, 0 },
+    { "map_into", b_map_into, 0 },
+    { "reduce", b_reduce, 0 },
+    { "pipe_sum", b_pipe_sum, 0 },
+    { "pipe_count", b_pipe_count, 0 },
+    { "pipe_min_max", b_pipe_min_max, 0 },
+    { "pipe_reduce", b_pipe_reduce, 0 },
+    { "pipe_foreach", b_pipe_foreach, 0 },
+    { "pipe_to_array", b_pipe_to_array, 0 },
+    { "pipe_into", b_pipe_into, 0 },
+    BENCH_TYPED_ENTRIES(f32)
+    BENCH_TYPED_ENTRIES(i32)
+    BENCH_TYPED_ENTRIES(i64)
+    BENCH_TYPED_ENTRIES(u8)
+};
+
+#define CASES_COUNT ((int) (sizeof(cases) / sizeof(cases[0])))
+
+typedef struct bench_result {
+    char name[64];
+    int size;
+    long long calls;
+    double ns_per_call;
+    double ns_per_elem;
+    double allocs_per_call;
+} bench_result;
+
+static void fill_random(ice_arr_array* arr, unsigned int seed) {
+    for (int i = 0; i < arr->len; i++) {
+        seed = seed * 1103515245 + 12345;
+        arr->arr[i] = ((seed >> 8) & 7) ? (double) ((seed >> 4) % (unsigned int) arr->len) : 0;
+    }
+}
+
+#define BENCH_TYPED_INIT(t, T)                                                      \
+    do {                                                                            \
+        c.t.src = ice_arr_##t##_new(c.n);                                           \
+        c.t.src2 = ice_arr_##t##_new(c.n);                                          \
+                                                                                    \
+        for (int i = 0; i < c.n; i++) {                                             \
+            c.t.src.arr[i] = (T) c.src.arr[i];                                      \
+            c.t.src2.arr[i] = (T) c.src2.arr[i];                                    \
+        }                                                                           \
+                                                                                    \
+        c.t.sorted = ice_arr_##t##_first(c.t.src, c.n);                             \
+        c.t.sorted2 = ice_arr_##t##_first(c.t.src2, c.n);                           \
+        ice_arr_##t##_sort(&c.t.sorted);                                            \
+        ice_arr_##t##_sort(&c.t.sorted2);                                           \
+        c.t.work = ice_arr_##t##_new(0);                                            \
+        c.t.dst = ice_arr_##t##_new(0);                                             \
+    } while (0)
+
+#define BENCH_TYPED_FREE(t)                                                         \
+    do {                                                                            \
+        ice_arr_##t##_free(c.t.src);                                                \
+        ice_arr_##t##_free(c.t.src2);                                               \
+        ice_arr_##t##_free(c.t.sorted);                                             \
+        ice_arr_##t##_free(c.t.sorted2);                                            \
+        ice_arr_##t##_free(c.t.work);                                               \
+        ice_arr_##t##_free(c.t.dst);                                                \
+    } while (0)
+
+static void restore(bench_ctx* c) {
+    ice_arr_first_into(&c->work, c->src, c->n);
+    ice_arr_f32_first_into(&c->f32.work, c->f32.src, c->n);
+    ice_arr_i32_first_into(&c->i32.work, c->i32.src, c->n);
+    ice_arr_i64_first_into(&c->i64.work, c->i64.src, c->n);
+    ice_arr_u8_first_into(&c->u8.work, c->u8.src, c->n);
+}
+
+// Runs case until min_time passes (At least once) and keeps best time, So noise from other processes mostly doesn't show up
+// Cases that don't modify work are timed in batches so timer cost doesn't count
+static bench_result run(const bench_case* bc, bench_ctx* c, double min_time) {
+    bench_result res;
+    double total = 0, best = -1;
+    long long calls = 0, total_allocs = 0;
+    int batch = bc->modifies ? 1 : ((c->n < 100000) ? 100000 / c->n : 1);
+
+    if (bc->modifies) restore(c);
+    bc->f(c);
+
+    while (calls == 0 || total < min_time) {
+        if (bc->modifies) restore(c);
+
+        long long a = allocs;
+        double t = now();
+
+        for (int i = 0; i < batch; i++) {
+            bc->f(c);
+        }
+
+        t = now() - t;
+        total += t;
+        best = (best < 0 || t / batch < best) ? t / batch : best;
+        total_allocs += allocs - a;
+        calls += batch;
+    }
+
+    memset(&res, 0, sizeof(res));
+    strncpy(res.name, bc->name, sizeof(res.name) - 1);
+    res.size = c->n;
+    res.calls = calls;
+    res.ns_per_call = best * 1e9;
+    res.ns_per_elem = res.ns_per_call / c->n;
+    res.allocs_per_call = (double) total_allocs / calls;
+    return res;
+}
+
+static int load_baseline(const char* path, bench_result** out) {
+    FILE* f = fopen(path, "r");
+    char line[256];
+    int len = 0, cap = 256;
+
+    if (f == NULL) {
+        return -1;
+    }
+
+    *out = (bench_result*) malloc(cap * sizeof(bench_result));
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        bench_result r;
+        memset(&r, 0, sizeof(r));
+
+        // Skips header and broken lines
+        if (sscanf(line, "%63[^,],%d,%lld,%lf,%lf,%lf", r.name, &r.size, &r.calls, &r.ns_per_call, &r.ns_per_elem, &r.allocs_per_call) != 6) {
+            continue;
+        }
+
+        if (len == cap) {
+            cap *= 2;
+            *out = (bench_result*) realloc(*out, cap * sizeof(bench_result));
+        }
+
+        (*out)[len++] = r;
+    }
+
+    fclose(f);
+    return len;
+}
+
+static void usage(const char* exe) {
+    printf("Usage: %s [--csv | --json] [--max-size N] [--min-time SEC] [--filter TEXT] [--baseline FILE] [--threshold PERCENT]\n", exe);
+}
+
+int main(int argc, char** argv) {
+    int sizes[] = { 100, 1000, 10000, 100000, 1000000, 10000000 };
+    int format = 0, max_size = 10000000, rows = 0, regressions = 0;
+    double min_time = 0.05, threshold = 10;
+    const char* filter = NULL;
+    const char* baseline_path = NULL;
+    bench_result* results = (bench_result*) malloc(CASES_COUNT * 6 * sizeof(bench_result));
+    bench_result* baseline = NULL;
+    int baseline_len = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) format = 1;
+        else if (strcmp(argv[i], "--json") == 0) format = 2;
+        else if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) max_size = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) min_time = atof(argv[++i]);
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) filter = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) baseline_path = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) threshold = atof(argv[++i]);
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (baseline_path != NULL && (baseline_len = load_baseline(baseline_path, &baseline)) < 0) {
+        fprintf(stderr, "Couldn't open baseline %s\n", baseline_path);
+        return 2;
+    }
+
+    if (format == 0) printf("%-28s %10s %12s %14s %10s %10s\n", "function", "elements", "calls", "ns/call", "ns/elem", "allocs");
+    else if (format == 1) printf("function,size,calls,ns_per_call,ns_per_elem,allocs_per_call\n");
+    else printf("[\n");
+
+    for (int s = 0; s < 6 && sizes[s] <= max_size; s++) {
+        bench_ctx c;
+
+        memset(&c, 0, sizeof(c));
+        c.n = sizes[s];
+        c.src = ice_arr_new(c.n);
+        c.src2 = ice_arr_new(c.n);
+        fill_random(&c.src, 12345);
+        fill_random(&c.src2, 67890);
+        c.sorted = ice_arr_first(c.src, c.n);
+        c.sorted2 = ice_arr_first(c.src2, c.n);
+        ice_arr_sort(&c.sorted);
+        ice_arr_sort(&c.sorted2);
+        c.work = ice_arr_new(0);
+        c.dst = ice_arr_new(0);
+        BENCH_TYPED_INIT(f32, float);
+        BENCH_TYPED_INIT(i32, int);
+        BENCH_TYPED_INIT(i64, long long);
+        BENCH_TYPED_INIT(u8, unsigned char);
+
+        for (int i = 0; i < CASES_COUNT; i++) {
+            if (filter != NULL && strstr(cases[i].name, filter) == NULL) {
+                continue;
+            }
+
+            bench_result r = run(&cases[i], &c, min_time);
+            results[rows++] = r;
+
+            if (format == 0) printf("%-28s %10d %12lld %14.1f %10.3f %10.2f\n", r.name, r.size, r.calls, r.ns_per_call, r.ns_per_elem, r.allocs_per_call);
+            else if (format == 1) printf("%s,%d,%lld,%.3f,%.6f,%.3f\n", r.name, r.size, r.calls, r.ns_per_call, r.ns_per_elem, r.allocs_per_call);
+            else printf("%s  { \"function\": \"%s\", \"size\": %d, \"calls\": %lld, \"ns_per_call\": %.3f, \"ns_per_elem\": %.6f, \"allocs_per_call\": %.3f }", (rows > 1) ? ",\n" : "", r.name, r.size, r.calls, r.ns_per_call, r.ns_per_elem, r.allocs_per_call);
+
+            fflush(stdout);
+        }
+
+        ice_arr_free(c.src);
+        ice_arr_free(c.src2);
+        ice_arr_free(c.sorted);
+        ice_arr_free(c.sorted2);
+        ice_arr_free(c.work);
+        ice_arr_free(c.dst);
+        BENCH_TYPED_FREE(f32);
+        BENCH_TYPED_FREE(i32);
+        BENCH_TYPED_FREE(i64);
+        BENCH_TYPED_FREE(u8);
+    }
+
+    if (format == 2) printf("\n]\n");
+
+    // Comparison goes to stderr, So stdout stays valid CSV/JSON
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < baseline_len; j++) {
+            if (results[i].size != baseline[j].size || strcmp(results[i].name, baseline[j].name) != 0) {
+                continue;
+            }
+
+            double change = (baseline[j].ns_per_elem > 0) ? (results[i].ns_per_elem / baseline[j].ns_per_elem - 1) * 100 : 0;
+            int slower = change > threshold;
+            int more_allocs = results[i].allocs_per_call > baseline[j].allocs_per_call + 0.5;
+
+            if (slower || more_allocs) {
+                fprintf(stderr, "REGRESSION %-28s %10d  ns/elem %.3f -> %.3f (%+.1f%%)  allocs %.2f -> %.2f\n", results[i].name, results[i].size,
+                        baseline[j].ns_per_elem, results[i].ns_per_elem, change, baseline[j].allocs_per_call, results[i].allocs_per_call);
+                regressions++;
+            }
+
+            break;
+        }
+    }
+
+    if (baseline_path != NULL) {
+        fprintf(stderr, "%d regression(s) against %s (Threshold %.1f%%)\n", regressions, baseline_path, threshold);
+    }
+
+    free(results);
+    free(baseline);
+    ice_arr_threads_free();
+    return (regressions > 0) ? 1 : 0;
+}
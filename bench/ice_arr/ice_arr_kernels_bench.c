@@ -0,0 +1,82 @@
+// Throughput benchmark for ice_arr reduction kernels (GB/s per kernel and SIMD level)
+// Build: cc -O2 -I../.. ice_arr_kernels_bench.c -o ice_arr_kernels_bench -lm
+#define ICE_ARR_IMPL
+#include <stdio.h>
+#include "ice_arr.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+static const char* level_names[] = { "scalar", "sse2", "avx2", "neon" };
+static const char* kernel_names[] = { "sum", "sum_kahan", "sum_pairwise", "min", "max", "matches", "includes" };
+
+// Keeps results alive so compiler doesn't remove benchmarked calls
+static volatile double sink;
+
+static double run_kernel(int kernel, ice_arr_array arr) {
+    switch (kernel) {
+        case 0: return ice_arr_sum(arr);
+        case 1: return ice_arr_sum_kahan(arr);
+        case 2: return ice_arr_sum_pairwise(arr);
+        case 3: return ice_arr_min(arr);
+        case 4: return ice_arr_max(arr);
+        case 5: return ice_arr_matches(arr, 0.5);
+        case 6: return ice_arr_includes(arr, -1.0);
+    }
+    
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int sizes[] = { 4096, 1 << 22 };
+    
+    printf("%-8s %-14s %10s %10s\n", "level", "kernel", "elements", "GB/s");
+    
+    for (int s = 0; s < 2; s++) {
+        ice_arr_array arr = ice_arr_new(sizes[s]);
+        
+        for (int i = 0; i < arr.len; i++) {
+            arr.arr[i] = (double) (i % 1000) / 1000.0;
+        }
+        
+        // Repeat small arrays more so every measurement touches ~1 GB
+        int reps = (int) (((double) (1 << 30)) / (arr.len * sizeof(double)));
+        if (reps < 1) reps = 1;
+        
+        for (int l = ICE_ARR_SIMD_NONE; l <= ICE_ARR_SIMD_NEON; l++) {
+            if (ice_arr_simd_set_level((ice_arr_simd) l) == ICE_ARR_FALSE) continue;
+            
+            for (int k = 0; k < 7; k++) {
+                double best = 1e30;
+                
+                for (int trial = 0; trial < 3; trial++) {
+                    double t = now();
+                    for (int r = 0; r < reps; r++) sink = run_kernel(k, arr);
+                    t = now() - t;
+                    if (t < best) best = t;
+                }
+                
+                double bytes = (double) arr.len * sizeof(double) * reps;
+                printf("%-8s %-14s %10d %10.2f\n", level_names[l], kernel_names[k], arr.len, bytes / best / 1e9);
+            }
+        }
+        
+        ice_arr_free(arr);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Benchmark of ice_arr parallel functions against their serial counterparts at 1, 2, 4, ... up to all cores
+// Build: cc -O2 -I../.. ice_arr_parallel_bench.c -o ice_arr_parallel_bench -lm -pthread
+#define ICE_ARR_IMPL
+#include <stdio.h>
+#include "ice_arr.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+static double work(double n, void* ctx) {
+    (void) ctx;
+    return sqrt(n * n + 1.0) * 0.5;
+}
+
+static double add(double acc, double n, void* ctx) {
+    (void) ctx;
+    return acc + n;
+}
+
+static void touch(double n, void* ctx) {
+    (void) n;
+    (void) ctx;
+}
+
+int main(int argc, char** argv) {
+    int len = (argc > 1) ? atoi(argv[1]) : 10000000;
+    int cores = ice_arr_threads_count();
+    ice_arr_array src = ice_arr_new(len);
+    ice_arr_array arr = ice_arr_new(len);
+    ice_arr_array out = ice_arr_new(len);
+    unsigned int seed = 12345;
+    
+    for (int i = 0; i < len; i++) {
+        seed = seed * 1103515245 + 12345;
+        src.arr[i] = (double) seed / 4294967296.0 * 2000.0 - 1000.0;
+    }
+    
+    printf("%d elements, %d cores\n", len, cores);
+    printf("%8s %12s %12s %12s %12s\n", "threads", "map ms", "reduce ms", "foreach ms", "sort ms");
+    
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > cores) threads = cores;
+        ice_arr_threads_set(threads);
+        
+        double t0 = now();
+        ice_arr_map_into(&out, src, work, NULL);
+        double t1 = now();
+        double sum = ice_arr_reduce(src, add, 0, NULL);
+        double t2 = now();
+        ice_arr_parallel_foreach(src, touch, NULL);
+        double t3 = now();
+        ice_arr_move(&src, 0, len, 0, &arr);
+        double t4 = now();
+        ice_arr_parallel_sort(&arr);
+        double t5 = now();
+        
+        printf("%8d %12.2f %12.2f %12.2f %12.2f  (sum %.3f)\n", threads, (t1 - t0) * 1e3, (t2 - t1) * 1e3, (t3 - t2) * 1e3, (t5 - t4) * 1e3, sum);
+        
+        if (threads == cores) break;
+    }
+    
+    ice_arr_threads_free();
+    ice_arr_free(src);
+    ice_arr_free(arr);
+    ice_arr_free(out);
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Benchmark of ice_arr sorting against old O(n^2) exchange sort at 1K, 100K and 10M elements
+// Build: cc -O2 -I../.. ice_arr_sort_bench.c -o ice_arr_sort_bench -lm
+#define ICE_ARR_IMPL
+#include <stdio.h>
+#include "ice_arr.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+// ice_arr_sort before introsort/radix sort (Kept here only for comparison)
+static void old_sort(ice_arr_array* arr) {
+    for (int i = 0; i < arr->len; ++i) {
+        for (int j = i + 1; j < arr->len; ++j) {
+            if (arr->arr[i] > arr->arr[j]) {
+                double temp = arr->arr[i];
+                arr->arr[i] = arr->arr[j];
+                arr->arr[j] = temp;
+            }
+        }
+    }
+}
+
+static void sort_ex_asc(ice_arr_array* arr) {
+    ice_arr_sort_ex(arr, ice_arr_cmp_asc);
+}
+
+static void sort_ex_stable_asc(ice_arr_array* arr) {
+    ice_arr_sort_ex_stable(arr, ice_arr_cmp_asc);
+}
+
+typedef void (*sort_func)(ice_arr_array* arr);
+
+int main(int argc, char** argv) {
+    int sizes[] = { 1000, 100000, 10000000 };
+    const char* names[] = { "old_exchange", "sort (radix)", "sort_desc (radix)", "sort_ex (introsort)", "sort_ex_stable (merge)" };
+    sort_func funcs[] = { old_sort, ice_arr_sort, ice_arr_sort_desc, sort_ex_asc, sort_ex_stable_asc };
+    
+    printf("%-24s %10s %12s %12s\n", "sort", "elements", "ms", "ns/elem");
+    
+    for (int s = 0; s < 3; s++) {
+        ice_arr_array src = ice_arr_new(sizes[s]);
+        ice_arr_array arr = ice_arr_new(sizes[s]);
+        unsigned int seed = 12345;
+        
+        for (int i = 0; i < src.len; i++) {
+            seed = seed * 1103515245 + 12345;
+            src.arr[i] = ((double) (seed >> 8) - (double) (1 << 23)) / 1000.0;
+        }
+        
+        for (int f = 0; f < 5; f++) {
+            // Old exchange sort would take hours at 10M elements
+            if (f == 0 && src.len > 100000) {
+                printf("%-24s %10d %12s %12s\n", names[f], src.len, "skipped", "-");
+                continue;
+            }
+            
+            memcpy(arr.arr, src.arr, src.len * sizeof(double));
+            
+            double t = now();
+            funcs[f](&arr);
+            t = now() - t;
+            
+            printf("%-24s %10d %12.3f %12.2f\n", names[f], src.len, t * 1e3, t * 1e9 / src.len);
+        }
+        
+        ice_arr_free(src);
+        ice_arr_free(arr);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,142 @@
+// Benchmark of copying big file (fread/fwrite loop vs ice_fs_copy_file) and build output tree of small files (Shell copy vs ice_fs_copy_dir)
+// Build: cc -O2 -I../.. ice_fs_copy_bench.c -o ice_fs_copy_bench -lpthread
+// Run: ice_fs_copy_bench [size of big file in MB] (Default 512)
+#define ICE_FS_IMPL
+#include <stdio.h>
+#include "ice_fs.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+#define SRC "ice_fs_copy_bench.tmp"
+#define DST "ice_fs_copy_bench_copy.tmp"
+#define TREE "ice_fs_copy_bench_tree"
+#define TREE_COPY "ice_fs_copy_bench_tree_copy"
+#define DIRS 64
+#define FILES 64
+
+static unsigned int seed = 12345;
+
+static unsigned int rnd(void) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+// Removes files first and directories after, Deepest first
+static void remove_tree(char* dir) {
+    ice_fs_walk_options opts = ice_fs_walk_options_default();
+    ice_fs_walk_entry entry;
+    ice_fs_walker walker;
+    char** paths = (char**) malloc(sizeof(char*) * (DIRS * (FILES + 1) + 1));
+    int count = 0;
+
+    opts.dirs = 1;
+
+    if (ice_fs_walk_open(dir, &opts, &walker) == ICE_FS_TRUE) {
+        while (ice_fs_walk_next(&walker, &entry) == ICE_FS_TRUE && count < DIRS * (FILES + 1)) {
+            paths[count] = (char*) malloc(strlen(entry.path) + 2);
+            paths[count][0] = (entry.type == ICE_FS_ENTRY_DIR) ? 'd' : 'f';
+            strcpy(paths[count] + 1, entry.path);
+            count++;
+        }
+
+        ice_fs_walk_close(&walker);
+    }
+
+    for (int i = count - 1; i >= 0; i--) {
+        if (paths[i][0] == 'd') ice_fs_remove_dir(paths[i] + 1);
+        else ice_fs_remove_file(paths[i] + 1);
+        free(paths[i]);
+    }
+
+    ice_fs_remove_dir(dir);
+    free(paths);
+}
+
+int main(int argc, char** argv) {
+    int mb = (argc > 1) ? atoi(argv[1]) : 512;
+    char* buf = (char*) malloc(1 << 20);
+    char path[256];
+    char cmd[512];
+    FILE* f = fopen(SRC, "wb");
+
+    for (int i = 0; i < (1 << 20); i++) buf[i] = (char) rnd();
+    for (int i = 0; i < mb; i++) fwrite(buf, 1, 1 << 20, f);
+    fclose(f);
+
+    printf("%-28s %12s %12s\n", "big file", "ms", "MB/s");
+
+    // Old way, Every byte passes through buffer of process
+    double t = now();
+    FILE* in = fopen(SRC, "rb");
+    FILE* out = fopen(DST, "wb");
+    size_t n;
+
+    while ((n = fread(buf, 1, 65536, in)) > 0) fwrite(buf, 1, n, out);
+
+    fclose(in);
+    fclose(out);
+    t = now() - t;
+    printf("%-28s %12.3f %12.1f\n", "fread/fwrite", t * 1e3, mb / t);
+    remove(DST);
+
+    t = now();
+    ice_fs_copy_file(SRC, DST);
+    t = now() - t;
+    printf("%-28s %12.3f %12.1f\n", "ice_fs_copy_file", t * 1e3, mb / t);
+    remove(DST);
+    remove(SRC);
+
+    // Build output, Many directories of small object files
+    ice_fs_create_dir(TREE);
+
+    for (int d = 0; d < DIRS; d++) {
+        snprintf(path, sizeof(path), "%s/module%d", TREE, d);
+        ice_fs_create_dir(path);
+
+        for (int i = 0; i < FILES; i++) {
+            snprintf(path, sizeof(path), "%s/module%d/unit%d.o", TREE, d, i);
+            f = fopen(path, "wb");
+            fwrite(buf, 1, 4096 + rnd() % 65536, f);
+            fclose(f);
+        }
+    }
+
+    printf("\n%-28s %12s %12s\n", "tree", "ms", "files");
+
+#if defined(_WIN32)
+    snprintf(cmd, sizeof(cmd), "xcopy %s %s /E /H /C /I /Q > NUL", TREE, TREE_COPY);
+#else
+    snprintf(cmd, sizeof(cmd), "cp -R %s %s", TREE, TREE_COPY);
+#endif
+
+    t = now();
+    system(cmd);
+    t = now() - t;
+    printf("%-28s %12.3f %12d\n", "shell copy", t * 1e3, DIRS * FILES);
+    remove_tree(TREE_COPY);
+
+    t = now();
+    ice_fs_copy_dir(TREE, TREE_COPY);
+    t = now() - t;
+    printf("%-28s %12.3f %12d\n", "ice_fs_copy_dir", t * 1e3, DIRS * FILES);
+    remove_tree(TREE_COPY);
+
+    remove_tree(TREE);
+    free(buf);
+    return 0;
+}
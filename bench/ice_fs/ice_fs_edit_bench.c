@@ -0,0 +1,67 @@
+// Benchmark of editing 100 lines of big file (ice_fs_edit_line per line vs one ice_fs_line_edits batch)
+// Build: cc -O2 -I../.. ice_fs_edit_bench.c -o ice_fs_edit_bench
+// Run: ice_fs_edit_bench [count of lines] (Default 1000000)
+#define ICE_FS_IMPL
+#include <stdio.h>
+#include "ice_fs.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+#define FNAME "ice_fs_edit_bench.tmp"
+#define EDITS 100
+
+static unsigned int seed = 12345;
+
+static unsigned int rnd(void) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+int main(int argc, char** argv) {
+    int lines = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int targets[EDITS];
+    FILE* f = fopen(FNAME, "wb");
+
+    // Config-like lines of 30 to 60 chars
+    for (int i = 0; i < lines; i++) {
+        fprintf(f, "setting_%d = %u # default%*s\n", i, rnd(), (int) (rnd() % 30), "");
+    }
+
+    fclose(f);
+    for (int i = 0; i < EDITS; i++) targets[i] = rnd() % lines;
+
+    printf("%-28s %8s %12s\n", "method", "edits", "ms");
+
+    // Every edit rewrites whole file
+    double t = now();
+    for (int i = 0; i < EDITS; i++) ice_fs_edit_line(FNAME, targets[i], "setting = changed");
+    t = now() - t;
+    printf("%-28s %8d %12.3f\n", "ice_fs_edit_line per edit", EDITS, t * 1e3);
+
+    // All edits in one rewrite
+    ice_fs_line_edits edits = ice_fs_line_edits_new();
+    t = now();
+    for (int i = 0; i < EDITS; i++) ice_fs_line_edits_replace(&edits, targets[i], "setting = changed again");
+    ice_fs_line_edits_apply(&edits, FNAME);
+    t = now() - t;
+    printf("%-28s %8d %12.3f\n", "ice_fs_line_edits batch", EDITS, t * 1e3);
+
+    ice_fs_line_edits_free(&edits);
+    remove(FNAME);
+    return 0;
+}
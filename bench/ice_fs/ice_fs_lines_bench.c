@@ -0,0 +1,100 @@
+// Benchmark of random line access in big log file (Rescanning file with fgets per line vs ice_fs_line_index)
+// Build: cc -O2 -I../.. ice_fs_lines_bench.c -o ice_fs_lines_bench
+// Run: ice_fs_lines_bench [count of lines] (Default 10000000)
+#define ICE_FS_IMPL
+#include <stdio.h>
+#include "ice_fs.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+#define FNAME "ice_fs_lines_bench.tmp"
+#define RESCANS 20
+#define LOOKUPS 1000000
+
+static unsigned int seed = 12345;
+
+static unsigned int rnd(void) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+// Keeps results alive so compiler doesn't remove benchmarked calls
+static volatile unsigned long long sink;
+
+int main(int argc, char** argv) {
+    int lines = (argc > 1) ? atoi(argv[1]) : 10000000;
+    FILE* f = fopen(FNAME, "wb");
+    char buf[1024];
+
+    // Log lines of 40 to 120 chars
+    for (int i = 0; i < lines; i++) {
+        fprintf(f, "2021-04-25 12:%02d:%02d [worker %u] request %d took %u ms%*s\n", (i / 60) % 60, i % 60, rnd() % 16, i, rnd() % 1000, (int) (rnd() % 60), "");
+    }
+
+    fclose(f);
+    printf("%-28s %12s %14s\n", "method", "ms", "us/line");
+
+    // Old way, Every line is found by reading file from start
+    double t = now();
+    unsigned long long sum = 0;
+
+    for (int r = 0; r < RESCANS; r++) {
+        int target = rnd() % lines;
+        f = fopen(FNAME, "rb");
+        for (int l = 0; l <= target && fgets(buf, sizeof(buf), f) != NULL; l++);
+        sum += buf[0];
+        fclose(f);
+    }
+
+    t = now() - t;
+    sink = sum;
+    printf("%-28s %12.3f %14.3f\n", "fgets rescan per line", t * 1e3, t * 1e6 / RESCANS);
+
+    t = now();
+    sink = ice_fs_lines_count(FNAME);
+    t = now() - t;
+    printf("%-28s %12.3f %14s\n", "ice_fs_lines_count", t * 1e3, "-");
+
+    ice_fs_line_index index;
+    t = now();
+
+    if (ice_fs_line_index_open(FNAME, &index) == ICE_FS_FALSE) {
+        fprintf(stderr, "Couldn't index %s\n", FNAME);
+        remove(FNAME);
+        return 1;
+    }
+
+    t = now() - t;
+    printf("%-28s %12.3f %14s\n", "ice_fs_line_index_open", t * 1e3, "-");
+
+    t = now();
+    sum = 0;
+
+    for (int r = 0; r < LOOKUPS; r++) {
+        ice_fs_line_view line = ice_fs_line_index_get(&index, rnd() % lines);
+        sum += line.len + line.ptr[0];
+    }
+
+    t = now() - t;
+    sink = sum;
+    printf("%-28s %12.3f %14.3f\n", "ice_fs_line_index_get", t * 1e3, t * 1e6 / LOOKUPS);
+
+    ice_fs_line_index_free(&index);
+    remove(FNAME);
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Benchmark of loading large file (ice_fs_file_content copy to heap vs ice_fs_map), Time to first byte, Time to read all bytes and heap used
+// Build: cc -O2 -I../.. ice_fs_map_bench.c -o ice_fs_map_bench
+// Run: ice_fs_map_bench [size in MB] (Default 512)
+#define ICE_FS_IMPL
+#include <stdio.h>
+#include "ice_fs.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+#define FNAME "ice_fs_map_bench.tmp"
+
+// Keeps results alive so compiler doesn't remove benchmarked calls
+static volatile unsigned long long sink;
+
+// Reads one byte of every 4 KB page, So every page gets loaded
+static unsigned long long touch(const unsigned char* data, unsigned long long size) {
+    unsigned long long sum = 0;
+    for (unsigned long long i = 0; i < size; i += 4096) sum += data[i];
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    unsigned long long mb = (argc > 1) ? (unsigned long long) atoi(argv[1]) : 512;
+    unsigned long long size = mb << 20;
+    char* block = (char*) malloc(1 << 20);
+    FILE* f = fopen(FNAME, "wb");
+
+    // File is written right before benchmark, So both methods read it from page cache
+    for (int i = 0; i < (1 << 20); i++) block[i] = (char) ('a' + i % 26);
+    for (unsigned long long i = 0; i < mb; i++) fwrite(block, 1, 1 << 20, f);
+    fclose(f);
+    free(block);
+
+    printf("%-22s %12s %14s %12s\n", "method", "first ms", "all pages ms", "heap MB");
+
+    double t = now();
+    char* content = ice_fs_file_content(FNAME);
+    double first = now() - t;
+    sink = touch((unsigned char*) content, size);
+    t = now() - t;
+    printf("%-22s %12.3f %14.3f %12llu\n", "ice_fs_file_content", first * 1e3, t * 1e3, mb);
+    free(content);
+
+    ice_fs_map_view view;
+    t = now();
+    ice_fs_map(FNAME, ICE_FS_MAP_READ, &view);
+    first = now() - t;
+    sink = touch((unsigned char*) view.data, view.size);
+    t = now() - t;
+    printf("%-22s %12.3f %14.3f %12d\n", "ice_fs_map", first * 1e3, t * 1e3, 0);
+    ice_fs_unmap(&view);
+
+    t = now();
+    ice_fs_map(FNAME, ICE_FS_MAP_READ, &view);
+    ice_fs_map_advise(&view, ICE_FS_MAP_WILLNEED);
+    first = now() - t;
+    sink = touch((unsigned char*) view.data, view.size);
+    t = now() - t;
+    printf("%-22s %12.3f %14.3f %12d\n", "ice_fs_map + WILLNEED", first * 1e3, t * 1e3, 0);
+    ice_fs_unmap(&view);
+
+    remove(FNAME);
+    return 0;
+}
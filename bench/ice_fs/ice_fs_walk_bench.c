@@ -0,0 +1,117 @@
+// Benchmark of walking big directory tree (Recursive readdir + stat per entry vs ice_fs_walk vs ice_fs_walk_parallel)
+// Build: cc -O2 -I../.. ice_fs_walk_bench.c -o ice_fs_walk_bench -lpthread
+// Run: ice_fs_walk_bench [directory] (Default /usr, Or C:\Windows on Windows)
+#define ICE_FS_IMPL
+#include <stdio.h>
+#include "ice_fs.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+// Old way, Every entry is stat'ed to find out whether it is directory
+static int walk_stat(char* dir) {
+    struct dirent* e;
+    struct stat st;
+    char path[4096];
+    int count = 0;
+    DIR* d = opendir(dir);
+
+    if (d == NULL) return 0;
+
+    while ((e = readdir(d)) != NULL) {
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+
+        snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+#if defined(_WIN32)
+        if (stat(path, &st) < 0) continue;
+#else
+        if (lstat(path, &st) < 0) continue;
+#endif
+
+        count++;
+        if (S_ISDIR(st.st_mode)) count += walk_stat(path);
+    }
+
+    closedir(d);
+    return count;
+}
+
+// Runs on many threads at once, Count of entries comes back from ice_fs_walk_parallel
+static void count_entry(ice_fs_walk_entry* entry, void* user) {
+    (void) entry;
+    (void) user;
+}
+
+int main(int argc, char** argv) {
+#if defined(_WIN32)
+    char* dir = (argc > 1) ? argv[1] : "C:\\Windows";
+#else
+    char* dir = (argc > 1) ? argv[1] : "/usr";
+#endif
+    ice_fs_walk_options opts = ice_fs_walk_options_default();
+    int threads[] = { 2, 4, 8 };
+
+    opts.dirs = 1;
+
+    // First walk only warms up directory cache, So all methods read same cached metadata
+    walk_stat(dir);
+    printf("%-28s %12s %12s\n", "method", "ms", "entries");
+
+    double t = now();
+    int count = walk_stat(dir);
+    t = now() - t;
+    printf("%-28s %12.3f %12d\n", "readdir + stat", t * 1e3, count);
+
+    ice_fs_walker walker;
+    ice_fs_walk_entry entry;
+
+    t = now();
+    count = 0;
+
+    if (ice_fs_walk_open(dir, &opts, &walker) == ICE_FS_TRUE) {
+        while (ice_fs_walk_next(&walker, &entry) == ICE_FS_TRUE) count++;
+        ice_fs_walk_close(&walker);
+    }
+
+    t = now() - t;
+    printf("%-28s %12.3f %12d\n", "ice_fs_walk", t * 1e3, count);
+
+    for (int i = 0; i < 3; i++) {
+        char name[64];
+
+        t = now();
+        count = ice_fs_walk_parallel(dir, &opts, threads[i], count_entry, NULL);
+        t = now() - t;
+        snprintf(name, sizeof(name), "ice_fs_walk_parallel (%d)", threads[i]);
+        printf("%-28s %12.3f %12d\n", name, t * 1e3, count);
+    }
+
+    // Filter is applied to names as they are read, Before any path is built for them
+    opts.dirs = 0;
+    opts.pattern = "*.h;*.c";
+    t = now();
+    count = 0;
+
+    if (ice_fs_walk_open(dir, &opts, &walker) == ICE_FS_TRUE) {
+        while (ice_fs_walk_next(&walker, &entry) == ICE_FS_TRUE) count++;
+        ice_fs_walk_close(&walker);
+    }
+
+    t = now() - t;
+    printf("%-28s %12.3f %12d\n", "ice_fs_walk \"*.h;*.c\"", t * 1e3, count);
+    return 0;
+}
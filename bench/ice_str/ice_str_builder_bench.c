@@ -0,0 +1,99 @@
+// Benchmark of building text from pieces (ice_str_concat loop vs ice_str_builder) and editing middle of large text (memmove vs ice_str_rope)
+// Build: cc -O2 -I../.. ice_str_builder_bench.c -o ice_str_builder_bench
+#define ICE_STR_IMPL
+#include <stdio.h>
+#include "ice_str.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+int main(int argc, char** argv) {
+    int pieces[] = { 1000, 10000, 100000 };
+    int sizes[] = { 1 << 20, 1 << 24 };
+
+    printf("%-24s %10s %12s\n", "build", "pieces", "ms");
+
+    for (int p = 0; p < 3; p++) {
+        // Old way, Every concat copies whole string built so far (Skipped where it would take minutes)
+        if (pieces[p] <= 10000) {
+            char* res = ice_str_strdup("");
+            double t = now();
+
+            for (int i = 0; i < pieces[p]; i++) {
+                char* next = ice_str_concat(res, "field=value, ");
+                ice_str_free(res);
+                res = next;
+            }
+
+            t = now() - t;
+            printf("%-24s %10d %12.3f\n", "concat loop", pieces[p], t * 1e3);
+            ice_str_free(res);
+        } else {
+            printf("%-24s %10d %12s\n", "concat loop", pieces[p], "skipped");
+        }
+
+        ice_str_builder b = ice_str_builder_new();
+        double t = now();
+
+        for (int i = 0; i < pieces[p]; i++) {
+            ice_str_builder_append(&b, "field=");
+            ice_str_builder_append_int(&b, i);
+            ice_str_builder_append(&b, ", ");
+        }
+
+        char* res = ice_str_builder_finish(&b);
+        t = now() - t;
+        printf("%-24s %10d %12.3f\n", "builder", pieces[p], t * 1e3);
+        ice_str_free(res);
+    }
+
+    printf("\n%-24s %10s %12s\n", "1000 edits in middle", "bytes", "ms");
+
+    for (int s = 0; s < 2; s++) {
+        char* flat = (char*) malloc(sizes[s] + 1000 * 16);
+        int len = sizes[s];
+
+        memset(flat, 'x', len);
+
+        ice_str_rope rope = ice_str_rope_new_len(flat, len);
+        double t = now();
+
+        for (int i = 0; i < 1000; i++) {
+            int pos = len / 2 + i;
+            memmove(flat + pos + 16, flat + pos, len - pos);
+            memcpy(flat + pos, "inserted text...", 16);
+            len += 16;
+        }
+
+        t = now() - t;
+        printf("%-24s %10d %12.3f\n", "memmove", sizes[s], t * 1e3);
+
+        t = now();
+
+        for (int i = 0; i < 1000; i++) {
+            ice_str_rope_insert_len(&rope, sizes[s] / 2 + i, "inserted text...", 16);
+        }
+
+        t = now() - t;
+        printf("%-24s %10d %12.3f\n", "rope", sizes[s], t * 1e3);
+
+        ice_str_rope_free(&rope);
+        free(flat);
+    }
+
+    return 0;
+}
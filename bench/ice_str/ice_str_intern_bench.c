@@ -0,0 +1,133 @@
+// Benchmark of symbol lookups (ice_str_match per candidate vs ice_str_intern_pool handles) and ice_str_hash throughput
+// Build: cc -O2 -I../.. ice_str_intern_bench.c -o ice_str_intern_bench
+#define ICE_STR_IMPL
+#include <stdio.h>
+#include "ice_str.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+#define SYMBOLS 64
+#define LOOKUPS 1000000
+
+// Keeps results alive so compiler doesn't remove benchmarked calls
+static volatile unsigned long long sink;
+
+int main(int argc, char** argv) {
+    char* names[SYMBOLS];
+    char* handles[SYMBOLS];
+    char* queries[LOOKUPS / 1000];
+    char* query_handles[LOOKUPS / 1000];
+    unsigned int seed = 12345;
+    ice_str_intern_pool pool = ice_str_intern_pool_new();
+
+    // Identifiers share long prefixes, Like members of generated code
+    for (int i = 0; i < SYMBOLS; i++) {
+        names[i] = (char*) malloc(32);
+        sprintf(names[i], "generated_member_name_%d", i);
+        handles[i] = ice_str_intern_pool_add(&pool, names[i]);
+    }
+
+    // Queries are separate copies, Like identifiers coming from parser
+    for (int i = 0; i < LOOKUPS / 1000; i++) {
+        seed = seed * 1103515245 + 12345;
+        queries[i] = ice_str_strdup(names[(seed >> 8) % SYMBOLS]);
+    }
+
+    printf("%-28s %12s %12s\n", "lookup", "ms", "ns/lookup");
+
+    double t = now();
+    unsigned long long found = 0;
+
+    for (int i = 0; i < LOOKUPS; i++) {
+        char* q = queries[i % (LOOKUPS / 1000)];
+
+        for (int s = 0; s < SYMBOLS; s++) {
+            if (ice_str_match(names[s], q) == ICE_STR_TRUE) {
+                found += s;
+                break;
+            }
+        }
+    }
+
+    t = now() - t;
+    sink = found;
+    printf("%-28s %12.3f %12.2f\n", "ice_str_match scan", t * 1e3, t * 1e9 / LOOKUPS);
+
+    // Interning once per query, Then every comparison is pointer comparison
+    t = now();
+    for (int i = 0; i < LOOKUPS / 1000; i++) query_handles[i] = ice_str_intern_pool_add(&pool, queries[i]);
+    found = 0;
+
+    for (int i = 0; i < LOOKUPS; i++) {
+        char* q = query_handles[i % (LOOKUPS / 1000)];
+
+        for (int s = 0; s < SYMBOLS; s++) {
+            if (handles[s] == q) {
+                found += s;
+                break;
+            }
+        }
+    }
+
+    t = now() - t;
+    sink = found;
+    printf("%-28s %12.3f %12.2f\n", "intern + handle scan", t * 1e3, t * 1e9 / LOOKUPS);
+
+    t = now();
+    found = 0;
+
+    for (int i = 0; i < LOOKUPS; i++) {
+        found += (unsigned long long) ice_str_intern_pool_find(&pool, queries[i % (LOOKUPS / 1000)]);
+    }
+
+    t = now() - t;
+    sink = found;
+    printf("%-28s %12.3f %12.2f\n", "ice_str_intern_pool_find", t * 1e3, t * 1e9 / LOOKUPS);
+
+    int sizes[] = { 8, 32, 256, 1 << 20 };
+    char* data = (char*) malloc((1 << 20) + 1);
+
+    for (int i = 0; i < (1 << 20); i++) data[i] = (char) ('a' + i % 26);
+    data[1 << 20] = '\0';
+
+    printf("\n%-28s %12s %12s\n", "hash", "bytes", "GB/s");
+
+    for (int s = 0; s < 4; s++) {
+        int reps = (1 << 28) / sizes[s];
+        unsigned long long h = 0;
+
+        t = now();
+        for (int r = 0; r < reps; r++) h += ice_str_hash_len(data + (r & 7), sizes[s]);
+        t = now() - t;
+        sink = h;
+        printf("%-28s %12d %12.2f\n", "ice_str_hash_len", sizes[s], (double) sizes[s] * reps / t / 1e9);
+
+        h = 0;
+        t = now();
+        for (int r = 0; r < reps / 4; r++) h += ice_str_view_hash_nocase(ice_str_view_from_len(data + (r & 7), sizes[s]));
+        t = now() - t;
+        sink = h;
+        printf("%-28s %12d %12.2f\n", "ice_str_view_hash_nocase", sizes[s], (double) sizes[s] * (reps / 4) / t / 1e9);
+    }
+
+    for (int i = 0; i < SYMBOLS; i++) free(names[i]);
+    for (int i = 0; i < LOOKUPS / 1000; i++) ice_str_free(queries[i]);
+    free(data);
+    ice_str_intern_pool_free(&pool);
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Benchmark of ice_str_matcher against strstr per keyword for filtering log lines with 10, 100 and 1000 keywords
+// Build: cc -O2 -I../.. ice_str_matcher_bench.c -o ice_str_matcher_bench
+#define ICE_STR_IMPL
+#include <stdio.h>
+#include "ice_str.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+#define LINES 20000
+#define LINE_LEN 120
+
+static unsigned int seed = 12345;
+
+static unsigned int rnd(void) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+// Lowercase words of 4 to 10 letters, Like identifiers in log messages
+static void rnd_word(char* res, int len) {
+    for (int i = 0; i < len; i++) res[i] = (char) ('a' + rnd() % 26);
+    res[len] = '\0';
+}
+
+int main(int argc, char** argv) {
+    int counts[] = { 10, 100, 1000 };
+    char** lines = (char**) malloc(LINES * sizeof(char*));
+
+    for (int l = 0; l < LINES; l++) {
+        lines[l] = (char*) malloc(LINE_LEN + 1);
+
+        int len = 0;
+        while (len < LINE_LEN - 11) {
+            int wlen = 4 + rnd() % 7;
+            rnd_word(lines[l] + len, wlen);
+            len += wlen;
+            lines[l][len++] = ' ';
+        }
+
+        lines[l][len] = '\0';
+    }
+
+    printf("%-10s %-10s %12s %12s %10s\n", "keywords", "method", "ms", "MB/s", "matched");
+
+    for (int c = 0; c < 3; c++) {
+        char** keywords = (char**) malloc((counts[c] + 1) * sizeof(char*));
+
+        for (int k = 0; k < counts[c]; k++) {
+            keywords[k] = (char*) malloc(11);
+            rnd_word(keywords[k], 4 + rnd() % 7);
+        }
+
+        keywords[counts[c]] = NULL;
+
+        double bytes = 0;
+        for (int l = 0; l < LINES; l++) bytes += ice_str_len(lines[l]);
+
+        // strstr per keyword
+        int matched = 0;
+        double t = now();
+
+        for (int l = 0; l < LINES; l++) {
+            for (int k = 0; k < counts[c]; k++) {
+                if (strstr(lines[l], keywords[k]) != NULL) {
+                    matched++;
+                    break;
+                }
+            }
+        }
+
+        t = now() - t;
+        printf("%-10d %-10s %12.3f %12.1f %10d\n", counts[c], "strstr", t * 1e3, bytes / t / 1e6, matched);
+
+        // ice_str_matcher (Build time included)
+        matched = 0;
+        t = now();
+
+        ice_str_matcher m = ice_str_matcher_new(keywords);
+
+        for (int l = 0; l < LINES; l++) {
+            if (ice_str_matcher_any(&m, lines[l]) == ICE_STR_TRUE) matched++;
+        }
+
+        t = now() - t;
+        printf("%-10d %-10s %12.3f %12.1f %10d\n", counts[c], "matcher", t * 1e3, bytes / t / 1e6, matched);
+
+        ice_str_matcher_free(&m);
+        ice_str_arr_free(keywords);
+    }
+
+    for (int l = 0; l < LINES; l++) free(lines[l]);
+    free(lines);
+    return 0;
+}
@@ -0,0 +1,157 @@
+// Benchmark of number parsing and formatting (strtod, strtoll and sprintf vs ice_str_parse_* and ice_str_fmt_*) on columns like in CSV files
+// Build: cc -O2 -I../.. ice_str_num_bench.c -o ice_str_num_bench
+#define ICE_STR_IMPL
+#include <stdio.h>
+#include "ice_str.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+#define ROWS 1000000
+#define COLUMNS 4
+
+static unsigned int seed = 12345;
+
+static unsigned int rnd(void) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+// Keeps results alive so compiler doesn't remove benchmarked calls
+static volatile double sink;
+
+int main(int argc, char** argv) {
+    const char* names[COLUMNS] = { "prices", "lat/long", "scientific", "ids" };
+    char* text[COLUMNS];
+    int* offsets[COLUMNS];
+    double* values[COLUMNS];
+
+    // Prices have 2 decimals, Coordinates have 6, Measurements are printed with %.17g so they have all digits
+    for (int c = 0; c < COLUMNS; c++) {
+        char* p = text[c] = (char*) malloc(ROWS * 32);
+        offsets[c] = (int*) malloc((ROWS + 1) * sizeof(int));
+        values[c] = (double*) malloc(ROWS * sizeof(double));
+
+        for (int r = 0; r < ROWS; r++) {
+            offsets[c][r] = (int) (p - text[c]);
+
+            if (c == 0) p += sprintf(p, "%u.%02u", rnd() % 10000, rnd() % 100);
+            else if (c == 1) p += sprintf(p, "%s%u.%06u", (rnd() & 1) ? "-" : "", rnd() % 180, rnd() % 1000000);
+            else if (c == 2) p += sprintf(p, "%.17g", (double) rnd() * (double) rnd() / ((double) (rnd() % 1000) + 1.0) * 1e-9);
+            else p += sprintf(p, "%u%u", rnd(), rnd());
+
+            *p++ = '\0';
+        }
+
+        offsets[c][ROWS] = (int) (p - text[c]);
+    }
+
+    printf("%-12s %-22s %12s %12s\n", "column", "method", "ms", "MB/s");
+
+    for (int c = 0; c < COLUMNS; c++) {
+        double bytes = offsets[c][ROWS] - ROWS;
+        double sum = 0;
+        double t = now();
+
+        for (int r = 0; r < ROWS; r++) sum += strtod(text[c] + offsets[c][r], NULL);
+
+        t = now() - t;
+        sink = sum;
+        printf("%-12s %-22s %12.3f %12.1f\n", names[c], "strtod", t * 1e3, bytes / t / 1e6);
+
+        sum = 0;
+        t = now();
+
+        for (int r = 0; r < ROWS; r++) {
+            double d = 0;
+            ice_str_parse_f64(text[c] + offsets[c][r], offsets[c][r + 1] - offsets[c][r] - 1, &d);
+            values[c][r] = d;
+            sum += d;
+        }
+
+        t = now() - t;
+        sink = sum;
+        printf("%-12s %-22s %12.3f %12.1f\n", names[c], "ice_str_parse_f64", t * 1e3, bytes / t / 1e6);
+
+        if (c == 3) {
+            long long isum = 0;
+            t = now();
+            for (int r = 0; r < ROWS; r++) isum += strtoll(text[c] + offsets[c][r], NULL, 10);
+            t = now() - t;
+            sink = (double) isum;
+            printf("%-12s %-22s %12.3f %12.1f\n", names[c], "strtoll", t * 1e3, bytes / t / 1e6);
+
+            isum = 0;
+            t = now();
+
+            for (int r = 0; r < ROWS; r++) {
+                long long n = 0;
+                ice_str_parse_i64(text[c] + offsets[c][r], offsets[c][r + 1] - offsets[c][r] - 1, &n);
+                isum += n;
+            }
+
+            t = now() - t;
+            sink = (double) isum;
+            printf("%-12s %-22s %12.3f %12.1f\n", names[c], "ice_str_parse_i64", t * 1e3, bytes / t / 1e6);
+        }
+    }
+
+    printf("\n%-12s %-22s %12s %12s\n", "column", "method", "ms", "ns/number");
+
+    for (int c = 0; c < COLUMNS; c++) {
+        char buf[ICE_STR_FMT_NUM_MAX];
+        int len = 0;
+
+        // %.17g always round-trips but usually prints more digits than needed
+        double t = now();
+        for (int r = 0; r < ROWS; r++) len += sprintf(buf, "%.17g", values[c][r]);
+        t = now() - t;
+        sink = len;
+        printf("%-12s %-22s %12.3f %12.2f\n", names[c], "sprintf %.17g", t * 1e3, t * 1e9 / ROWS);
+
+        len = 0;
+        t = now();
+        for (int r = 0; r < ROWS; r++) len += ice_str_fmt_f64(values[c][r], buf);
+        t = now() - t;
+        sink = len;
+        printf("%-12s %-22s %12.3f %12.2f\n", names[c], "ice_str_fmt_f64", t * 1e3, t * 1e9 / ROWS);
+
+        if (c == 3) {
+            len = 0;
+            t = now();
+            for (int r = 0; r < ROWS; r++) len += sprintf(buf, "%lld", (long long) values[c][r]);
+            t = now() - t;
+            sink = len;
+            printf("%-12s %-22s %12.3f %12.2f\n", names[c], "sprintf %lld", t * 1e3, t * 1e9 / ROWS);
+
+            len = 0;
+            t = now();
+            for (int r = 0; r < ROWS; r++) len += ice_str_fmt_i64((long long) values[c][r], buf);
+            t = now() - t;
+            sink = len;
+            printf("%-12s %-22s %12.3f %12.2f\n", names[c], "ice_str_fmt_i64", t * 1e3, t * 1e9 / ROWS);
+        }
+    }
+
+    for (int c = 0; c < COLUMNS; c++) {
+        free(text[c]);
+        free(offsets[c]);
+        free(values[c]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+// Throughput benchmark for ice_str scanning kernels and tokenizer (GB/s per function and SIMD level) on CSV-like text
+// Build: cc -O2 -I../.. ice_str_scan_bench.c -o ice_str_scan_bench
+#define ICE_STR_IMPL
+#include <stdio.h>
+#include "ice_str.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+static const char* level_names[] = { "scalar", "sse2", "avx2", "neon" };
+static const char* func_names[] = { "len", "find_char", "count_char", "count_lines", "split", "splitlines", "tok_next", "tok_batch", "upper_ip", "lower_ip", "find", "strstr", "count", "find_long" };
+
+// Keeps results alive so compiler doesn't remove benchmarked calls
+static volatile int sink;
+
+static int run_func(int func, char* str) {
+    switch (func) {
+        case 0: return ice_str_len(str);
+        case 1: return ice_str_find_char(str, '|');
+        case 2: return ice_str_count_char(str, ',');
+        case 3: return ice_str_count_lines(str);
+        case 4: {
+            char** parts = ice_str_split(str, ',');
+            int res = ice_str_arr_len(parts);
+            ice_str_arr_free(parts);
+            return res;
+        }
+        case 5: {
+            char** lines = ice_str_splitlines(str);
+            int res = ice_str_arr_len(lines);
+            ice_str_arr_free(lines);
+            return res;
+        }
+        case 6: {
+            ice_str_tok tok = ice_str_tok_new(str, ',');
+            ice_str_view view;
+            int res = 0;
+            while (ice_str_tok_next(&tok, &view) == ICE_STR_TRUE) res += view.len;
+            return res;
+        }
+        case 7: {
+            ice_str_tok tok = ice_str_tok_new(str, ',');
+            ice_str_view views[64];
+            int res = 0, count;
+            while ((count = ice_str_tok_next_batch(&tok, views, 64)) > 0) res += count;
+            return res;
+        }
+        case 8: ice_str_upper_in_place(str); return str[0];
+        case 9: ice_str_lower_in_place(str); return str[0];
+        // Substrings never found in payload (Fields have 9 digits), So whole string is scanned
+        case 10: return ice_str_find(str, "1234567890,1");
+        case 11: {
+            // Volatile pointer stops compiler from hoisting strstr out of repeat loop
+            char* volatile p = str;
+            return (strstr(p, "1234567890,1") != NULL);
+        }
+        case 12: return ice_str_count(str, ",1");
+        case 13: return ice_str_find(str, "0123456789,0123456789,0123456789,0123456789,0123456789,0123456789,");
+    }
+    
+    return 0;
+}
+
+int main(void) {
+    int sizes[] = { 4096, 1 << 24 };
+    
+    printf("%-8s %-12s %10s %10s\n", "level", "function", "bytes", "GB/s");
+    
+    for (int s = 0; s < 2; s++) {
+        char* str = (char*) malloc(sizes[s] + 1);
+        unsigned int seed = 12345;
+        
+        // Rows of 8 numeric columns, Like CSV payloads
+        for (int i = 0; i < sizes[s]; i++) {
+            seed = seed * 1103515245 + 12345;
+            str[i] = ((i % 80) == 79) ? '\n' : (((i % 10) == 9) ? ',' : (char) ('0' + (seed >> 16) % 10));
+        }
+        
+        str[sizes[s]] = '\0';
+        
+        // Repeat small strings more so every measurement touches ~256 MB
+        int reps = (1 << 28) / sizes[s];
+        if (reps < 1) reps = 1;
+        
+        for (int l = ICE_STR_SIMD_NONE; l <= ICE_STR_SIMD_NEON; l++) {
+            if (ice_str_simd_set_level((ice_str_simd) l) == ICE_STR_FALSE) continue;
+            
+            for (int f = 0; f < 14; f++) {
+                double best = 1e30;
+                int freps = (f == 4 || f == 5) ? (reps / 16 + 1) : reps;
+                
+                for (int trial = 0; trial < 3; trial++) {
+                    double t = now();
+                    for (int r = 0; r < freps; r++) sink = run_func(f, str);
+                    t = now() - t;
+                    if (t < best) best = t;
+                }
+                
+                printf("%-8s %-12s %10d %10.2f\n", level_names[l], func_names[f], sizes[s], (double) sizes[s] * freps / best / 1e9);
+            }
+        }
+        
+        free(str);
+    }
+    
+    return 0;
+}
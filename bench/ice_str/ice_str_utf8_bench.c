@@ -0,0 +1,100 @@
+// Benchmark of UTF-8 validation, Codepoint counting and codepoint indexing on ASCII, Latin, CJK and emoji text for each SIMD level
+// Build: cc -O2 -I../.. ice_str_utf8_bench.c -o ice_str_utf8_bench
+#define ICE_STR_IMPL
+#include <stdio.h>
+#include "ice_str.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+static double now(void) {
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#  include <time.h>
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+#define SIZE (1 << 22)
+#define REPS 20
+
+// Keeps results alive so compiler doesn't remove benchmarked calls
+static volatile int sink;
+
+static unsigned int seed = 12345;
+
+static unsigned int rnd(void) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+// Text of SIZE bytes where pct percent of chars are codepoints from [lo, lo + span)
+static char* make_text(int pct, int lo, int span) {
+    char* res = (char*) malloc(SIZE + 1);
+    int len = 0;
+    
+    while (len < SIZE - 4) {
+        if ((int) (rnd() % 100) < pct) {
+            len += ice_str_utf8_encode(lo + rnd() % span, res + len);
+        } else {
+            res[len++] = (char) ('a' + rnd() % 26);
+        }
+    }
+    
+    res[len] = '\0';
+    return res;
+}
+
+int main(int argc, char** argv) {
+    char* names[] = { "ascii", "latin", "cjk", "emoji" };
+    char* texts[4];
+    ice_str_simd levels[] = { ICE_STR_SIMD_NONE, ICE_STR_SIMD_SSE2, ICE_STR_SIMD_AVX2, ICE_STR_SIMD_NEON };
+    char* level_names[] = { "scalar", "sse2", "avx2", "neon" };
+    
+    texts[0] = make_text(0, 0, 1);
+    texts[1] = make_text(10, 0xC0, 0x100);
+    texts[2] = make_text(90, 0x4E00, 0x5000);
+    texts[3] = make_text(30, 0x1F600, 0x50);
+    
+    printf("%-8s %-8s %12s %12s %12s\n", "text", "level", "valid GB/s", "len GB/s", "sub us");
+    
+    for (int t = 0; t < 4; t++) {
+        int bytes = ice_str_len(texts[t]);
+        
+        for (int l = 0; l < 4; l++) {
+            if (ice_str_simd_set_level(levels[l]) == ICE_STR_FALSE) continue;
+            
+            double tv = now();
+            for (int r = 0; r < REPS; r++) sink = ice_str_utf8_valid_len(texts[t], bytes);
+            tv = now() - tv;
+            
+            double tl = now();
+            for (int r = 0; r < REPS; r++) sink = ice_str_utf8_len(texts[t]);
+            tl = now() - tl;
+            
+            // Last 10 codepoints, So whole text is walked to find them
+            int count = ice_str_utf8_len(texts[t]);
+            double ts = now();
+            
+            for (int r = 0; r < REPS; r++) {
+                char* sub = ice_str_utf8_sub(texts[t], count - 10, count - 1);
+                sink = sub[0];
+                ice_str_free(sub);
+            }
+            
+            ts = now() - ts;
+            
+            printf("%-8s %-8s %12.2f %12.2f %12.1f\n", names[t], level_names[l],
+                   (double) bytes * REPS / tv / 1e9, (double) bytes * REPS / tl / 1e9, ts * 1e6 / REPS);
+        }
+    }
+    
+    for (int t = 0; t < 4; t++) free(texts[t]);
+    return 0;
+}
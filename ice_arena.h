@@ -0,0 +1,638 @@
+// ice_arena.h
+// Single-Header Cross-Platform C library for arena (bump) allocation!
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arena.h (FULL OVERVIEW)
+///////////////////////////////////////////////////////////////////////////////////////////
+/*
+[1] BRIEF:
+ice_arena is cross-platform single-header C library for arena (bump) allocation!
+
+Allocating from arena is just moving pointer forward, And all allocations of arena get freed at once by resetting it,
+Which fits short-lived temporaries (Ex. results of ice_arr, ice_str and ice_math functions made each frame).
+
+Other ice libraries could allocate from arena by defining ICE_<LIB>_USE_ARENA (Ex. ICE_ARR_USE_ARENA) and including ice_arena.h before them,
+Then their allocations go to arena pushed by ice_arena_push (If any) on calling thread, Else to heap as usual.
+
+[2] USAGE:
+Define ICE_ARENA_IMPL then include ice_arena.h in your C/C++ code!
+
+Ex. Freeing temporaries of each frame at once:
+
+    ice_arena frame = ice_arena_new(0);
+    
+    for (;;) {
+        ice_arena_push(&frame);
+        // ... ice_arr_new, ice_str_sub, etc... (With ICE_ARR_USE_ARENA, ICE_STR_USE_ARENA defined)
+        ice_arena_pop();
+        ice_arena_reset(&frame);
+    }
+*/
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// SUPPORT OR CONTRIBUTE TO ice_arena
+///////////////////////////////////////////////////////////////////////////////////////////
+// You could support or contribute ice_arena by possibly one of following things:
+//
+// 1. Test ice_arena on each platform!
+// 2. Add support to more platforms and backends!
+// 3. Request or add more possible features!
+// 4. Fix bugs/problems in the library!
+// 5. Use it in one of your projects!
+// 6. Star the repo on GitHub -> https://github.com/Rabios/ice_libs
+//
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arena LICENSE
+///////////////////////////////////////////////////////////////////////////////////////////
+/*
+ice_arena is dual-licensed, Choose the one you prefer!
+
+------------------------------------------------------------------------
+LICENSE A - PUBLIC DOMAIN LICENSE
+------------------------------------------------------------------------
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+
+------------------------------------------------------------------------
+LICENSE B - MIT LICENSE
+------------------------------------------------------------------------
+Copyright (c) 2021 - 2022 Rabia Alhaffar
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef ICE_ARENA_H
+#define ICE_ARENA_H
+
+// Disable security warnings for MSVC compiler, We don't want to force using C11!
+#ifdef _MSC_VER
+#  define _CRT_SECURE_NO_DEPRECATE
+#  define _CRT_SECURE_NO_WARNINGS
+#  pragma warning(disable:4996)
+#endif
+
+// Define C interface for Windows libraries! ;)
+#ifndef CINTERFACE
+#  define CINTERFACE
+#endif
+
+// Allow to use calling conventions if desired...
+#if defined(__GNUC__) || defined(__GNUG__)
+#  if defined(ICE_ARENA_CALLCONV_VECTORCALL)
+#    error "vectorcall calling convention is not supported by GNU C/C++ compilers yet!"
+#  elif defined(ICE_ARENA_CALLCONV_FASTCALL)
+#    define ICE_ARENA_CALLCONV __attribute__((fastcall))
+#  elif defined(ICE_ARENA_CALLCONV_STDCALL)
+#    define ICE_ARENA_CALLCONV __attribute__((stdcall))
+#  elif defined(ICE_ARENA_CALLCONV_CDECL)
+#    define ICE_ARENA_CALLCONV __attribute__((cdecl))
+#  else
+#    define ICE_ARENA_CALLCONV
+#  endif
+#elif defined(__clang)
+#  if defined(ICE_ARENA_CALLCONV_VECTORCALL)
+#    define ICE_ARENA_CALLCONV __attribute__((vectorcall))
+#  elif defined(ICE_ARENA_CALLCONV_FASTCALL)
+#    define ICE_ARENA_CALLCONV __attribute__((fastcall))
+#  elif defined(ICE_ARENA_CALLCONV_STDCALL)
+#    define ICE_ARENA_CALLCONV __attribute__((stdcall))
+#  elif defined(ICE_ARENA_CALLCONV_CDECL)
+#    define ICE_ARENA_CALLCONV __attribute__((cdecl))
+#  else
+#    define ICE_ARENA_CALLCONV
+#  endif
+#elif defined(_MSC_VER)
+#  if defined(ICE_ARENA_CALLCONV_VECTORCALL)
+#    define ICE_ARENA_CALLCONV __vectorcall
+#  elif defined(ICE_ARENA_CALLCONV_FASTCALL)
+#    define ICE_ARENA_CALLCONV __fastcall
+#  elif defined(ICE_ARENA_CALLCONV_STDCALL)
+#    define ICE_ARENA_CALLCONV __stdcall
+#  elif defined(ICE_ARENA_CALLCONV_CDECL)
+#    define ICE_ARENA_CALLCONV __cdecl
+#  else
+#    define ICE_ARENA_CALLCONV
+#  endif
+#else
+#  define ICE_ARENA_CALLCONV
+#endif
+
+#if !(defined(ICE_ARENA_PLATFORM_MICROSOFT) || defined(ICE_ARENA_PLATFORM_UNIX) || defined(ICE_ARENA_PLATFORM_BEOS))
+#  define ICE_ARENA_PLATFORM_AUTODETECTED
+#endif
+
+// Platform detection
+#if defined(ICE_ARENA_PLATFORM_AUTODETECTED)
+#  if defined(__WIN) || defined(_WIN32_) || defined(_WIN64_) || defined(WIN32) || defined(__WIN32__) || defined(WIN64) || defined(__WIN64__) || defined(WINDOWS) || defined(_WINDOWS) || defined(__WINDOWS) || defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__) || defined(_MSC_VER) || defined(__WINDOWS__) || defined(_X360) || defined(XBOX360) || defined(__X360) || defined(__X360__) || defined(_XBOXONE) || defined(XBONE) || defined(XBOX) || defined(__XBOX__) || defined(__XBOX) || defined(__xbox__) || defined(__xbox) || defined(_XBOX) || defined(xbox)
+#    define ICE_ARENA_MICROSOFT
+#  endif
+#endif
+
+// Allow to use them as extern functions if desired!
+#if defined(ICE_ARENA_EXTERN)
+#  define ICE_ARENA_EXTERNDEF extern
+#else
+#  define ICE_ARENA_EXTERNDEF
+#endif
+
+// If using ANSI C, Disable inline keyword usage so you can use library with ANSI C if possible!
+#if !defined(__STDC_VERSION__)
+#  define ICE_ARENA_INLINEDEF
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#  define ICE_ARENA_INLINEDEF inline
+#endif
+
+// Allow to build DLL via ICE_ARENA_DLLEXPORT or ICE_ARENA_DLLIMPORT if desired!
+// Else, Just define API as static inlined C code!
+#if defined(ICE_ARENA_MICROSOFT)
+#  if defined(ICE_ARENA_DLLEXPORT)
+#    define ICE_ARENA_API ICE_ARENA_EXTERNDEF __declspec(dllexport) ICE_ARENA_INLINEDEF
+#  elif defined(ICE_ARENA_DLLIMPORT)
+#    define ICE_ARENA_API ICE_ARENA_EXTERNDEF __declspec(dllimport) ICE_ARENA_INLINEDEF
+#  else
+#    define ICE_ARENA_API ICE_ARENA_EXTERNDEF static ICE_ARENA_INLINEDEF
+#  endif
+#else
+#  define ICE_ARENA_API ICE_ARENA_EXTERNDEF static ICE_ARENA_INLINEDEF
+#endif
+
+// Custom memory allocators (Used to allocate arena blocks)
+#ifndef ICE_ARENA_MALLOC
+#  define ICE_ARENA_MALLOC(sz) malloc(sz)
+#endif
+#ifndef ICE_ARENA_REALLOC
+#  define ICE_ARENA_REALLOC(ptr, sz) realloc(ptr, sz)
+#endif
+#ifndef ICE_ARENA_FREE
+#  define ICE_ARENA_FREE(ptr) free(ptr)
+#endif
+
+// Alignment of each allocation (Must be power of 2)
+#ifndef ICE_ARENA_ALIGN
+#  define ICE_ARENA_ALIGN 16
+#endif
+
+// Default size in bytes of blocks that arena allocates when it runs out of memory
+#ifndef ICE_ARENA_BLOCK_SIZE
+#  define ICE_ARENA_BLOCK_SIZE (64 * 1024)
+#endif
+
+// Max count of arenas that could be pushed by ice_arena_push at same time (Per thread)
+#ifndef ICE_ARENA_STACK_MAX
+#  define ICE_ARENA_STACK_MAX 32
+#endif
+
+// Thread-local storage, So each thread has its own arenas stack and ice_arena_thread arena
+// (Define ICE_ARENA_NO_THREAD_LOCAL if compiler doesn't support it, Then only one thread could use them)
+#if defined(ICE_ARENA_NO_THREAD_LOCAL)
+#  define ICE_ARENA_THREAD_LOCAL
+#elif defined(__cplusplus) && __cplusplus >= 201103L
+#  define ICE_ARENA_THREAD_LOCAL thread_local
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#  define ICE_ARENA_THREAD_LOCAL _Thread_local
+#elif defined(_MSC_VER)
+#  define ICE_ARENA_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#  define ICE_ARENA_THREAD_LOCAL __thread
+#else
+#  define ICE_ARENA_THREAD_LOCAL
+#endif
+
+#include <stddef.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arena DEFINITIONS
+///////////////////////////////////////////////////////////////////////////////////////////
+typedef enum ice_arena_bool {
+    ICE_ARENA_TRUE = 0,
+    ICE_ARENA_FALSE = -1,
+} ice_arena_bool;
+
+// Block of memory allocations come from, Allocations start right after this struct
+typedef struct ice_arena_block {
+    struct ice_arena_block* prev;   // Block used before this one got allocated
+    size_t size;                    // Bytes that could be allocated from block
+    size_t used;                    // Bytes allocated from block so far
+} ice_arena_block;
+
+typedef struct ice_arena {
+    ice_arena_block* block;         // Block allocations come from (NULL until first allocation)
+    size_t block_size;              // Size of blocks arena allocates
+    struct ice_arena* fallback;     // Arena to allocate from when this one can't (Ex. fixed buffer is full), Could be NULL
+    ice_arena_bool fixed;           // ICE_ARENA_TRUE if arena uses caller's buffer and never allocates blocks
+    size_t sys_allocs;              // Count of blocks allocated from system so far
+    void* last;                     // Last allocation (It could be grown in place or freed)
+} ice_arena;
+
+// Arena state returned by ice_arena_mark, ice_arena_reset_to frees everything allocated after it
+typedef struct ice_arena_mark_t {
+    ice_arena_block* block;
+    size_t used;
+} ice_arena_mark_t;
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arena FUNCTIONS
+///////////////////////////////////////////////////////////////////////////////////////////
+ICE_ARENA_API  ice_arena         ICE_ARENA_CALLCONV  ice_arena_new(size_t block_size);
+ICE_ARENA_API  ice_arena         ICE_ARENA_CALLCONV  ice_arena_from_buffer(void* buf, size_t size);
+ICE_ARENA_API  void              ICE_ARENA_CALLCONV  ice_arena_free(ice_arena* arena);
+ICE_ARENA_API  void*             ICE_ARENA_CALLCONV  ice_arena_alloc(ice_arena* arena, size_t size);
+ICE_ARENA_API  void*             ICE_ARENA_CALLCONV  ice_arena_calloc(ice_arena* arena, size_t n, size_t size);
+ICE_ARENA_API  void*             ICE_ARENA_CALLCONV  ice_arena_realloc(ice_arena* arena, void* ptr, size_t size);
+ICE_ARENA_API  void              ICE_ARENA_CALLCONV  ice_arena_dealloc(ice_arena* arena, void* ptr);
+ICE_ARENA_API  ice_arena_mark_t  ICE_ARENA_CALLCONV  ice_arena_mark(ice_arena* arena);
+ICE_ARENA_API  void              ICE_ARENA_CALLCONV  ice_arena_reset_to(ice_arena* arena, ice_arena_mark_t mark);
+ICE_ARENA_API  void              ICE_ARENA_CALLCONV  ice_arena_reset(ice_arena* arena);
+ICE_ARENA_API  size_t            ICE_ARENA_CALLCONV  ice_arena_used(ice_arena* arena);
+ICE_ARENA_API  ice_arena_bool    ICE_ARENA_CALLCONV  ice_arena_push(ice_arena* arena);
+ICE_ARENA_API  void              ICE_ARENA_CALLCONV  ice_arena_pop(void);
+ICE_ARENA_API  ice_arena*        ICE_ARENA_CALLCONV  ice_arena_current(void);
+ICE_ARENA_API  ice_arena*        ICE_ARENA_CALLCONV  ice_arena_thread(void);
+ICE_ARENA_API  void              ICE_ARENA_CALLCONV  ice_arena_thread_free(void);
+ICE_ARENA_API  void*             ICE_ARENA_CALLCONV  ice_arena_scope_malloc(size_t size);
+ICE_ARENA_API  void*             ICE_ARENA_CALLCONV  ice_arena_scope_calloc(size_t n, size_t size);
+ICE_ARENA_API  void*             ICE_ARENA_CALLCONV  ice_arena_scope_realloc(void* ptr, size_t size);
+ICE_ARENA_API  void              ICE_ARENA_CALLCONV  ice_arena_scope_free(void* ptr);
+
+#if defined(__cplusplus)
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arena IMPLEMENTATION
+///////////////////////////////////////////////////////////////////////////////////////////
+#if defined(ICE_ARENA_IMPL)
+#include <stdlib.h>
+#include <string.h>
+
+// Each allocation is preceded by header, So size is known when reallocating and ice_arena_scope_* functions
+// know if pointer came from arena or heap
+typedef struct ice_arena_header {
+    size_t size;
+    size_t tag;
+} ice_arena_header;
+
+#define ICE_ARENA_TAG_ARENA ((size_t) 0x41524E41)
+#define ICE_ARENA_TAG_HEAP ((size_t) 0x48454150)
+
+#define ICE_ARENA_ROUND(n) (((n) + (ICE_ARENA_ALIGN - 1)) & ~((size_t) ICE_ARENA_ALIGN - 1))
+#define ICE_ARENA_HEADER_SIZE ICE_ARENA_ROUND(sizeof(ice_arena_header))
+#define ICE_ARENA_BLOCK_HEADER_SIZE ICE_ARENA_ROUND(sizeof(ice_arena_block))
+
+static ICE_ARENA_THREAD_LOCAL ice_arena* ice_arena_stack[ICE_ARENA_STACK_MAX];
+static ICE_ARENA_THREAD_LOCAL int ice_arena_stack_len = 0;
+static ICE_ARENA_THREAD_LOCAL ice_arena ice_arena_thread_state;
+static ICE_ARENA_THREAD_LOCAL int ice_arena_thread_ready = 0;
+
+ICE_ARENA_API ice_arena_header* ICE_ARENA_CALLCONV ice_arena_header_of(void* ptr) {
+    return (ice_arena_header*) ((char*) ptr - ICE_ARENA_HEADER_SIZE);
+}
+
+ICE_ARENA_API char* ICE_ARENA_CALLCONV ice_arena_block_data(ice_arena_block* block) {
+    return (char*) block + ICE_ARENA_BLOCK_HEADER_SIZE;
+}
+
+ICE_ARENA_API ice_arena ICE_ARENA_CALLCONV ice_arena_new(size_t block_size) {
+    ice_arena res;
+    
+    memset(&res, 0, sizeof(res));
+    res.block_size = (block_size > 0) ? block_size : ICE_ARENA_BLOCK_SIZE;
+    res.fixed = ICE_ARENA_FALSE;
+    return res;
+}
+
+ICE_ARENA_API ice_arena ICE_ARENA_CALLCONV ice_arena_from_buffer(void* buf, size_t size) {
+    ice_arena res = ice_arena_new(size);
+    size_t pad = (ICE_ARENA_ALIGN - ((size_t) buf & (ICE_ARENA_ALIGN - 1))) & (ICE_ARENA_ALIGN - 1);
+    
+    res.fixed = ICE_ARENA_TRUE;
+    
+    // Buffer holds its block header too
+    if (buf != NULL && size > pad + ICE_ARENA_BLOCK_HEADER_SIZE) {
+        res.block = (ice_arena_block*) ((char*) buf + pad);
+        res.block->prev = NULL;
+        res.block->size = size - pad - ICE_ARENA_BLOCK_HEADER_SIZE;
+        res.block->used = 0;
+    }
+    
+    return res;
+}
+
+ICE_ARENA_API void ICE_ARENA_CALLCONV ice_arena_free(ice_arena* arena) {
+    if (arena->fixed == ICE_ARENA_FALSE) {
+        while (arena->block != NULL) {
+            ice_arena_block* prev = arena->block->prev;
+            ICE_ARENA_FREE(arena->block);
+            arena->block = prev;
+        }
+    } else if (arena->block != NULL) {
+        arena->block->used = 0;
+    }
+    
+    arena->last = NULL;
+}
+
+// Allocates new block that could fit at least need bytes
+ICE_ARENA_API ice_arena_bool ICE_ARENA_CALLCONV ice_arena_grow(ice_arena* arena, size_t need) {
+    size_t size = (need > arena->block_size) ? need : arena->block_size;
+    ice_arena_block* block;
+    
+    if (arena->fixed == ICE_ARENA_TRUE) {
+        return ICE_ARENA_FALSE;
+    }
+    
+    block = (ice_arena_block*) ICE_ARENA_MALLOC(ICE_ARENA_BLOCK_HEADER_SIZE + size);
+    
+    if (block == NULL) {
+        return ICE_ARENA_FALSE;
+    }
+    
+    block->prev = arena->block;
+    block->size = size;
+    block->used = 0;
+    arena->block = block;
+    arena->sys_allocs++;
+    return ICE_ARENA_TRUE;
+}
+
+ICE_ARENA_API void* ICE_ARENA_CALLCONV ice_arena_alloc(ice_arena* arena, size_t size) {
+    size_t need = ICE_ARENA_HEADER_SIZE + ICE_ARENA_ROUND(size);
+    ice_arena_header* header;
+    
+    if (arena->block == NULL || arena->block->used + need > arena->block->size) {
+        if (ice_arena_grow(arena, need) == ICE_ARENA_FALSE) {
+            return (arena->fallback != NULL) ? ice_arena_alloc(arena->fallback, size) : NULL;
+        }
+    }
+    
+    header = (ice_arena_header*) (ice_arena_block_data(arena->block) + arena->block->used);
+    header->size = size;
+    header->tag = ICE_ARENA_TAG_ARENA;
+    arena->block->used += need;
+    arena->last = (char*) header + ICE_ARENA_HEADER_SIZE;
+    return arena->last;
+}
+
+ICE_ARENA_API void* ICE_ARENA_CALLCONV ice_arena_calloc(ice_arena* arena, size_t n, size_t size) {
+    void* res = ice_arena_alloc(arena, n * size);
+    
+    if (res != NULL) {
+        memset(res, 0, n * size);
+    }
+    
+    return res;
+}
+
+ICE_ARENA_API void* ICE_ARENA_CALLCONV ice_arena_realloc(ice_arena* arena, void* ptr, size_t size) {
+    ice_arena_header* header;
+    void* res;
+    
+    if (ptr == NULL) {
+        return ice_arena_alloc(arena, size);
+    }
+    
+    header = ice_arena_header_of(ptr);
+    
+    // Last allocation could grow or shrink in place
+    if (ptr == arena->last) {
+        size_t old = ICE_ARENA_ROUND(header->size);
+        size_t cur = ICE_ARENA_ROUND(size);
+        
+        if (arena->block->used - old + cur <= arena->block->size) {
+            arena->block->used = arena->block->used - old + cur;
+            header->size = size;
+            return ptr;
+        }
+    }
+    
+    res = ice_arena_alloc(arena, size);
+    
+    if (res != NULL) {
+        memcpy(res, ptr, (header->size < size) ? header->size : size);
+    }
+    
+    return res;
+}
+
+// Only last allocation gets its memory back, Others get freed when arena is reset
+ICE_ARENA_API void ICE_ARENA_CALLCONV ice_arena_dealloc(ice_arena* arena, void* ptr) {
+    if (ptr != NULL && ptr == arena->last) {
+        arena->block->used -= ICE_ARENA_HEADER_SIZE + ICE_ARENA_ROUND(ice_arena_header_of(ptr)->size);
+        arena->last = NULL;
+    }
+}
+
+ICE_ARENA_API ice_arena_mark_t ICE_ARENA_CALLCONV ice_arena_mark(ice_arena* arena) {
+    ice_arena_mark_t res;
+    
+    res.block = arena->block;
+    res.used = (arena->block != NULL) ? arena->block->used : 0;
+    return res;
+}
+
+ICE_ARENA_API void ICE_ARENA_CALLCONV ice_arena_reset_to(ice_arena* arena, ice_arena_mark_t mark) {
+    while (arena->fixed == ICE_ARENA_FALSE && arena->block != NULL && arena->block != mark.block) {
+        ice_arena_block* prev = arena->block->prev;
+        ICE_ARENA_FREE(arena->block);
+        arena->block = prev;
+    }
+    
+    if (arena->block != NULL) {
+        arena->block->used = mark.used;
+    }
+    
+    arena->last = NULL;
+}
+
+// If arena needed more than one block, They get replaced by single block that fits all of them
+// so next round of allocations (Ex. next frame) of same size doesn't allocate at all
+ICE_ARENA_API void ICE_ARENA_CALLCONV ice_arena_reset(ice_arena* arena) {
+    size_t total = 0;
+    
+    if (arena->block != NULL && arena->block->prev != NULL && arena->fixed == ICE_ARENA_FALSE) {
+        for (ice_arena_block* block = arena->block; block != NULL; block = block->prev) {
+            total += block->size;
+        }
+        
+        ice_arena_free(arena);
+        ice_arena_grow(arena, total);
+    }
+    
+    if (arena->block != NULL) {
+        arena->block->used = 0;
+    }
+    
+    arena->last = NULL;
+}
+
+ICE_ARENA_API size_t ICE_ARENA_CALLCONV ice_arena_used(ice_arena* arena) {
+    size_t res = 0;
+    
+    for (ice_arena_block* block = arena->block; block != NULL; block = block->prev) {
+        res += block->used;
+    }
+    
+    return res;
+}
+
+ICE_ARENA_API ice_arena_bool ICE_ARENA_CALLCONV ice_arena_push(ice_arena* arena) {
+    if (ice_arena_stack_len >= ICE_ARENA_STACK_MAX) {
+        return ICE_ARENA_FALSE;
+    }
+    
+    ice_arena_stack[ice_arena_stack_len++] = arena;
+    return ICE_ARENA_TRUE;
+}
+
+ICE_ARENA_API void ICE_ARENA_CALLCONV ice_arena_pop(void) {
+    if (ice_arena_stack_len > 0) {
+        ice_arena_stack_len--;
+    }
+}
+
+ICE_ARENA_API ice_arena* ICE_ARENA_CALLCONV ice_arena_current(void) {
+    return (ice_arena_stack_len > 0) ? ice_arena_stack[ice_arena_stack_len - 1] : NULL;
+}
+
+ICE_ARENA_API ice_arena* ICE_ARENA_CALLCONV ice_arena_thread(void) {
+    if (!ice_arena_thread_ready) {
+        ice_arena_thread_state = ice_arena_new(0);
+        ice_arena_thread_ready = 1;
+    }
+    
+    return &ice_arena_thread_state;
+}
+
+ICE_ARENA_API void ICE_ARENA_CALLCONV ice_arena_thread_free(void) {
+    if (ice_arena_thread_ready) {
+        ice_arena_free(&ice_arena_thread_state);
+        ice_arena_thread_ready = 0;
+    }
+}
+
+// Used by other ice libraries (ICE_<LIB>_USE_ARENA), Allocates from current arena or from heap if there is none
+ICE_ARENA_API void* ICE_ARENA_CALLCONV ice_arena_scope_malloc(size_t size) {
+    ice_arena* arena = ice_arena_current();
+    ice_arena_header* header;
+    void* res;
+    
+    if (arena != NULL && (res = ice_arena_alloc(arena, size)) != NULL) {
+        return res;
+    }
+    
+    header = (ice_arena_header*) ICE_ARENA_MALLOC(ICE_ARENA_HEADER_SIZE + size);
+    
+    if (header == NULL) {
+        return NULL;
+    }
+    
+    header->size = size;
+    header->tag = ICE_ARENA_TAG_HEAP;
+    return (char*) header + ICE_ARENA_HEADER_SIZE;
+}
+
+ICE_ARENA_API void* ICE_ARENA_CALLCONV ice_arena_scope_calloc(size_t n, size_t size) {
+    void* res = ice_arena_scope_malloc(n * size);
+    
+    if (res != NULL) {
+        memset(res, 0, n * size);
+    }
+    
+    return res;
+}
+
+ICE_ARENA_API void* ICE_ARENA_CALLCONV ice_arena_scope_realloc(void* ptr, size_t size) {
+    ice_arena_header* header;
+    ice_arena* arena = ice_arena_current();
+    void* res;
+    
+    if (ptr == NULL) {
+        return ice_arena_scope_malloc(size);
+    }
+    
+    header = ice_arena_header_of(ptr);
+    
+    if (header->tag == ICE_ARENA_TAG_HEAP) {
+        header = (ice_arena_header*) ICE_ARENA_REALLOC(header, ICE_ARENA_HEADER_SIZE + size);
+        
+        if (header == NULL) {
+            return NULL;
+        }
+        
+        header->size = size;
+        return (char*) header + ICE_ARENA_HEADER_SIZE;
+    }
+    
+    if (arena != NULL && (res = ice_arena_realloc(arena, ptr, size)) != NULL) {
+        return res;
+    }
+    
+    // Pointer came from arena that isn't current anymore, So it's copied to heap
+    res = ice_arena_scope_malloc(size);
+    
+    if (res != NULL) {
+        memcpy(res, ptr, (header->size < size) ? header->size : size);
+    }
+    
+    return res;
+}
+
+ICE_ARENA_API void ICE_ARENA_CALLCONV ice_arena_scope_free(void* ptr) {
+    ice_arena* arena = ice_arena_current();
+    
+    if (ptr == NULL) {
+        return;
+    }
+    
+    if (ice_arena_header_of(ptr)->tag == ICE_ARENA_TAG_HEAP) {
+        ICE_ARENA_FREE(ice_arena_header_of(ptr));
+    } else if (arena != NULL) {
+        ice_arena_dealloc(arena, ptr);
+    }
+}
+
+#endif  // ICE_ARENA_IMPL
+#endif  // ICE_ARENA_H
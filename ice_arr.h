@@ -183,6 +183,24 @@ THE SOFTWARE.
 #endif
 
 // Custom memory allocators
+// (Define ICE_ARR_USE_ARENA to allocate from arena pushed by ice_arena_push, ice_arena.h must be included before ice_arr.h with ICE_ARENA_IMPL)
+#if defined(ICE_ARR_USE_ARENA)
+#  if !defined(ICE_ARENA_H)
+#    error "ICE_ARR_USE_ARENA requires ice_arena.h to be included before ice_arr.h"
+#  endif
+#  ifndef ICE_ARR_MALLOC
+#    define ICE_ARR_MALLOC(sz) ice_arena_scope_malloc(sz)
+#  endif
+#  ifndef ICE_ARR_CALLOC
+#    define ICE_ARR_CALLOC(n, sz) ice_arena_scope_calloc(n, sz)
+#  endif
+#  ifndef ICE_ARR_REALLOC
+#    define ICE_ARR_REALLOC(ptr, sz) ice_arena_scope_realloc(ptr, sz)
+#  endif
+#  ifndef ICE_ARR_FREE
+#    define ICE_ARR_FREE(ptr) ice_arena_scope_free(ptr)
+#  endif
+#endif
 #ifndef ICE_ARR_MALLOC
 #  define ICE_ARR_MALLOC(sz) malloc(sz)
 #endif
@@ -196,6 +214,45 @@ THE SOFTWARE.
 #  define ICE_ARR_FREE(ptr) free(ptr)
 #endif
 
+// SIMD kernels used by reductions (Define ICE_ARR_NO_SIMD to only use scalar code, Useful for ANSI C targets)
+// SSE2 and NEON are used when compiler targets them, AVX2 is compiled in and picked at runtime if CPU supports it
+#if !defined(ICE_ARR_NO_SIMD)
+#  if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ICE_ARR_SSE2
+#    if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#      define ICE_ARR_AVX2
+#    endif
+#  elif defined(__aarch64__) || defined(_M_ARM64)
+#    define ICE_ARR_NEON
+#  endif
+#endif
+
+// Capacity multiplier used when array needs to grow (Must be bigger than 1)
+#ifndef ICE_ARR_GROWTH_FACTOR
+#  define ICE_ARR_GROWTH_FACTOR 1.5
+#endif
+
+// Parallel functions give each thread at least this count of elements, Smaller arrays are processed by calling thread only
+#ifndef ICE_ARR_PARALLEL_GRAIN
+#  define ICE_ARR_PARALLEL_GRAIN 16384
+#endif
+
+// Max count of stages pipeline could have
+#ifndef ICE_ARR_PIPE_MAX_STAGES
+#  define ICE_ARR_PIPE_MAX_STAGES 16
+#endif
+
+// Max count of threads parallel functions can use (Including calling thread)
+#ifndef ICE_ARR_MAX_THREADS
+#  define ICE_ARR_MAX_THREADS 256
+#endif
+
+#if defined(ICE_ARR_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#  define ICE_ARR_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#  define ICE_ARR_TARGET_AVX2
+#endif
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -208,15 +265,60 @@ typedef enum ice_arr_bool {
     ICE_ARR_FALSE = -1,
 } ice_arr_bool;
 
+typedef enum ice_arr_simd {
+    ICE_ARR_SIMD_NONE = 0,  // Scalar code
+    ICE_ARR_SIMD_SSE2,      // 2 doubles per instruction
+    ICE_ARR_SIMD_AVX2,      // 4 doubles per instruction
+    ICE_ARR_SIMD_NEON,      // 2 doubles per instruction (AArch64)
+} ice_arr_simd;
+
 typedef void (*ice_arr_iter_func)(double n);
 typedef int (*ice_arr_res_func)(double a, double b);
+typedef void (*ice_arr_ctx_iter_func)(double n, void* ctx);
+typedef double (*ice_arr_map_func)(double n, void* ctx);
+typedef double (*ice_arr_reduce_func)(double acc, double n, void* ctx);
 
 typedef struct ice_arr_array {
-    double* arr;
+    double* arr;    // Points to first element, Allocation starts at (arr - head)
     int len;
-    int real_len;   // Value used for max allocated length (x1.5 array length, Increases by pushing elements)
+    int real_len;   // Allocated length counted from allocation start (x1.5 array length, Grows by ICE_ARR_GROWTH_FACTOR)
+    int head;       // Free elements before first element, Left by ice_arr_shift and used by ice_arr_unshift
 } ice_arr_array;
 
+// Non-owning window into ice_arr_array, Never freed
+typedef struct ice_arr_view {
+    double* arr;
+    int len;
+} ice_arr_view;
+
+typedef ice_arr_bool (*ice_arr_pred_func)(double n, void* ctx);
+
+typedef enum ice_arr_stage_type {
+    ICE_ARR_STAGE_FILTER = 0,   // Keeps elements that predicate returns ICE_ARR_TRUE for
+    ICE_ARR_STAGE_MAP,          // Replaces elements with result of function
+    ICE_ARR_STAGE_TAKE,         // Keeps first count elements, Stops pipeline after them
+    ICE_ARR_STAGE_SKIP,         // Drops first count elements
+    ICE_ARR_STAGE_DEDUPE,       // Keeps first occurrence of each value (Same as ice_arr_unique)
+    ICE_ARR_STAGE_WITHOUT,      // Drops elements equal to val (Same as ice_arr_without)
+} ice_arr_stage_type;
+
+typedef struct ice_arr_stage {
+    ice_arr_stage_type type;
+    ice_arr_pred_func filter;
+    ice_arr_map_func map;
+    void* ctx;
+    double val;
+    int count;
+} ice_arr_stage;
+
+// Lazy pipeline over array, Built by ice_arr_pipe_* stage functions and evaluated by terminal ones in single pass
+typedef struct ice_arr_pipe {
+    ice_arr_array src;
+    ice_arr_stage stages[ICE_ARR_PIPE_MAX_STAGES];
+    int len;
+    ice_arr_bool ok;    // ICE_ARR_FALSE if stage couldn't be added, Terminal functions then do nothing
+} ice_arr_pipe;
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 // ice_arr FUNCTIONS
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -226,7 +328,7 @@ ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_set(ice_arr_array* arr, in
 ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_len(ice_arr_array arr);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_pop(ice_arr_array* arr);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_shift(ice_arr_array* arr);
-ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_push(ice_arr_array* arr, double val);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_push(ice_arr_array* arr, double val);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_rev(ice_arr_array* arr);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_free(ice_arr_array arr);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_fill(ice_arr_array* arr, double val);
@@ -246,7 +348,7 @@ ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_rest(ice_arr_array arr, in
 ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_unique(ice_arr_array arr);
 ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_first_index(ice_arr_array arr, double val);
 ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_last_index(ice_arr_array arr, double val);
-ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_unshift(ice_arr_array arr, double val);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_unshift(ice_arr_array* arr, double val);
 ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_diff(ice_arr_array a1, ice_arr_array a2);
 ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_range(int i);
 ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_min(ice_arr_array arr);
@@ -260,6 +362,171 @@ ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_rotate(ice_arr_array* arr,
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_move(ice_arr_array* a1, int from_index, int elems_count, int to_index, ice_arr_array* a2);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_sort(ice_arr_array* arr);
 ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_sort_ex(ice_arr_array* arr, ice_arr_res_func f);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_sort_desc(ice_arr_array* arr);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_sort_ex_stable(ice_arr_array* arr, ice_arr_res_func f);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_sum_kahan(ice_arr_array arr);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_sum_pairwise(ice_arr_array arr);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_reserve(ice_arr_array* arr, int cap);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_shrink_to_fit(ice_arr_array* arr);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_unique_sorted(ice_arr_array arr);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_diff_sorted(ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_intersect_sorted(ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_union_sorted(ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_simd   ICE_ARR_CALLCONV  ice_arr_simd_level(void);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_simd_set_level(ice_arr_simd level);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_first_into(ice_arr_array* dst, ice_arr_array arr, int elems);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_last_into(ice_arr_array* dst, ice_arr_array arr, int elems);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_concat_into(ice_arr_array* dst, ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_sub_into(ice_arr_array* dst, ice_arr_array arr, int from, int to);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_without_into(ice_arr_array* dst, ice_arr_array arr, double val);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_clone_into(ice_arr_array* dst, ice_arr_array arr, int n);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_rest_into(ice_arr_array* dst, ice_arr_array arr, int index);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_unique_into(ice_arr_array* dst, ice_arr_array arr);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_diff_into(ice_arr_array* dst, ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_range_into(ice_arr_array* dst, int i);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_compact_into(ice_arr_array* dst, ice_arr_array arr);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_tail_into(ice_arr_array* dst, ice_arr_array arr);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_intersect_into(ice_arr_array* dst, ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_union_into(ice_arr_array* dst, ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_unique_sorted_into(ice_arr_array* dst, ice_arr_array arr);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_diff_sorted_into(ice_arr_array* dst, ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_intersect_sorted_into(ice_arr_array* dst, ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_union_sorted_into(ice_arr_array* dst, ice_arr_array a1, ice_arr_array a2);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_view_of(ice_arr_array arr);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_view_sub(ice_arr_array arr, int from, int to);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_view_first(ice_arr_array arr, int elems);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_view_last(ice_arr_array arr, int elems);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_view_tail(ice_arr_array arr);
+ICE_ARR_API  ice_arr_view   ICE_ARR_CALLCONV  ice_arr_view_from(ice_arr_array arr, int index);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_from_view(ice_arr_view view);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_parallel_foreach(ice_arr_array arr, ice_arr_ctx_iter_func f, void* ctx);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_map(ice_arr_array arr, ice_arr_map_func f, void* ctx);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_map_into(ice_arr_array* dst, ice_arr_array arr, ice_arr_map_func f, void* ctx);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_reduce(ice_arr_array arr, ice_arr_reduce_func f, double init, void* ctx);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_parallel_sort(ice_arr_array* arr);
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_threads_count(void);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_threads_set(int count);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_threads_free(void);
+ICE_ARR_API  ice_arr_pipe   ICE_ARR_CALLCONV  ice_arr_pipe_new(ice_arr_array arr);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_pipe_filter(ice_arr_pipe* pipe, ice_arr_pred_func f, void* ctx);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_pipe_map(ice_arr_pipe* pipe, ice_arr_map_func f, void* ctx);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_pipe_take(ice_arr_pipe* pipe, int n);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_pipe_skip(ice_arr_pipe* pipe, int n);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_pipe_dedupe(ice_arr_pipe* pipe);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_pipe_without(ice_arr_pipe* pipe, double val);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_pipe_compact(ice_arr_pipe* pipe);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_pipe_sum(const ice_arr_pipe* pipe);
+ICE_ARR_API  int            ICE_ARR_CALLCONV  ice_arr_pipe_count(const ice_arr_pipe* pipe);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_pipe_min(const ice_arr_pipe* pipe);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_pipe_max(const ice_arr_pipe* pipe);
+ICE_ARR_API  double         ICE_ARR_CALLCONV  ice_arr_pipe_reduce(const ice_arr_pipe* pipe, ice_arr_reduce_func f, double init, void* ctx);
+ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_pipe_foreach(const ice_arr_pipe* pipe, ice_arr_ctx_iter_func f, void* ctx);
+ICE_ARR_API  ice_arr_array  ICE_ARR_CALLCONV  ice_arr_pipe_to_array(const ice_arr_pipe* pipe);
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  ice_arr_pipe_into(ice_arr_array* dst, const ice_arr_pipe* pipe);
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arr TYPED ARRAYS
+///////////////////////////////////////////////////////////////////////////////////////////
+// Same API as ice_arr_array but for other element types, Generated by ICE_ARR_TYPED_DECL and ICE_ARR_TYPED_IMPL.
+// ice_arr_f32 (float), ice_arr_i32 (int), ice_arr_i64 (long long) and ice_arr_u8 (unsigned char) are generated
+// unless ICE_ARR_NO_TYPED is defined, Functions are named same as ice_arr ones (Ex. ice_arr_i32_push, ice_arr_f32_sum).
+// name##_sum returns ACC (Wider type than T) so summing won't overflow or lose precision so fast.
+#define ICE_ARR_TYPED_DECL(name, T, ACC)                                                            \
+typedef struct name {                                                                               \
+    T* arr;                                                                                         \
+    int len;                                                                                        \
+    int real_len;                                                                                   \
+    int head;                                                                                       \
+} name;                                                                                             \
+                                                                                                    \
+typedef struct name##_view {                                                                        \
+    T* arr;                                                                                         \
+    int len;                                                                                        \
+} name##_view;                                                                                      \
+                                                                                                    \
+typedef void (*name##_iter_func)(T n);                                                              \
+typedef int (*name##_res_func)(T a, T b);                                                           \
+                                                                                                    \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_new(int len);                                  \
+ICE_ARR_API  T              ICE_ARR_CALLCONV  name##_get(name arr, int index);                      \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_set(name* arr, int index, T val);              \
+ICE_ARR_API  int            ICE_ARR_CALLCONV  name##_len(name arr);                                 \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_pop(name* arr);                                \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_shift(name* arr);                              \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_push(name* arr, T val);                        \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_rev(name* arr);                                \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_free(name arr);                                \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_fill(name* arr, T val);                        \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_clear(name* arr);                              \
+ICE_ARR_API  ACC            ICE_ARR_CALLCONV  name##_sum(name arr);                                 \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_first(name arr, int elems);                    \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_last(name arr, int elems);                     \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_concat(name a1, name a2);                      \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_match(name a1, name a2);                       \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_sub(name arr, int from, int to);               \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_includes(name arr, T val);                     \
+ICE_ARR_API  int            ICE_ARR_CALLCONV  name##_matches(name arr, T val);                      \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_rem(name* arr, int index);                     \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_without(name arr, T val);                      \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_clone(name arr, int n);                        \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_rest(name arr, int index);                     \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_unique(name arr);                              \
+ICE_ARR_API  int            ICE_ARR_CALLCONV  name##_first_index(name arr, T val);                  \
+ICE_ARR_API  int            ICE_ARR_CALLCONV  name##_last_index(name arr, T val);                   \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_unshift(name* arr, T val);                     \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_diff(name a1, name a2);                        \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_range(int i);                                  \
+ICE_ARR_API  T              ICE_ARR_CALLCONV  name##_min(name arr);                                 \
+ICE_ARR_API  T              ICE_ARR_CALLCONV  name##_max(name arr);                                 \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_compact(name arr);                             \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_tail(name arr);                                \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_intersect(name a1, name a2);                   \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_foreach(name arr, name##_iter_func f);         \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_union(name a1, name a2);                       \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_rotate(name* arr, int times);                  \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_move(name* a1, int from_index, int elems_count, int to_index, name* a2); \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_sort(name* arr);                               \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_sort_ex(name* arr, name##_res_func f);         \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_sort_desc(name* arr);                          \
+ICE_ARR_API  void           ICE_ARR_CALLCONV  name##_sort_ex_stable(name* arr, name##_res_func f);  \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_reserve(name* arr, int cap);                   \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_shrink_to_fit(name* arr);                      \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_unique_sorted(name arr);                       \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_diff_sorted(name a1, name a2);                 \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_intersect_sorted(name a1, name a2);            \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_union_sorted(name a1, name a2);                \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_first_into(name* dst, name arr, int elems);    \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_last_into(name* dst, name arr, int elems);     \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_concat_into(name* dst, name a1, name a2);      \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_sub_into(name* dst, name arr, int from, int to); \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_without_into(name* dst, name arr, T val);      \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_clone_into(name* dst, name arr, int n);        \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_rest_into(name* dst, name arr, int index);     \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_unique_into(name* dst, name arr);              \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_diff_into(name* dst, name a1, name a2);        \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_range_into(name* dst, int i);                  \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_compact_into(name* dst, name arr);             \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_tail_into(name* dst, name arr);                \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_intersect_into(name* dst, name a1, name a2);   \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_union_into(name* dst, name a1, name a2);       \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_unique_sorted_into(name* dst, name arr);       \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_diff_sorted_into(name* dst, name a1, name a2); \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_intersect_sorted_into(name* dst, name a1, name a2); \
+ICE_ARR_API  ice_arr_bool   ICE_ARR_CALLCONV  name##_union_sorted_into(name* dst, name a1, name a2); \
+ICE_ARR_API  name##_view    ICE_ARR_CALLCONV  name##_view_of(name arr);                             \
+ICE_ARR_API  name##_view    ICE_ARR_CALLCONV  name##_view_sub(name arr, int from, int to);          \
+ICE_ARR_API  name##_view    ICE_ARR_CALLCONV  name##_view_first(name arr, int elems);               \
+ICE_ARR_API  name##_view    ICE_ARR_CALLCONV  name##_view_last(name arr, int elems);                \
+ICE_ARR_API  name##_view    ICE_ARR_CALLCONV  name##_view_tail(name arr);                           \
+ICE_ARR_API  name##_view    ICE_ARR_CALLCONV  name##_view_from(name arr, int index);                \
+ICE_ARR_API  name           ICE_ARR_CALLCONV  name##_from_view(name##_view view);
+
+#if !defined(ICE_ARR_NO_TYPED)
+ICE_ARR_TYPED_DECL(ice_arr_f32, float, double)
+ICE_ARR_TYPED_DECL(ice_arr_i32, int, long long)
+ICE_ARR_TYPED_DECL(ice_arr_i64, long long, long long)
+ICE_ARR_TYPED_DECL(ice_arr_u8, unsigned char, unsigned long long)
+#endif
 
 #if defined(__cplusplus)
 }
@@ -269,504 +536,2602 @@ ICE_ARR_API  void           ICE_ARR_CALLCONV  ice_arr_sort_ex(ice_arr_array* arr
 // ice_arr IMPLEMENTATION
 ///////////////////////////////////////////////////////////////////////////////////////////
 #if defined(ICE_ARR_IMPL)
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stddef.h>
+#include <limits.h>
+#include <stdint.h>
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_new(int len) {
-    ice_arr_array res = (ice_arr_array) {
-        (double*) ICE_ARR_MALLOC((len + (len / 2)) * sizeof(double)),
-        len,
-        len + (len / 2),
-    };
+#if defined(ICE_ARR_MICROSOFT)
+#  include <windows.h>
+#else
+#  include <unistd.h>
+#  if !defined(ICE_ARR_NO_THREADS)
+#    include <pthread.h>
+#  endif
+#endif
+
+#if defined(ICE_ARR_SSE2) || defined(ICE_ARR_AVX2)
+#  include <emmintrin.h>
+#  if defined(ICE_ARR_AVX2)
+#    include <immintrin.h>
+#    if defined(_MSC_VER)
+#      include <intrin.h>
+#    endif
+#  endif
+#elif defined(ICE_ARR_NEON)
+#  include <arm_neon.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arr KERNELS
+///////////////////////////////////////////////////////////////////////////////////////////
+// Reductions used by ice_arr_sum, ice_arr_min, ice_arr_max, ice_arr_matches, etc...
+// Every kernel exists as scalar code, And SIMD versions replace them if available.
+// NOTE: Vectorized sums reassociate additions, Use ice_arr_sum_kahan or ice_arr_sum_pairwise if accuracy matters!
+typedef struct ice_arr_kernels {
+    double (*sum)(const double* a, int n);
+    double (*sum_kahan)(const double* a, int n);
+    double (*min)(const double* a, int n);
+    double (*max)(const double* a, int n);
+    int    (*matches)(const double* a, int n, double val);
+    int    (*find)(const double* a, int n, double val);
+} ice_arr_kernels;
+
+// Number of elements summed directly by ice_arr_sum_pairwise before splitting
+#define ICE_ARR_PAIRWISE_BLOCK 256
+
+// Neumaier variant of Kahan summation step, Also correct when added value is bigger than running sum
+#define ICE_ARR_KAHAN_STEP(s, c, x) do { \
+    double ice_arr_t = (s) + (x); \
+    if (fabs(s) >= fabs(x)) (c) += ((s) - ice_arr_t) + (x); \
+    else (c) += ((x) - ice_arr_t) + (s); \
+    (s) = ice_arr_t; \
+} while (0)
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_scalar_sum(const double* a, int n) {
+    double res = 0;
     
-    for (int i = 0; i < res.len; i++) {
-        res.arr[i] = 0;
+    for (int i = 0; i < n; i++) {
+        res += a[i];
     }
     
     return res;
 }
 
-ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_get(ice_arr_array arr, int index) {
-    if (index < arr.len) {
-        return arr.arr[index];
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_scalar_sum_kahan(const double* a, int n) {
+    double s = 0, c = 0;
+    
+    for (int i = 0; i < n; i++) {
+        ICE_ARR_KAHAN_STEP(s, c, a[i]);
     }
     
-    return 0;
+    return s + c;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_set(ice_arr_array* arr, int index, double val) {
-    if (index < arr->len) {
-        arr->arr[index] = val;
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_scalar_min(const double* a, int n) {
+    double res = HUGE_VAL;
+    
+    for (int i = 0; i < n; i++) {
+        if (a[i] < res) res = a[i];
     }
+    
+    return res;
 }
 
-ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_len(ice_arr_array arr) {
-    return arr.len;
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_scalar_max(const double* a, int n) {
+    double res = -HUGE_VAL;
+    
+    for (int i = 0; i < n; i++) {
+        if (a[i] > res) res = a[i];
+    }
+    
+    return res;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_pop(ice_arr_array* arr) {
-    arr->len--;
-    //arr->arr[arr->len - 1] = 0;
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_scalar_matches(const double* a, int n, double val) {
+    int res = 0;
+    
+    for (int i = 0; i < n; i++) {
+        if (a[i] == val) res++;
+    }
+    
+    return res;
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_scalar_find(const double* a, int n, double val) {
+    for (int i = 0; i < n; i++) {
+        if (a[i] == val) return i;
+    }
+    
+    return -1;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_shift(ice_arr_array* arr) {
-    arr->len--;
+#if defined(ICE_ARR_SSE2)
+// Sums lanes of 2 Kahan accumulators (s and c) into scalar result
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_kahan_lanes(const double* s, const double* c, int lanes, const double* a, int n) {
+    double rs = 0, rc = 0;
     
-    for (int i = 1; i < arr->len + 1; i++) {
-        arr->arr[i - 1] = arr->arr[i];
+    for (int i = 0; i < lanes; i++) {
+        ICE_ARR_KAHAN_STEP(rs, rc, s[i]);
+        rc += c[i];
     }
+    
+    for (int i = 0; i < n; i++) {
+        ICE_ARR_KAHAN_STEP(rs, rc, a[i]);
+    }
+    
+    return rs + rc;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_push(ice_arr_array* arr, double val) {
-    if (arr->len++ < arr->real_len) {
-        arr->arr[arr->len - 1] = val;
-    } else {
-        ICE_ARR_REALLOC(arr->arr, (arr->real_len + (arr->real_len / 2)) * sizeof(double));
-        arr->arr[arr->len - 1] = val;
-        arr->real_len += (arr->real_len / 2);
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_sse2_sum(const double* a, int n) {
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    double lanes[2];
+    int i = 0;
+    
+    for (; i + 4 <= n; i += 4) {
+        s0 = _mm_add_pd(s0, _mm_loadu_pd(a + i));
+        s1 = _mm_add_pd(s1, _mm_loadu_pd(a + i + 2));
     }
+    
+    _mm_storeu_pd(lanes, _mm_add_pd(s0, s1));
+    return lanes[0] + lanes[1] + ice_arr_scalar_sum(a + i, n - i);
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_swap(double *a, double *b) {
-    double tmp = *a;
-    *a = *b;
-    *b = tmp;
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_sse2_sum_kahan(const double* a, int n) {
+    __m128d sign = _mm_set1_pd(-0.0);
+    __m128d s = _mm_setzero_pd(), c = _mm_setzero_pd();
+    double ls[2], lc[2];
+    int i = 0;
+    
+    for (; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(a + i);
+        __m128d t = _mm_add_pd(s, x);
+        __m128d big = _mm_cmpge_pd(_mm_andnot_pd(sign, s), _mm_andnot_pd(sign, x));
+        __m128d cs = _mm_add_pd(_mm_sub_pd(s, t), x);
+        __m128d cx = _mm_add_pd(_mm_sub_pd(x, t), s);
+        c = _mm_add_pd(c, _mm_or_pd(_mm_and_pd(big, cs), _mm_andnot_pd(big, cx)));
+        s = t;
+    }
+    
+    _mm_storeu_pd(ls, s);
+    _mm_storeu_pd(lc, c);
+    return ice_arr_kahan_lanes(ls, lc, 2, a + i, n - i);
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_rev(ice_arr_array* arr) {
-    for (int i = 0; i < arr->len / 2; i++) {
-        ice_arr_swap(arr->arr + i, arr->arr + arr->len - 1 - i);
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_sse2_min(const double* a, int n) {
+    __m128d m0 = _mm_set1_pd(HUGE_VAL), m1 = m0;
+    double lanes[2];
+    int i = 0;
+    
+    // NOTE: minpd returns second operand if one of them is NaN, So NaNs get ignored same as scalar code
+    for (; i + 4 <= n; i += 4) {
+        m0 = _mm_min_pd(_mm_loadu_pd(a + i), m0);
+        m1 = _mm_min_pd(_mm_loadu_pd(a + i + 2), m1);
     }
+    
+    _mm_storeu_pd(lanes, _mm_min_pd(m0, m1));
+    double res = ice_arr_scalar_min(a + i, n - i);
+    if (lanes[0] < res) res = lanes[0];
+    if (lanes[1] < res) res = lanes[1];
+    return res;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_free(ice_arr_array arr) {
-    ICE_ARR_FREE(arr.arr);
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_sse2_max(const double* a, int n) {
+    __m128d m0 = _mm_set1_pd(-HUGE_VAL), m1 = m0;
+    double lanes[2];
+    int i = 0;
+    
+    for (; i + 4 <= n; i += 4) {
+        m0 = _mm_max_pd(_mm_loadu_pd(a + i), m0);
+        m1 = _mm_max_pd(_mm_loadu_pd(a + i + 2), m1);
+    }
+    
+    _mm_storeu_pd(lanes, _mm_max_pd(m0, m1));
+    double res = ice_arr_scalar_max(a + i, n - i);
+    if (lanes[0] > res) res = lanes[0];
+    if (lanes[1] > res) res = lanes[1];
+    return res;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_fill(ice_arr_array* arr, double val) {
-    for (int i = 0; i < arr->len; i++) {
-        arr->arr[i] = val;
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_sse2_matches(const double* a, int n, double val) {
+    __m128d v = _mm_set1_pd(val);
+    __m128i c0 = _mm_setzero_si128(), c1 = _mm_setzero_si128();
+    long long lanes[2];
+    int i = 0;
+    
+    // Equal lanes are all bits set (-1), So subtracting masks counts matches
+    for (; i + 4 <= n; i += 4) {
+        c0 = _mm_sub_epi64(c0, _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(a + i), v)));
+        c1 = _mm_sub_epi64(c1, _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(a + i + 2), v)));
     }
+    
+    _mm_storeu_si128((__m128i*) lanes, _mm_add_epi64(c0, c1));
+    return (int) (lanes[0] + lanes[1]) + ice_arr_scalar_matches(a + i, n - i, val);
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_clear(ice_arr_array* arr) {
-    for (int i = 0; i < arr->len; i++) {
-        arr->arr[i] = 0;
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_sse2_find(const double* a, int n, double val) {
+    __m128d v = _mm_set1_pd(val);
+    int i = 0;
+    
+    for (; i + 4 <= n; i += 4) {
+        int m0 = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(a + i), v));
+        int m1 = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(a + i + 2), v));
+        int m = m0 | (m1 << 2);
+        
+        if (m != 0) {
+            while (!(m & 1)) { m >>= 1; i++; }
+            return i;
+        }
     }
+    
+    int res = ice_arr_scalar_find(a + i, n - i, val);
+    return (res < 0) ? -1 : i + res;
 }
+#endif
 
-ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_sum(ice_arr_array arr) {
-    double res = 0;
+#if defined(ICE_ARR_AVX2)
+ICE_ARR_API ICE_ARR_TARGET_AVX2 double ICE_ARR_CALLCONV ice_arr_avx2_sum(const double* a, int n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    double lanes[4];
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        res += arr.arr[i];
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm256_add_pd(s0, _mm256_loadu_pd(a + i));
+        s1 = _mm256_add_pd(s1, _mm256_loadu_pd(a + i + 4));
     }
     
-    return res;
+    _mm256_storeu_pd(lanes, _mm256_add_pd(s0, s1));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + ice_arr_scalar_sum(a + i, n - i);
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_first(ice_arr_array arr, int elems) {
-    ice_arr_array res = ice_arr_new((elems <= 1) ? 1 : elems);
+ICE_ARR_API ICE_ARR_TARGET_AVX2 double ICE_ARR_CALLCONV ice_arr_avx2_sum_kahan(const double* a, int n) {
+    __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d s = _mm256_setzero_pd(), c = _mm256_setzero_pd();
+    double ls[4], lc[4];
+    int i = 0;
+    
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(a + i);
+        __m256d t = _mm256_add_pd(s, x);
+        __m256d big = _mm256_cmp_pd(_mm256_andnot_pd(sign, s), _mm256_andnot_pd(sign, x), _CMP_GE_OQ);
+        __m256d cs = _mm256_add_pd(_mm256_sub_pd(s, t), x);
+        __m256d cx = _mm256_add_pd(_mm256_sub_pd(x, t), s);
+        c = _mm256_add_pd(c, _mm256_blendv_pd(cx, cs, big));
+        s = t;
+    }
     
-    for (int i = 0; i < res.len; i++) {
-        res.arr[i] = arr.arr[i];
+    _mm256_storeu_pd(ls, s);
+    _mm256_storeu_pd(lc, c);
+    return ice_arr_kahan_lanes(ls, lc, 4, a + i, n - i);
+}
+
+ICE_ARR_API ICE_ARR_TARGET_AVX2 double ICE_ARR_CALLCONV ice_arr_avx2_min(const double* a, int n) {
+    __m256d m0 = _mm256_set1_pd(HUGE_VAL), m1 = m0;
+    double lanes[4];
+    int i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        m0 = _mm256_min_pd(_mm256_loadu_pd(a + i), m0);
+        m1 = _mm256_min_pd(_mm256_loadu_pd(a + i + 4), m1);
+    }
+    
+    _mm256_storeu_pd(lanes, _mm256_min_pd(m0, m1));
+    double res = ice_arr_scalar_min(a + i, n - i);
+    
+    for (int j = 0; j < 4; j++) {
+        if (lanes[j] < res) res = lanes[j];
     }
     
     return res;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_last(ice_arr_array arr, int elems) {
-    ice_arr_array res = ice_arr_new((elems <= 1) ? 1 : elems);
+ICE_ARR_API ICE_ARR_TARGET_AVX2 double ICE_ARR_CALLCONV ice_arr_avx2_max(const double* a, int n) {
+    __m256d m0 = _mm256_set1_pd(-HUGE_VAL), m1 = m0;
+    double lanes[4];
+    int i = 0;
     
-    for (int i = 0; i < res.len; i++) {
-        res.arr[i] = arr.arr[(arr.len - 1) - i];
+    for (; i + 8 <= n; i += 8) {
+        m0 = _mm256_max_pd(_mm256_loadu_pd(a + i), m0);
+        m1 = _mm256_max_pd(_mm256_loadu_pd(a + i + 4), m1);
+    }
+    
+    _mm256_storeu_pd(lanes, _mm256_max_pd(m0, m1));
+    double res = ice_arr_scalar_max(a + i, n - i);
+    
+    for (int j = 0; j < 4; j++) {
+        if (lanes[j] > res) res = lanes[j];
     }
     
     return res;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_concat(ice_arr_array a1, ice_arr_array a2) {
-    int idx = 0;
+ICE_ARR_API ICE_ARR_TARGET_AVX2 int ICE_ARR_CALLCONV ice_arr_avx2_matches(const double* a, int n, double val) {
+    __m256d v = _mm256_set1_pd(val);
+    __m256i c0 = _mm256_setzero_si256(), c1 = _mm256_setzero_si256();
+    long long lanes[4];
+    int i = 0;
     
-    ice_arr_array res = ice_arr_new(a1.len + a2.len);
+    for (; i + 8 <= n; i += 8) {
+        c0 = _mm256_sub_epi64(c0, _mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd(a + i), v, _CMP_EQ_OQ)));
+        c1 = _mm256_sub_epi64(c1, _mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd(a + i + 4), v, _CMP_EQ_OQ)));
+    }
     
-    for (int i = 0; i < a1.len; i++) {
-        res.arr[idx + i] = a1.arr[i];
+    _mm256_storeu_si256((__m256i*) lanes, _mm256_add_epi64(c0, c1));
+    return (int) (lanes[0] + lanes[1] + lanes[2] + lanes[3]) + ice_arr_scalar_matches(a + i, n - i, val);
+}
+
+ICE_ARR_API ICE_ARR_TARGET_AVX2 int ICE_ARR_CALLCONV ice_arr_avx2_find(const double* a, int n, double val) {
+    __m256d v = _mm256_set1_pd(val);
+    int i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        int m0 = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a + i), v, _CMP_EQ_OQ));
+        int m1 = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a + i + 4), v, _CMP_EQ_OQ));
+        int m = m0 | (m1 << 4);
+        
+        if (m != 0) {
+            while (!(m & 1)) { m >>= 1; i++; }
+            return i;
+        }
     }
     
-    idx += a1.len;
+    int res = ice_arr_scalar_find(a + i, n - i, val);
+    return (res < 0) ? -1 : i + res;
+}
+
+// Checks if CPU and OS both support AVX2 (OS must save YMM registers)
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_cpu_has_avx2(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return ICE_ARR_FALSE;
+    
+    __cpuid(info, 1);
+    if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 28))) return ICE_ARR_FALSE;
+    if ((_xgetbv(0) & 6) != 6) return ICE_ARR_FALSE;
     
-    for (int i = 0; i < a2.len; i++) {
-        res.arr[idx + i] = a2.arr[i];
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) ? ICE_ARR_TRUE : ICE_ARR_FALSE;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? ICE_ARR_TRUE : ICE_ARR_FALSE;
+#endif
+}
+#endif
+
+#if defined(ICE_ARR_NEON)
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_neon_sum(const double* a, int n) {
+    float64x2_t s0 = vdupq_n_f64(0), s1 = vdupq_n_f64(0);
+    int i = 0;
+    
+    for (; i + 4 <= n; i += 4) {
+        s0 = vaddq_f64(s0, vld1q_f64(a + i));
+        s1 = vaddq_f64(s1, vld1q_f64(a + i + 2));
     }
     
-    return res;
+    return vaddvq_f64(vaddq_f64(s0, s1)) + ice_arr_scalar_sum(a + i, n - i);
 }
 
-ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_match(ice_arr_array a1, ice_arr_array a2) {
-    int matches = 0;
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_neon_sum_kahan(const double* a, int n) {
+    float64x2_t s = vdupq_n_f64(0), c = vdupq_n_f64(0);
+    double ls[2], lc[2];
+    int i = 0;
+    
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t x = vld1q_f64(a + i);
+        float64x2_t t = vaddq_f64(s, x);
+        uint64x2_t big = vcgeq_f64(vabsq_f64(s), vabsq_f64(x));
+        float64x2_t cs = vaddq_f64(vsubq_f64(s, t), x);
+        float64x2_t cx = vaddq_f64(vsubq_f64(x, t), s);
+        c = vaddq_f64(c, vbslq_f64(big, cs, cx));
+        s = t;
+    }
     
-    if (a1.len != a2.len) {
-        return ICE_ARR_FALSE;
+    vst1q_f64(ls, s);
+    vst1q_f64(lc, c);
+    
+    double rs = 0, rc = 0;
+    
+    for (int j = 0; j < 2; j++) {
+        ICE_ARR_KAHAN_STEP(rs, rc, ls[j]);
+        rc += lc[j];
     }
-        
-    for (int i = 0; i < a1.len; i++) {
-        if (a1.arr[i] == a2.arr[i]) matches++;
+    
+    for (; i < n; i++) {
+        ICE_ARR_KAHAN_STEP(rs, rc, a[i]);
     }
     
-    return (matches == a1.len) ? ICE_ARR_TRUE : ICE_ARR_FALSE;
+    return rs + rc;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_sub(ice_arr_array arr, int from, int to) {
-    ice_arr_array res = ice_arr_new((from - to) + 1);
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_neon_min(const double* a, int n) {
+    float64x2_t m = vdupq_n_f64(HUGE_VAL);
+    int i = 0;
     
-    int count = 0;
-    for (int i = from; i <= to; i++) {
-        res.arr[count] = arr.arr[i];
-        count++;
+    // NOTE: fminnm returns the number if other operand is NaN, So NaNs get ignored same as scalar code
+    for (; i + 2 <= n; i += 2) {
+        m = vminnmq_f64(m, vld1q_f64(a + i));
     }
     
-    return res;
+    double res = vminnmvq_f64(m);
+    double rest = ice_arr_scalar_min(a + i, n - i);
+    return (rest < res) ? rest : res;
 }
 
-ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_includes(ice_arr_array arr, double val) {
-    ice_arr_bool res = ICE_ARR_FALSE;
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_neon_max(const double* a, int n) {
+    float64x2_t m = vdupq_n_f64(-HUGE_VAL);
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] == val) {
-            res = ICE_ARR_TRUE;
-            break;
-        }
+    for (; i + 2 <= n; i += 2) {
+        m = vmaxnmq_f64(m, vld1q_f64(a + i));
     }
     
-    return res;
+    double res = vmaxnmvq_f64(m);
+    double rest = ice_arr_scalar_max(a + i, n - i);
+    return (rest > res) ? rest : res;
 }
 
-ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_matches(ice_arr_array arr, double val) {
-    int matches = 0;
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_neon_matches(const double* a, int n, double val) {
+    float64x2_t v = vdupq_n_f64(val);
+    uint64x2_t c = vdupq_n_u64(0);
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] == val) matches++;
+    for (; i + 2 <= n; i += 2) {
+        c = vsubq_u64(c, vceqq_f64(vld1q_f64(a + i), v));
     }
     
-    return matches;
+    return (int) vaddvq_u64(c) + ice_arr_scalar_matches(a + i, n - i, val);
 }
 
-ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_first_index(ice_arr_array arr, double val) {
-    int occurence = 0;
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_neon_find(const double* a, int n, double val) {
+    float64x2_t v = vdupq_n_f64(val);
+    int i = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] == val) {
-            occurence = i;
-            break;
+    for (; i + 2 <= n; i += 2) {
+        uint64x2_t m = vceqq_f64(vld1q_f64(a + i), v);
+        
+        if (vmaxvq_u32(vreinterpretq_u32_u64(m)) != 0) {
+            return (vgetq_lane_u64(m, 0) != 0) ? i : i + 1;
         }
     }
     
-    return occurence;
+    int res = ice_arr_scalar_find(a + i, n - i, val);
+    return (res < 0) ? -1 : i + res;
 }
+#endif
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_rem(ice_arr_array* arr, int index) {
-    if (index < arr->len) {
-        arr->len--;
+static ice_arr_kernels ice_arr_kernels_table;
+static int ice_arr_kernels_level = -1;
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_simd_set_level(ice_arr_simd level) {
+    ice_arr_kernels k = {
+        ice_arr_scalar_sum, ice_arr_scalar_sum_kahan, ice_arr_scalar_min,
+        ice_arr_scalar_max, ice_arr_scalar_matches, ice_arr_scalar_find,
+    };
     
-        for (int i = index; i < arr->len + 1; i++) {
-            arr->arr[i] = arr->arr[i + 1];
+    switch (level) {
+        case ICE_ARR_SIMD_NONE:
+            break;
+#if defined(ICE_ARR_SSE2)
+        case ICE_ARR_SIMD_SSE2: {
+            ice_arr_kernels sse2 = {
+                ice_arr_sse2_sum, ice_arr_sse2_sum_kahan, ice_arr_sse2_min,
+                ice_arr_sse2_max, ice_arr_sse2_matches, ice_arr_sse2_find,
+            };
+            k = sse2;
+            break;
         }
+#endif
+#if defined(ICE_ARR_AVX2)
+        case ICE_ARR_SIMD_AVX2: {
+            if (ice_arr_cpu_has_avx2() == ICE_ARR_FALSE) return ICE_ARR_FALSE;
+            
+            ice_arr_kernels avx2 = {
+                ice_arr_avx2_sum, ice_arr_avx2_sum_kahan, ice_arr_avx2_min,
+                ice_arr_avx2_max, ice_arr_avx2_matches, ice_arr_avx2_find,
+            };
+            k = avx2;
+            break;
+        }
+#endif
+#if defined(ICE_ARR_NEON)
+        case ICE_ARR_SIMD_NEON: {
+            ice_arr_kernels neon = {
+                ice_arr_neon_sum, ice_arr_neon_sum_kahan, ice_arr_neon_min,
+                ice_arr_neon_max, ice_arr_neon_matches, ice_arr_neon_find,
+            };
+            k = neon;
+            break;
+        }
+#endif
+        default:
+            return ICE_ARR_FALSE;
     }
+    
+    ice_arr_kernels_table = k;
+    ice_arr_kernels_level = (int) level;
+    return ICE_ARR_TRUE;
+}
+
+// Picks best kernels supported by CPU, Unless ice_arr_simd_set_level was called before
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_kernels_init(void) {
+    if (ice_arr_kernels_level < 0) {
+        if (ice_arr_simd_set_level(ICE_ARR_SIMD_AVX2) == ICE_ARR_FALSE &&
+            ice_arr_simd_set_level(ICE_ARR_SIMD_SSE2) == ICE_ARR_FALSE &&
+            ice_arr_simd_set_level(ICE_ARR_SIMD_NEON) == ICE_ARR_FALSE) {
+            ice_arr_simd_set_level(ICE_ARR_SIMD_NONE);
+        }
+    }
+}
+
+// Kernels get picked at first call, Which may happen on many worker threads at once (Ex. ice_arr_reduce calling ice_arr_sum),
+// So picking runs once per process and other callers wait for it to finish before reading table.
+#if defined(ICE_ARR_NO_THREADS)
+ICE_ARR_API ice_arr_kernels* ICE_ARR_CALLCONV ice_arr_get_kernels(void) {
+    ice_arr_kernels_init();
+    return &ice_arr_kernels_table;
+}
+#elif defined(ICE_ARR_MICROSOFT)
+static INIT_ONCE ice_arr_kernels_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK ice_arr_kernels_init_once(PINIT_ONCE once, PVOID param, PVOID* ctx) {
+    (void) once;
+    (void) param;
+    (void) ctx;
+    ice_arr_kernels_init();
+    return TRUE;
+}
+
+ICE_ARR_API ice_arr_kernels* ICE_ARR_CALLCONV ice_arr_get_kernels(void) {
+    InitOnceExecuteOnce(&ice_arr_kernels_once, ice_arr_kernels_init_once, NULL, NULL);
+    return &ice_arr_kernels_table;
+}
+#else
+static pthread_once_t ice_arr_kernels_once = PTHREAD_ONCE_INIT;
+
+static void ice_arr_kernels_init_once(void) {
+    ice_arr_kernels_init();
+}
+
+ICE_ARR_API ice_arr_kernels* ICE_ARR_CALLCONV ice_arr_get_kernels(void) {
+    pthread_once(&ice_arr_kernels_once, ice_arr_kernels_init_once);
+    return &ice_arr_kernels_table;
+}
+#endif
+
+ICE_ARR_API ice_arr_simd ICE_ARR_CALLCONV ice_arr_simd_level(void) {
+    ice_arr_get_kernels();
+    return (ice_arr_simd) ice_arr_kernels_level;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arr KEYS AND HASH SET
+///////////////////////////////////////////////////////////////////////////////////////////
+// Set operations (unique, diff, intersect, union) use open-addressing hash set keyed on double bits.
+// To match == comparison, -0 and +0 are same key, And unlike ==, All NaNs are same key (NaN matches NaN).
+
+// Maps double bits to unsigned key that sorts same as the double (Negative numbers get all bits flipped)
+ICE_ARR_API unsigned long long ICE_ARR_CALLCONV ice_arr_sort_key(double d) {
+    unsigned long long k;
+    memcpy(&k, &d, sizeof(double));
+    return (k & 0x8000000000000000ULL) ? ~k : (k | 0x8000000000000000ULL);
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_sort_unkey(unsigned long long k) {
+    double d;
+    k = (k & 0x8000000000000000ULL) ? (k & ~0x8000000000000000ULL) : ~k;
+    memcpy(&d, &k, sizeof(double));
+    return d;
+}
+
+// Returns bits of double used as set key (-0 becomes +0, NaNs become one quiet NaN)
+ICE_ARR_API unsigned long long ICE_ARR_CALLCONV ice_arr_hashset_key(double d) {
+    unsigned long long k;
+    if (d == 0) return 0;
+    if (d != d) return 0x7FF8000000000000ULL;
+    memcpy(&k, &d, sizeof(double));
+    return k;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_without(ice_arr_array arr, double val) {
-    int matches = 0;
-    int count   = 0;
+typedef struct ice_arr_hashset {
+    unsigned long long* keys;   // 0 means empty slot, Key 0 is tracked by has_zero instead
+    int cap;                    // Power of 2, Kept at least twice count of keys
+    int has_zero;
+} ice_arr_hashset;
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_hashset_init(ice_arr_hashset* set, int count) {
+    set->cap = 16;
+    set->has_zero = 0;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] == val) matches++;
+    while (set->cap < count * 2) {
+        set->cap *= 2;
     }
     
-    ice_arr_array res = ice_arr_new(arr.len - matches);
+    set->keys = (unsigned long long*) ICE_ARR_CALLOC(set->cap, sizeof(unsigned long long));
+    return (set->keys == NULL) ? ICE_ARR_FALSE : ICE_ARR_TRUE;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_hashset_free(ice_arr_hashset* set) {
+    ICE_ARR_FREE(set->keys);
+}
+
+// fmix64 finalizer from MurmurHash3, Spreads exponent bits over all slots
+ICE_ARR_API unsigned int ICE_ARR_CALLCONV ice_arr_hashset_hash(unsigned long long k) {
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33;
+    k *= 0xC4CEB9FE1A85EC53ULL;
+    k ^= k >> 33;
+    return (unsigned int) k;
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_hashset_has(ice_arr_hashset* set, unsigned long long k) {
+    if (k == 0) return set->has_zero ? ICE_ARR_TRUE : ICE_ARR_FALSE;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] != val) {
-            res.arr[count] = arr.arr[i];
-            count++;
-        }
+    unsigned int mask = (unsigned int) set->cap - 1;
+    unsigned int i = ice_arr_hashset_hash(k) & mask;
+    
+    while (set->keys[i] != 0) {
+        if (set->keys[i] == k) return ICE_ARR_TRUE;
+        i = (i + 1) & mask;
     }
     
-    return res;
+    return ICE_ARR_FALSE;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_clone(ice_arr_array arr, int n) {
-    int count = 0;
-    ice_arr_array res = ice_arr_new(arr.len * n);
+// Inserts key, Returns ICE_ARR_TRUE if key wasn't in set before
+// NOTE: Set doesn't grow, So it must be initialized with count of keys that will be inserted at most!
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_hashset_insert(ice_arr_hashset* set, unsigned long long k) {
+    if (k == 0) {
+        if (set->has_zero) return ICE_ARR_FALSE;
+        set->has_zero = 1;
+        return ICE_ARR_TRUE;
+    }
     
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < arr.len; j++) {
-            res.arr[j + count] = arr.arr[j];
-        }
-        
-        count += arr.len;
+    unsigned int mask = (unsigned int) set->cap - 1;
+    unsigned int i = ice_arr_hashset_hash(k) & mask;
+    
+    while (set->keys[i] != 0) {
+        if (set->keys[i] == k) return ICE_ARR_FALSE;
+        i = (i + 1) & mask;
     }
     
-    return res;
+    set->keys[i] = k;
+    return ICE_ARR_TRUE;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_rest(ice_arr_array arr, int index) {
-    ice_arr_array res = ice_arr_new(arr.len - 1);
-    
-    for (int i = 0; i < arr.len; i++) {
-        if (!(i == index)) {
-            res.arr[i] = arr.arr[i];
-        }
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arr ARRAYS
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arr_array and typed arrays (ice_arr_f32, ice_arr_i32, etc...) are expanded from same ICE_ARR_ARRAY_IMPL body,
+// Only sum, min, max, matches and find are written per element type (SIMD kernels for doubles, Plain loops for typed arrays).
+// ICE_ARR_ARRAY_IMPL arguments:
+// name: Prefix of function names, A and V: Array and view types, ITER and RES: Iterator and comparator function types
+// T: Element type, KT: Unsigned type that sorting keys are stored in (Same size as T)
+// KEY(x), UNKEY(k): Maps T to KT and back, So that unsigned order of keys is same as order of values (Used by radix sort)
+// HKEY(x): Maps T to unsigned long long, Values that compare equal must have same key (Used by hash set)
+//
+// Storage: arr points to first element and allocation starts at (arr - head), Space left before first element by shift
+// gets used by unshift, And grow_back only moves elements back to allocation start once it's at least quarter of allocation.
+// _into functions write result into dst and grow it if needed, Sources may point anywhere into memory of dst (Ex. ice_arr_first_into(&a, a, 3)
+// or ice_arr_concat_into(&a, a, ice_arr_from_view(ice_arr_view_from(a, 2)))) and get moved with it when dst grows.
+// Except union_into, diff_sorted_into (Second array) and union_sorted_into (Both arrays), Which return ICE_ARR_FALSE for such sources.
+// ice_arr_move copies only elements that exist in a1, Elements between end of a2 and to_index become 0.
+// Views point into memory of existing array, So they allocate nothing and copy nothing.
+// They stay valid until array they point to gets freed or grows (push, unshift, reserve, _into functions, etc...)
+// Sorted set operations need inputs sorted from smaller to bigger (By ice_arr_sort for example) and without NaNs,
+// They don't allocate anything except result, And result is sorted too.
+// Default sort path (ice_arr_sort, ice_arr_sort_desc) uses LSD radix sort on keys made by KEY (IEEE-754 bits for doubles).
+// Shorter arrays (Or ones radix sort can't allocate keys for) are sorted by comparing same keys, So order never depends on length.
+// Comparator path (ice_arr_sort_ex) uses introsort, And ice_arr_sort_ex_stable uses merge sort.
+
+// Arrays with length smaller than this are sorted with insertion sort
+#define ICE_ARR_SORT_INSERTION_LEN 16
+
+// Arrays with length smaller than this are not worth radix sort passes (They are insertion sorted on same keys)
+#define ICE_ARR_SORT_RADIX_LEN 256
+
+// Bits per radix sort pass (6 passes for 64-bit keys)
+#define ICE_ARR_SORT_RADIX_BITS 11
+
+// Comparator used when sorting with ice_arr_sort_ex, a comes before b if f(b, a) returns 1
+#define ICE_ARR_SORT_LESS(f, a, b) ((int) (f)((b), (a)) == 1)
+
+// Returns capacity after growing array allocation of cap elements to fit at least need elements
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_grow_cap(int cap, int need) {
+    int res = (int) (cap * ICE_ARR_GROWTH_FACTOR);
+    if (res <= cap) res = cap + 4;
+    return (res < need) ? need : res;
+}
+
+// Clamps count of elements to [0, len]
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_clamp(int n, int len) {
+    return (n < 0) ? 0 : ((n > len) ? len : n);
+}
+
+// Returns 1 if memory ranges [p, p + n) and [q, q + m) share any byte, Used to find _into sources that point into dst
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_mem_overlaps(const void* p, size_t n, const void* q, size_t m) {
+    uintptr_t a = (uintptr_t) p, b = (uintptr_t) q;
+    return (n > 0 && m > 0 && a < b + m && b < a + n);
+}
+
+// Depth limit of introsort before it falls back to heap sort
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_sort_depth(int n) {
+    int depth = 0;
+    while (n > 1) { n >>= 1; depth++; }
+    return depth * 2;
+}
+#define ICE_ARR_ARRAY_IMPL(name, A, V, ITER, RES, T, KT, KEY, UNKEY, HKEY)                          \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_new(int len) {                                                \
+    A res = { NULL, 0, 0, 0 };                                                                      \
+                                                                                                    \
+    if (len < 0) len = 0;                                                                           \
+    res.arr = (T*) ICE_ARR_CALLOC((size_t) (len + (len / 2) + 1), sizeof(T));                       \
+                                                                                                    \
+    if (res.arr != NULL) {                                                                          \
+        res.len = len;                                                                              \
+        res.real_len = len + (len / 2) + 1;                                                         \
+    }                                                                                               \
+                                                                                                    \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_compact_head(A* arr) {                                     \
+    if (arr->head > 0) {                                                                            \
+        memmove(arr->arr - arr->head, arr->arr, arr->len * sizeof(T));                              \
+        arr->arr -= arr->head;                                                                      \
+        arr->head = 0;                                                                              \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_grow_back(A* arr, int extra) {                     \
+    int need = arr->len + extra;                                                                    \
+                                                                                                    \
+    if (arr->head + need <= arr->real_len) {                                                        \
+        return ICE_ARR_TRUE;                                                                        \
+    }                                                                                               \
+                                                                                                    \
+    if (need <= arr->real_len && arr->head * 4 >= arr->real_len) {                                  \
+        name##_compact_head(arr);                                                                   \
+        return ICE_ARR_TRUE;                                                                        \
+    }                                                                                               \
+                                                                                                    \
+    int cap = ice_arr_grow_cap(arr->real_len, arr->head + need);                                    \
+    T* base = (T*) ICE_ARR_REALLOC(arr->arr - arr->head, cap * sizeof(T));                          \
+                                                                                                    \
+    if (base == NULL) {                                                                             \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    arr->arr = base + arr->head;                                                                    \
+    arr->real_len = cap;                                                                            \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_grow_front(A* arr, int extra) {                    \
+    if (arr->head >= extra) {                                                                       \
+        return ICE_ARR_TRUE;                                                                        \
+    }                                                                                               \
+                                                                                                    \
+    int head = extra + arr->len / 2 + 1;                                                            \
+    int tail = arr->real_len - arr->head - arr->len;                                                \
+                                                                                                    \
+    if (head + arr->len <= arr->real_len) {                                                         \
+        memmove(arr->arr - arr->head + head, arr->arr, arr->len * sizeof(T));                       \
+        arr->arr += head - arr->head;                                                               \
+        arr->head = head;                                                                           \
+        return ICE_ARR_TRUE;                                                                        \
+    }                                                                                               \
+                                                                                                    \
+    int cap = ice_arr_grow_cap(arr->real_len, head + arr->len + tail);                              \
+    T* base = (T*) ICE_ARR_MALLOC(cap * sizeof(T));                                                 \
+                                                                                                    \
+    if (base == NULL) {                                                                             \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (arr->len > 0) {                                                                             \
+        memcpy(base + head, arr->arr, arr->len * sizeof(T));                                        \
+    }                                                                                               \
+                                                                                                    \
+    ICE_ARR_FREE(arr->arr - arr->head);                                                             \
+    arr->arr = base + head;                                                                         \
+    arr->head = head;                                                                               \
+    arr->real_len = cap;                                                                            \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_reserve(A* arr, int cap) {                         \
+    return (cap <= arr->len) ? ICE_ARR_TRUE : name##_grow_back(arr, cap - arr->len);                \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API int ICE_ARR_CALLCONV name##_overlaps(A* dst, A arr) {                                   \
+    return ice_arr_mem_overlaps(arr.arr, arr.len * sizeof(T), dst->arr, (dst->real_len - dst->head) * sizeof(T)); \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_into_reserve(A* dst, int n, A* a1, A* a2) {        \
+    ptrdiff_t o1 = (a1 != NULL && name##_overlaps(dst, *a1)) ? a1->arr - dst->arr : -1;             \
+    ptrdiff_t o2 = (a2 != NULL && name##_overlaps(dst, *a2)) ? a2->arr - dst->arr : -1;             \
+                                                                                                    \
+    if (name##_reserve(dst, n) == ICE_ARR_FALSE) {                                                  \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (o1 >= 0) {                                                                                  \
+        a1->arr = dst->arr + o1;                                                                    \
+    }                                                                                               \
+                                                                                                    \
+    if (o2 >= 0) {                                                                                  \
+        a2->arr = dst->arr + o2;                                                                    \
+    }                                                                                               \
+                                                                                                    \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_empty(void) {                                                 \
+    A res = { NULL, 0, 0, 0 };                                                                      \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_shrink_to_fit(A* arr) {                            \
+    int cap = (arr->len > 0) ? arr->len : 1;                                                        \
+                                                                                                    \
+    name##_compact_head(arr);                                                                       \
+                                                                                                    \
+    if (arr->real_len == cap) {                                                                     \
+        return ICE_ARR_TRUE;                                                                        \
+    }                                                                                               \
+                                                                                                    \
+    T* base = (T*) ICE_ARR_REALLOC(arr->arr, cap * sizeof(T));                                      \
+                                                                                                    \
+    if (base == NULL) {                                                                             \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    arr->arr = base;                                                                                \
+    arr->real_len = cap;                                                                            \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API T ICE_ARR_CALLCONV name##_get(A arr, int index) {                                       \
+    return (index >= 0 && index < arr.len) ? arr.arr[index] : (T) 0;                                \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_set(A* arr, int index, T val) {                            \
+    if (index >= 0 && index < arr->len) {                                                           \
+        arr->arr[index] = val;                                                                      \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API int ICE_ARR_CALLCONV name##_len(A arr) {                                                \
+    return arr.len;                                                                                 \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_pop(A* arr) {                                              \
+    if (arr->len > 0) {                                                                             \
+        arr->len--;                                                                                 \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_shift(A* arr) {                                            \
+    if (arr->len > 0) {                                                                             \
+        arr->arr++;                                                                                 \
+        arr->head++;                                                                                \
+        arr->len--;                                                                                 \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_push(A* arr, T val) {                              \
+    if (name##_grow_back(arr, 1) == ICE_ARR_FALSE) {                                                \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    arr->arr[arr->len++] = val;                                                                     \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_unshift(A* arr, T val) {                           \
+    if (name##_grow_front(arr, 1) == ICE_ARR_FALSE) {                                               \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    arr->arr--;                                                                                     \
+    arr->head--;                                                                                    \
+    arr->len++;                                                                                     \
+    arr->arr[0] = val;                                                                              \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_reverse(T* a, int n) {                                     \
+    for (int i = 0; i < n / 2; i++) {                                                               \
+        T tmp = a[i];                                                                               \
+        a[i] = a[n - 1 - i];                                                                        \
+        a[n - 1 - i] = tmp;                                                                         \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_rev(A* arr) {                                              \
+    name##_reverse(arr->arr, arr->len);                                                             \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_free(A arr) {                                              \
+    ICE_ARR_FREE(arr.arr - arr.head);                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_fill(A* arr, T val) {                                      \
+    for (int i = 0; i < arr->len; i++) {                                                            \
+        arr->arr[i] = val;                                                                          \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_clear(A* arr) {                                            \
+    if (arr->len > 0) {                                                                             \
+        memset(arr->arr, 0, arr->len * sizeof(T));                                                  \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_match(A a1, A a2) {                                \
+    if (a1.len != a2.len) {                                                                         \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    for (int i = 0; i < a1.len; i++) {                                                              \
+        if (a1.arr[i] != a2.arr[i]) {                                                               \
+            return ICE_ARR_FALSE;                                                                   \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_includes(A arr, T val) {                           \
+    return (name##_find(arr, val) >= 0) ? ICE_ARR_TRUE : ICE_ARR_FALSE;                             \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API int ICE_ARR_CALLCONV name##_first_index(A arr, T val) {                                 \
+    int occurence = name##_find(arr, val);                                                          \
+    return (occurence < 0) ? 0 : occurence;                                                         \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API int ICE_ARR_CALLCONV name##_last_index(A arr, T val) {                                  \
+    for (int i = arr.len - 1; i >= 0; i--) {                                                        \
+        if (arr.arr[i] == val) {                                                                    \
+            return i;                                                                               \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    return 0;                                                                                       \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_rem(A* arr, int index) {                                   \
+    if (index >= 0 && index < arr->len) {                                                           \
+        memmove(arr->arr + index, arr->arr + index + 1, (arr->len - index - 1) * sizeof(T));        \
+        arr->len--;                                                                                 \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_foreach(A arr, ITER f) {                                   \
+    for (int i = 0; i < arr.len; i++) {                                                             \
+        f(arr.arr[i]);                                                                              \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_rotate(A* arr, int times) {                                \
+    if (arr->len < 2) {                                                                             \
+        return;                                                                                     \
+    }                                                                                               \
+                                                                                                    \
+    times %= arr->len;                                                                              \
+    if (times < 0) times += arr->len;                                                               \
+                                                                                                    \
+    name##_reverse(arr->arr, times);                                                                \
+    name##_reverse(arr->arr + times, arr->len - times);                                             \
+    name##_reverse(arr->arr, arr->len);                                                             \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_move(A* a1, int from_index, int elems_count, int to_index, A* a2) { \
+    from_index = ice_arr_clamp(from_index, a1->len);                                                \
+    elems_count = ice_arr_clamp(elems_count, a1->len - from_index);                                 \
+                                                                                                    \
+    if (to_index < 0 || elems_count == 0) {                                                         \
+        return;                                                                                     \
+    }                                                                                               \
+                                                                                                    \
+    int gap = to_index - a2->len;                                                                   \
+                                                                                                    \
+    if (name##_reserve(a2, to_index + elems_count) == ICE_ARR_FALSE) {                              \
+        return;                                                                                     \
+    }                                                                                               \
+                                                                                                    \
+    memmove(a2->arr + to_index, a1->arr + from_index, elems_count * sizeof(T));                     \
+                                                                                                    \
+    if (gap > 0) {                                                                                  \
+        memset(a2->arr + to_index - gap, 0, gap * sizeof(T));                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (to_index + elems_count > a2->len) {                                                         \
+        a2->len = to_index + elems_count;                                                           \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_first_into(A* dst, A arr, int elems) {             \
+    elems = ice_arr_clamp(elems, arr.len);                                                          \
+                                                                                                    \
+    if (name##_into_reserve(dst, elems, &arr, NULL) == ICE_ARR_FALSE) {                             \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (elems > 0) {                                                                                \
+        memmove(dst->arr, arr.arr, elems * sizeof(T));                                              \
+    }                                                                                               \
+                                                                                                    \
+    dst->len = elems;                                                                               \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_last_into(A* dst, A arr, int elems) {              \
+    elems = ice_arr_clamp(elems, arr.len);                                                          \
+                                                                                                    \
+    if (name##_into_reserve(dst, elems, &arr, NULL) == ICE_ARR_FALSE) {                             \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (elems > 0) {                                                                                \
+        memmove(dst->arr, arr.arr + arr.len - elems, elems * sizeof(T));                            \
+    }                                                                                               \
+                                                                                                    \
+    dst->len = elems;                                                                               \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_concat_into(A* dst, A a1, A a2) {                  \
+    if (name##_into_reserve(dst, a1.len + a2.len, &a1, &a2) == ICE_ARR_FALSE) {                     \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (!ice_arr_mem_overlaps(a2.arr, a2.len * sizeof(T), dst->arr, a1.len * sizeof(T))) {          \
+        if (a1.len > 0) memmove(dst->arr, a1.arr, a1.len * sizeof(T));                              \
+        if (a2.len > 0) memmove(dst->arr + a1.len, a2.arr, a2.len * sizeof(T));                     \
+    } else if (!ice_arr_mem_overlaps(a1.arr, a1.len * sizeof(T), dst->arr + a1.len, a2.len * sizeof(T))) { \
+        memmove(dst->arr + a1.len, a2.arr, a2.len * sizeof(T));                                     \
+        if (a1.len > 0) memmove(dst->arr, a1.arr, a1.len * sizeof(T));                              \
+    } else {                                                                                        \
+        T* tmp = (T*) ICE_ARR_MALLOC(a2.len * sizeof(T));                                           \
+                                                                                                    \
+        if (tmp == NULL) {                                                                          \
+            return ICE_ARR_FALSE;                                                                   \
+        }                                                                                           \
+                                                                                                    \
+        memcpy(tmp, a2.arr, a2.len * sizeof(T));                                                    \
+        memmove(dst->arr, a1.arr, a1.len * sizeof(T));                                              \
+        memcpy(dst->arr + a1.len, tmp, a2.len * sizeof(T));                                         \
+        ICE_ARR_FREE(tmp);                                                                          \
+    }                                                                                               \
+                                                                                                    \
+    dst->len = a1.len + a2.len;                                                                     \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_sub_into(A* dst, A arr, int from, int to) {        \
+    from = ice_arr_clamp(from, arr.len);                                                            \
+    to = ice_arr_clamp(to + 1, arr.len);                                                            \
+                                                                                                    \
+    int n = (to > from) ? to - from : 0;                                                            \
+                                                                                                    \
+    if (name##_into_reserve(dst, n, &arr, NULL) == ICE_ARR_FALSE) {                                 \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (n > 0) {                                                                                    \
+        memmove(dst->arr, arr.arr + from, n * sizeof(T));                                           \
+    }                                                                                               \
+                                                                                                    \
+    dst->len = n;                                                                                   \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_without_into(A* dst, A arr, T val) {               \
+    int count = 0;                                                                                  \
+                                                                                                    \
+    if (name##_into_reserve(dst, arr.len - name##_matches(arr, val), &arr, NULL) == ICE_ARR_FALSE) { \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    for (int i = 0; i < arr.len; i++) {                                                             \
+        if (arr.arr[i] != val) {                                                                    \
+            dst->arr[count] = arr.arr[i];                                                           \
+            count++;                                                                                \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    dst->len = count;                                                                               \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_clone_into(A* dst, A arr, int n) {                 \
+    if (n < 0) n = 0;                                                                               \
+                                                                                                    \
+    if (name##_into_reserve(dst, arr.len * n, &arr, NULL) == ICE_ARR_FALSE) {                       \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (n > 0 && arr.len > 0) {                                                                     \
+        memmove(dst->arr, arr.arr, arr.len * sizeof(T));                                            \
+                                                                                                    \
+        for (int i = 1; i < n; i++) {                                                               \
+            memcpy(dst->arr + i * arr.len, dst->arr, arr.len * sizeof(T));                          \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    dst->len = arr.len * n;                                                                         \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_rest_into(A* dst, A arr, int index) {              \
+    if (index < 0 || index >= arr.len) {                                                            \
+        return name##_first_into(dst, arr, arr.len);                                                \
+    }                                                                                               \
+                                                                                                    \
+    if (name##_into_reserve(dst, arr.len - 1, &arr, NULL) == ICE_ARR_FALSE) {                       \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    memmove(dst->arr, arr.arr, index * sizeof(T));                                                  \
+    memmove(dst->arr + index, arr.arr + index + 1, (arr.len - index - 1) * sizeof(T));              \
+    dst->len = arr.len - 1;                                                                         \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_range_into(A* dst, int i) {                        \
+    if (i < 0) i = 0;                                                                               \
+                                                                                                    \
+    if (name##_reserve(dst, i) == ICE_ARR_FALSE) {                                                  \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    for (int j = 0; j < i; j++) {                                                                   \
+        dst->arr[j] = (T) j;                                                                        \
+    }                                                                                               \
+                                                                                                    \
+    dst->len = i;                                                                                   \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_compact_into(A* dst, A arr) {                      \
+    return name##_without_into(dst, arr, (T) 0);                                                    \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_tail_into(A* dst, A arr) {                         \
+    return name##_last_into(dst, arr, arr.len - 1);                                                 \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_unique_into(A* dst, A arr) {                       \
+    ice_arr_hashset seen;                                                                           \
+    int count = 0;                                                                                  \
+                                                                                                    \
+    if (name##_into_reserve(dst, arr.len, &arr, NULL) == ICE_ARR_FALSE) {                           \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (ice_arr_hashset_init(&seen, arr.len) == ICE_ARR_FALSE) {                                    \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    for (int i = 0; i < arr.len; i++) {                                                             \
+        if (ice_arr_hashset_insert(&seen, HKEY(arr.arr[i])) == ICE_ARR_TRUE) {                      \
+            dst->arr[count] = arr.arr[i];                                                           \
+            count++;                                                                                \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    ice_arr_hashset_free(&seen);                                                                    \
+    dst->len = count;                                                                               \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_diff_into(A* dst, A a1, A a2) {                    \
+    ice_arr_hashset exclude;                                                                        \
+    int count = 0;                                                                                  \
+                                                                                                    \
+    if (ice_arr_hashset_init(&exclude, a2.len) == ICE_ARR_FALSE) {                                  \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    for (int i = 0; i < a2.len; i++) {                                                              \
+        ice_arr_hashset_insert(&exclude, HKEY(a2.arr[i]));                                          \
+    }                                                                                               \
+                                                                                                    \
+    if (name##_into_reserve(dst, a1.len, &a1, NULL) == ICE_ARR_FALSE) {                             \
+        ice_arr_hashset_free(&exclude);                                                             \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    for (int i = 0; i < a1.len; i++) {                                                              \
+        if (ice_arr_hashset_has(&exclude, HKEY(a1.arr[i])) == ICE_ARR_FALSE) {                      \
+            dst->arr[count] = a1.arr[i];                                                            \
+            count++;                                                                                \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    ice_arr_hashset_free(&exclude);                                                                 \
+    dst->len = count;                                                                               \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_intersect_into(A* dst, A a1, A a2) {               \
+    int len = (a1.len < a2.len) ? a1.len : a2.len;                                                  \
+    ice_arr_hashset other, seen;                                                                    \
+    int count = 0;                                                                                  \
+                                                                                                    \
+    if (ice_arr_hashset_init(&other, a2.len) == ICE_ARR_FALSE) {                                    \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (ice_arr_hashset_init(&seen, len) == ICE_ARR_FALSE) {                                        \
+        ice_arr_hashset_free(&other);                                                               \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    for (int i = 0; i < a2.len; i++) {                                                              \
+        ice_arr_hashset_insert(&other, HKEY(a2.arr[i]));                                            \
+    }                                                                                               \
+                                                                                                    \
+    if (name##_into_reserve(dst, len, &a1, NULL) == ICE_ARR_FALSE) {                                \
+        ice_arr_hashset_free(&other);                                                               \
+        ice_arr_hashset_free(&seen);                                                                \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    for (int i = 0; i < a1.len; i++) {                                                              \
+        unsigned long long k = HKEY(a1.arr[i]);                                                     \
+                                                                                                    \
+        if (ice_arr_hashset_has(&other, k) == ICE_ARR_TRUE && ice_arr_hashset_insert(&seen, k) == ICE_ARR_TRUE) { \
+            dst->arr[count] = a1.arr[i];                                                            \
+            count++;                                                                                \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    ice_arr_hashset_free(&other);                                                                   \
+    ice_arr_hashset_free(&seen);                                                                    \
+    dst->len = count;                                                                               \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_union_into(A* dst, A a1, A a2) {                   \
+    ice_arr_hashset seen;                                                                           \
+    int count = 0;                                                                                  \
+                                                                                                    \
+    if (name##_overlaps(dst, a2)) {                                                                 \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (ice_arr_hashset_init(&seen, a1.len + a2.len) == ICE_ARR_FALSE) {                            \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (name##_into_reserve(dst, a1.len + a2.len, &a1, NULL) == ICE_ARR_FALSE) {                    \
+        ice_arr_hashset_free(&seen);                                                                \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    for (int i = 0; i < a1.len; i++) {                                                              \
+        if (ice_arr_hashset_insert(&seen, HKEY(a1.arr[i])) == ICE_ARR_TRUE) {                       \
+            dst->arr[count] = a1.arr[i];                                                            \
+            count++;                                                                                \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    for (int i = 0; i < a2.len; i++) {                                                              \
+        if (ice_arr_hashset_insert(&seen, HKEY(a2.arr[i])) == ICE_ARR_TRUE) {                       \
+            dst->arr[count] = a2.arr[i];                                                            \
+            count++;                                                                                \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    ice_arr_hashset_free(&seen);                                                                    \
+    dst->len = count;                                                                               \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API KT ICE_ARR_CALLCONV name##_merge_key(T x) {                                             \
+    return KEY((x == 0) ? (T) 0 : x);                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_unique_sorted_into(A* dst, A arr) {                \
+    int count = 0;                                                                                  \
+                                                                                                    \
+    if (name##_into_reserve(dst, arr.len, &arr, NULL) == ICE_ARR_FALSE) {                           \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    for (int i = 0; i < arr.len; i++) {                                                             \
+        if (count == 0 || arr.arr[i] != dst->arr[count - 1]) {                                      \
+            dst->arr[count] = arr.arr[i];                                                           \
+            count++;                                                                                \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    dst->len = count;                                                                               \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_diff_sorted_into(A* dst, A a1, A a2) {             \
+    int count = 0;                                                                                  \
+    int j = 0;                                                                                      \
+                                                                                                    \
+    if (name##_overlaps(dst, a2)) {                                                                 \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (name##_into_reserve(dst, a1.len, &a1, NULL) == ICE_ARR_FALSE) {                             \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    for (int i = 0; i < a1.len; i++) {                                                              \
+        KT k = name##_merge_key(a1.arr[i]);                                                         \
+                                                                                                    \
+        while (j < a2.len && name##_merge_key(a2.arr[j]) < k) j++;                                  \
+                                                                                                    \
+        if (j == a2.len || name##_merge_key(a2.arr[j]) != k) {                                      \
+            dst->arr[count] = a1.arr[i];                                                            \
+            count++;                                                                                \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    dst->len = count;                                                                               \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_intersect_sorted_into(A* dst, A a1, A a2) {        \
+    int count = 0;                                                                                  \
+    int i = 0, j = 0;                                                                               \
+                                                                                                    \
+    if (name##_into_reserve(dst, (a1.len < a2.len) ? a1.len : a2.len, &a1, &a2) == ICE_ARR_FALSE) { \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    while (i < a1.len && j < a2.len) {                                                              \
+        KT k1 = name##_merge_key(a1.arr[i]);                                                        \
+        KT k2 = name##_merge_key(a2.arr[j]);                                                        \
+                                                                                                    \
+        if (k1 < k2) {                                                                              \
+            i++;                                                                                    \
+        } else if (k2 < k1) {                                                                       \
+            j++;                                                                                    \
+        } else {                                                                                    \
+            if (count == 0 || a1.arr[i] != dst->arr[count - 1]) {                                   \
+                dst->arr[count] = a1.arr[i];                                                        \
+                count++;                                                                            \
+            }                                                                                       \
+                                                                                                    \
+            i++;                                                                                    \
+            j++;                                                                                    \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    dst->len = count;                                                                               \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_union_sorted_into(A* dst, A a1, A a2) {            \
+    int count = 0;                                                                                  \
+    int i = 0, j = 0;                                                                               \
+                                                                                                    \
+    if (name##_overlaps(dst, a1) || name##_overlaps(dst, a2)) {                                     \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    if (name##_reserve(dst, a1.len + a2.len) == ICE_ARR_FALSE) {                                    \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    while (i < a1.len || j < a2.len) {                                                              \
+        T n;                                                                                        \
+                                                                                                    \
+        if (j == a2.len || (i < a1.len && name##_merge_key(a1.arr[i]) <= name##_merge_key(a2.arr[j]))) { \
+            n = a1.arr[i++];                                                                        \
+        } else {                                                                                    \
+            n = a2.arr[j++];                                                                        \
+        }                                                                                           \
+                                                                                                    \
+        if (count == 0 || n != dst->arr[count - 1]) {                                               \
+            dst->arr[count] = n;                                                                    \
+            count++;                                                                                \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    dst->len = count;                                                                               \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_first(A arr, int elems) {                                     \
+    A res = name##_empty();                                                                         \
+    name##_first_into(&res, arr, elems);                                                            \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_last(A arr, int elems) {                                      \
+    A res = name##_empty();                                                                         \
+    name##_last_into(&res, arr, elems);                                                             \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_concat(A a1, A a2) {                                          \
+    A res = name##_empty();                                                                         \
+    name##_concat_into(&res, a1, a2);                                                               \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_sub(A arr, int from, int to) {                                \
+    A res = name##_empty();                                                                         \
+    name##_sub_into(&res, arr, from, to);                                                           \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_without(A arr, T val) {                                       \
+    A res = name##_empty();                                                                         \
+    name##_without_into(&res, arr, val);                                                            \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_clone(A arr, int n) {                                         \
+    A res = name##_empty();                                                                         \
+    name##_clone_into(&res, arr, n);                                                                \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_rest(A arr, int index) {                                      \
+    A res = name##_empty();                                                                         \
+    name##_rest_into(&res, arr, index);                                                             \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_unique(A arr) {                                               \
+    A res = name##_empty();                                                                         \
+    name##_unique_into(&res, arr);                                                                  \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_diff(A a1, A a2) {                                            \
+    A res = name##_empty();                                                                         \
+    name##_diff_into(&res, a1, a2);                                                                 \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_range(int i) {                                                \
+    A res = name##_empty();                                                                         \
+    name##_range_into(&res, i);                                                                     \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_compact(A arr) {                                              \
+    A res = name##_empty();                                                                         \
+    name##_compact_into(&res, arr);                                                                 \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_tail(A arr) {                                                 \
+    A res = name##_empty();                                                                         \
+    name##_tail_into(&res, arr);                                                                    \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_intersect(A a1, A a2) {                                       \
+    A res = name##_empty();                                                                         \
+    name##_intersect_into(&res, a1, a2);                                                            \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_union(A a1, A a2) {                                           \
+    A res = name##_empty();                                                                         \
+    name##_union_into(&res, a1, a2);                                                                \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_unique_sorted(A arr) {                                        \
+    A res = name##_empty();                                                                         \
+    name##_unique_sorted_into(&res, arr);                                                           \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_diff_sorted(A a1, A a2) {                                     \
+    A res = name##_empty();                                                                         \
+    name##_diff_sorted_into(&res, a1, a2);                                                          \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_intersect_sorted(A a1, A a2) {                                \
+    A res = name##_empty();                                                                         \
+    name##_intersect_sorted_into(&res, a1, a2);                                                     \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_union_sorted(A a1, A a2) {                                    \
+    A res = name##_empty();                                                                         \
+    name##_union_sorted_into(&res, a1, a2);                                                         \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API V ICE_ARR_CALLCONV name##_view_of(A arr) {                                              \
+    V res = { arr.arr, arr.len };                                                                   \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API V ICE_ARR_CALLCONV name##_view_sub(A arr, int from, int to) {                           \
+    from = ice_arr_clamp(from, arr.len);                                                            \
+    to = ice_arr_clamp(to + 1, arr.len);                                                            \
+                                                                                                    \
+    V res = { arr.arr + from, (to > from) ? to - from : 0 };                                        \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API V ICE_ARR_CALLCONV name##_view_first(A arr, int elems) {                                \
+    V res = { arr.arr, ice_arr_clamp(elems, arr.len) };                                             \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API V ICE_ARR_CALLCONV name##_view_last(A arr, int elems) {                                 \
+    elems = ice_arr_clamp(elems, arr.len);                                                          \
+                                                                                                    \
+    V res = { arr.arr + arr.len - elems, elems };                                                   \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API V ICE_ARR_CALLCONV name##_view_tail(A arr) {                                            \
+    return name##_view_last(arr, arr.len - 1);                                                      \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API V ICE_ARR_CALLCONV name##_view_from(A arr, int index) {                                 \
+    index = ice_arr_clamp(index, arr.len);                                                          \
+                                                                                                    \
+    V res = { arr.arr + index, arr.len - index };                                                   \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API A ICE_ARR_CALLCONV name##_from_view(V view) {                                           \
+    A res = { view.arr, view.len, view.len, 0 };                                                    \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_insertion_sort(T* a, int n, RES f) {                       \
+    for (int i = 1; i < n; i++) {                                                                   \
+        T x = a[i];                                                                                 \
+        int j = i - 1;                                                                              \
+                                                                                                    \
+        while (j >= 0 && ICE_ARR_SORT_LESS(f, x, a[j])) {                                           \
+            a[j + 1] = a[j];                                                                        \
+            j--;                                                                                    \
+        }                                                                                           \
+                                                                                                    \
+        a[j + 1] = x;                                                                               \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_sift_down(T* a, int root, int n, RES f) {                  \
+    T x = a[root];                                                                                  \
+                                                                                                    \
+    while (2 * root + 1 < n) {                                                                      \
+        int child = 2 * root + 1;                                                                   \
+        if (child + 1 < n && ICE_ARR_SORT_LESS(f, a[child], a[child + 1])) child++;                 \
+        if (!ICE_ARR_SORT_LESS(f, x, a[child])) break;                                              \
+        a[root] = a[child];                                                                         \
+        root = child;                                                                               \
+    }                                                                                               \
+                                                                                                    \
+    a[root] = x;                                                                                    \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_swap(T* a, T* b) {                                         \
+    T tmp = *a;                                                                                     \
+    *a = *b;                                                                                        \
+    *b = tmp;                                                                                       \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_introsort(T* a, int n, int depth, RES f) {                 \
+    while (n > ICE_ARR_SORT_INSERTION_LEN) {                                                        \
+        if (depth-- == 0) {                                                                         \
+            for (int i = n / 2 - 1; i >= 0; i--) name##_sift_down(a, i, n, f);                      \
+                                                                                                    \
+            for (int i = n - 1; i > 0; i--) {                                                       \
+                name##_swap(a, a + i);                                                              \
+                name##_sift_down(a, 0, i, f);                                                       \
+            }                                                                                       \
+                                                                                                    \
+            return;                                                                                 \
+        }                                                                                           \
+                                                                                                    \
+        int mid = n / 2;                                                                            \
+        if (ICE_ARR_SORT_LESS(f, a[mid], a[0])) name##_swap(a + mid, a);                            \
+        if (ICE_ARR_SORT_LESS(f, a[n - 1], a[0])) name##_swap(a + n - 1, a);                        \
+        if (ICE_ARR_SORT_LESS(f, a[n - 1], a[mid])) name##_swap(a + n - 1, a + mid);                \
+        name##_swap(a, a + mid);                                                                    \
+                                                                                                    \
+        T pivot = a[0];                                                                             \
+        int i = 0, j = n;                                                                           \
+                                                                                                    \
+        for (;;) {                                                                                  \
+            do { i++; } while (i < n && ICE_ARR_SORT_LESS(f, a[i], pivot));                         \
+            do { j--; } while (ICE_ARR_SORT_LESS(f, pivot, a[j]));                                  \
+            if (i >= j) break;                                                                      \
+            name##_swap(a + i, a + j);                                                              \
+        }                                                                                           \
+                                                                                                    \
+        name##_swap(a, a + j);                                                                      \
+                                                                                                    \
+        if (j < n - j - 1) {                                                                        \
+            name##_introsort(a, j, depth, f);                                                       \
+            a += j + 1;                                                                             \
+            n -= j + 1;                                                                             \
+        } else {                                                                                    \
+            name##_introsort(a + j + 1, n - j - 1, depth, f);                                       \
+            n = j;                                                                                  \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    name##_insertion_sort(a, n, f);                                                                 \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_merge_sort(T* a, T* tmp, int n, RES f) {                   \
+    if (n <= ICE_ARR_SORT_INSERTION_LEN) {                                                          \
+        name##_insertion_sort(a, n, f);                                                             \
+        return;                                                                                     \
+    }                                                                                               \
+                                                                                                    \
+    int half = n / 2;                                                                               \
+    name##_merge_sort(a, tmp, half, f);                                                             \
+    name##_merge_sort(a + half, tmp, n - half, f);                                                  \
+                                                                                                    \
+    if (!ICE_ARR_SORT_LESS(f, a[half], a[half - 1])) return;                                        \
+                                                                                                    \
+    memcpy(tmp, a, half * sizeof(T));                                                               \
+                                                                                                    \
+    int i = 0, j = half, k = 0;                                                                     \
+                                                                                                    \
+    while (i < half && j < n) {                                                                     \
+        a[k++] = ICE_ARR_SORT_LESS(f, a[j], tmp[i]) ? a[j++] : tmp[i++];                            \
+    }                                                                                               \
+                                                                                                    \
+    while (i < half) {                                                                              \
+        a[k++] = tmp[i++];                                                                          \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV name##_radix_sort(T* a, int n, ice_arr_bool desc) {       \
+    if (n < 2) {                                                                                    \
+        return ICE_ARR_TRUE;                                                                        \
+    }                                                                                               \
+                                                                                                    \
+    const int buckets = 1 << ICE_ARR_SORT_RADIX_BITS;                                               \
+    const KT mask = (KT) (buckets - 1);                                                             \
+    KT* keys = (KT*) ICE_ARR_MALLOC(2 * (size_t) n * sizeof(KT));                                   \
+    int* counts = (int*) ICE_ARR_MALLOC(buckets * sizeof(int));                                     \
+                                                                                                    \
+    if (keys == NULL || counts == NULL) {                                                           \
+        ICE_ARR_FREE(keys);                                                                         \
+        ICE_ARR_FREE(counts);                                                                       \
+        return ICE_ARR_FALSE;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    KT* src = keys;                                                                                 \
+    KT* dst = keys + n;                                                                             \
+                                                                                                    \
+    for (int i = 0; i < n; i++) {                                                                   \
+        src[i] = (desc == ICE_ARR_TRUE) ? (KT) ~KEY(a[i]) : KEY(a[i]);                              \
+    }                                                                                               \
+                                                                                                    \
+    for (int shift = 0; shift < (int) (sizeof(KT) * 8); shift += ICE_ARR_SORT_RADIX_BITS) {         \
+        memset(counts, 0, buckets * sizeof(int));                                                   \
+                                                                                                    \
+        for (int i = 0; i < n; i++) {                                                               \
+            counts[(src[i] >> shift) & mask]++;                                                     \
+        }                                                                                           \
+                                                                                                    \
+        if (counts[(src[0] >> shift) & mask] == n) continue;                                        \
+                                                                                                    \
+        int sum = 0;                                                                                \
+                                                                                                    \
+        for (int i = 0; i < buckets; i++) {                                                         \
+            int c = counts[i];                                                                      \
+            counts[i] = sum;                                                                        \
+            sum += c;                                                                               \
+        }                                                                                           \
+                                                                                                    \
+        for (int i = 0; i < n; i++) {                                                               \
+            dst[counts[(src[i] >> shift) & mask]++] = src[i];                                       \
+        }                                                                                           \
+                                                                                                    \
+        KT* t = src;                                                                                \
+        src = dst;                                                                                  \
+        dst = t;                                                                                    \
+    }                                                                                               \
+                                                                                                    \
+    for (int i = 0; i < n; i++) {                                                                   \
+        a[i] = UNKEY((desc == ICE_ARR_TRUE) ? (KT) ~src[i] : src[i]);                               \
+    }                                                                                               \
+                                                                                                    \
+    ICE_ARR_FREE(keys);                                                                             \
+    ICE_ARR_FREE(counts);                                                                           \
+    return ICE_ARR_TRUE;                                                                            \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API int ICE_ARR_CALLCONV name##_cmp_asc(T a, T b) {                                         \
+    return (a > b) ? 1 : 0;                                                                         \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API int ICE_ARR_CALLCONV name##_cmp_desc(T a, T b) {                                        \
+    return (a < b) ? 1 : 0;                                                                         \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API int ICE_ARR_CALLCONV name##_cmp_key_asc(T a, T b) {                                     \
+    return (KEY(a) > KEY(b)) ? 1 : 0;                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API int ICE_ARR_CALLCONV name##_cmp_key_desc(T a, T b) {                                    \
+    return (KEY(a) < KEY(b)) ? 1 : 0;                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_sort_ex(A* arr, RES f) {                                   \
+    name##_introsort(arr->arr, arr->len, ice_arr_sort_depth(arr->len), f);                          \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_sort_ex_stable(A* arr, RES f) {                            \
+    if (arr->len <= ICE_ARR_SORT_INSERTION_LEN) {                                                   \
+        name##_insertion_sort(arr->arr, arr->len, f);                                               \
+        return;                                                                                     \
+    }                                                                                               \
+                                                                                                    \
+    T* tmp = (T*) ICE_ARR_MALLOC((arr->len / 2) * sizeof(T));                                       \
+                                                                                                    \
+    if (tmp == NULL) {                                                                              \
+        name##_insertion_sort(arr->arr, arr->len, f);                                               \
+        return;                                                                                     \
+    }                                                                                               \
+                                                                                                    \
+    name##_merge_sort(arr->arr, tmp, arr->len, f);                                                  \
+    ICE_ARR_FREE(tmp);                                                                              \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_sort(A* arr) {                                             \
+    if (arr->len < ICE_ARR_SORT_RADIX_LEN) {                                                        \
+        name##_insertion_sort(arr->arr, arr->len, name##_cmp_key_asc);                              \
+    } else if (name##_radix_sort(arr->arr, arr->len, ICE_ARR_FALSE) == ICE_ARR_FALSE) {             \
+        name##_sort_ex(arr, name##_cmp_key_asc);                                                    \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API void ICE_ARR_CALLCONV name##_sort_desc(A* arr) {                                        \
+    if (arr->len < ICE_ARR_SORT_RADIX_LEN) {                                                        \
+        name##_insertion_sort(arr->arr, arr->len, name##_cmp_key_desc);                             \
+    } else if (name##_radix_sort(arr->arr, arr->len, ICE_ARR_TRUE) == ICE_ARR_FALSE) {              \
+        name##_sort_ex(arr, name##_cmp_key_desc);                                                   \
+    }                                                                                               \
+}
+
+// Element type specific part of ice_arr_array, Uses kernels picked by ice_arr_get_kernels
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_sum(ice_arr_array arr) {
+    return ice_arr_get_kernels()->sum(arr.arr, arr.len);
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_sum_kahan(ice_arr_array arr) {
+    return ice_arr_get_kernels()->sum_kahan(arr.arr, arr.len);
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_pairwise(ice_arr_kernels* k, const double* a, int n) {
+    if (n <= ICE_ARR_PAIRWISE_BLOCK) {
+        return k->sum(a, n);
     }
     
+    int half = n / 2;
+    return ice_arr_pairwise(k, a, half) + ice_arr_pairwise(k, a + half, n - half);
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_sum_pairwise(ice_arr_array arr) {
+    return ice_arr_pairwise(ice_arr_get_kernels(), arr.arr, arr.len);
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_min(ice_arr_array arr) {
+    return ice_arr_get_kernels()->min(arr.arr, arr.len);
+}
+
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_max(ice_arr_array arr) {
+    return ice_arr_get_kernels()->max(arr.arr, arr.len);
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_find(ice_arr_array arr, double val) {
+    return ice_arr_get_kernels()->find(arr.arr, arr.len, val);
+}
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_matches(ice_arr_array arr, double val) {
+    return ice_arr_get_kernels()->matches(arr.arr, arr.len, val);
+}
+
+ICE_ARR_ARRAY_IMPL(ice_arr, ice_arr_array, ice_arr_view, ice_arr_iter_func, ice_arr_res_func, double, unsigned long long, ice_arr_sort_key, ice_arr_sort_unkey, ice_arr_hashset_key)
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arr PIPELINES
+///////////////////////////////////////////////////////////////////////////////////////////
+// Stages only get recorded by builder functions, Terminal functions (sum, count, to_array, etc...) run all of them
+// in single pass over source array, Passing each element through stages one by one so no intermediate arrays get allocated.
+ICE_ARR_API ice_arr_pipe ICE_ARR_CALLCONV ice_arr_pipe_new(ice_arr_array arr) {
+    ice_arr_pipe res;
+    
+    memset(&res, 0, sizeof(res));
+    res.src = arr;
+    res.ok = ICE_ARR_TRUE;
     return res;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_unique(ice_arr_array arr) {
-    int len = 0;
-    int count = 0;
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_pipe_add(ice_arr_pipe* pipe, ice_arr_stage stage) {
+    if (pipe->len >= ICE_ARR_PIPE_MAX_STAGES) {
+        pipe->ok = ICE_ARR_FALSE;
+        return ICE_ARR_FALSE;
+    }
     
-    for (int i = 0; i < arr.len; i++) {
-        if (ice_arr_matches(arr, arr.arr[i]) == 1) {
-            len++;
+    pipe->stages[pipe->len++] = stage;
+    return ICE_ARR_TRUE;
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_pipe_filter(ice_arr_pipe* pipe, ice_arr_pred_func f, void* ctx) {
+    ice_arr_stage stage = { ICE_ARR_STAGE_FILTER, f, NULL, ctx, 0, 0 };
+    return ice_arr_pipe_add(pipe, stage);
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_pipe_map(ice_arr_pipe* pipe, ice_arr_map_func f, void* ctx) {
+    ice_arr_stage stage = { ICE_ARR_STAGE_MAP, NULL, f, ctx, 0, 0 };
+    return ice_arr_pipe_add(pipe, stage);
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_pipe_take(ice_arr_pipe* pipe, int n) {
+    ice_arr_stage stage = { ICE_ARR_STAGE_TAKE, NULL, NULL, NULL, 0, (n < 0) ? 0 : n };
+    return ice_arr_pipe_add(pipe, stage);
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_pipe_skip(ice_arr_pipe* pipe, int n) {
+    ice_arr_stage stage = { ICE_ARR_STAGE_SKIP, NULL, NULL, NULL, 0, (n < 0) ? 0 : n };
+    return ice_arr_pipe_add(pipe, stage);
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_pipe_dedupe(ice_arr_pipe* pipe) {
+    ice_arr_stage stage = { ICE_ARR_STAGE_DEDUPE, NULL, NULL, NULL, 0, 0 };
+    return ice_arr_pipe_add(pipe, stage);
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_pipe_without(ice_arr_pipe* pipe, double val) {
+    ice_arr_stage stage = { ICE_ARR_STAGE_WITHOUT, NULL, NULL, NULL, val, 0 };
+    return ice_arr_pipe_add(pipe, stage);
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_pipe_compact(ice_arr_pipe* pipe) {
+    return ice_arr_pipe_without(pipe, 0);
+}
+
+// State of one run of pipeline, Each take, skip and dedupe stage keeps its own counter or hash set
+typedef struct ice_arr_pipe_state {
+    const ice_arr_pipe* pipe;
+    ice_arr_array src;
+    int i;
+    int done;
+    int counts[ICE_ARR_PIPE_MAX_STAGES];
+    ice_arr_hashset sets[ICE_ARR_PIPE_MAX_STAGES];
+} ice_arr_pipe_state;
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_pipe_end(ice_arr_pipe_state* state) {
+    for (int s = 0; s < state->pipe->len; s++) {
+        if (state->pipe->stages[s].type == ICE_ARR_STAGE_DEDUPE) {
+            ice_arr_hashset_free(&state->sets[s]);
         }
     }
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_pipe_begin(ice_arr_pipe_state* state, const ice_arr_pipe* pipe) {
+    memset(state, 0, sizeof(*state));
+    state->pipe = pipe;
+    state->src = pipe->src;
     
-    ice_arr_array res = ice_arr_new(len);
+    if (pipe->ok == ICE_ARR_FALSE) {
+        return ICE_ARR_FALSE;
+    }
     
-    for (int i = 0; i < arr.len; i++) {
-        if (ice_arr_matches(arr, arr.arr[i]) == 1) {
-            res.arr[count] = arr.arr[i];
-            count++;
+    for (int s = 0; s < pipe->len; s++) {
+        state->counts[s] = pipe->stages[s].count;
+        
+        if (pipe->stages[s].type == ICE_ARR_STAGE_DEDUPE && ice_arr_hashset_init(&state->sets[s], pipe->src.len) == ICE_ARR_FALSE) {
+            ice_arr_pipe_end(state);
+            return ICE_ARR_FALSE;
         }
     }
     
-    return res;
+    return ICE_ARR_TRUE;
 }
 
-ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_last_index(ice_arr_array arr, double val) {
-    int occurence = 0;
+// Passes source elements through stages until one comes out of last stage, Returns ICE_ARR_FALSE when there are no more elements
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_pipe_next(ice_arr_pipe_state* state, double* out) {
+    const ice_arr_stage* stages = state->pipe->stages;
+    int len = state->pipe->len;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] == val) {
-            if (i >= occurence) {
-                occurence = i;
+    while (!state->done && state->i < state->src.len) {
+        double n = state->src.arr[state->i++];
+        int s;
+        
+        for (s = 0; s < len; s++) {
+            const ice_arr_stage* stage = stages + s;
+            
+            if (stage->type == ICE_ARR_STAGE_FILTER) {
+                if (stage->filter(n, stage->ctx) != ICE_ARR_TRUE) break;
+            } else if (stage->type == ICE_ARR_STAGE_MAP) {
+                n = stage->map(n, stage->ctx);
+            } else if (stage->type == ICE_ARR_STAGE_TAKE) {
+                // Nothing can pass this stage anymore, So rest of source array doesn't matter
+                if (state->counts[s] == 0) {
+                    state->done = 1;
+                    break;
+                }
+                
+                // Last element this stage lets through, Stop right after it instead of reading one more source element
+                if (--state->counts[s] == 0) {
+                    state->done = 1;
+                }
+            } else if (stage->type == ICE_ARR_STAGE_SKIP) {
+                if (state->counts[s] > 0) {
+                    state->counts[s]--;
+                    break;
+                }
+            } else if (stage->type == ICE_ARR_STAGE_DEDUPE) {
+                if (ice_arr_hashset_insert(&state->sets[s], ice_arr_hashset_key(n)) == ICE_ARR_FALSE) break;
+            } else if (stage->type == ICE_ARR_STAGE_WITHOUT) {
+                if (n == stage->val) break;
             }
         }
+        
+        if (s == len) {
+            *out = n;
+            return ICE_ARR_TRUE;
+        }
     }
     
-    return occurence;
+    return ICE_ARR_FALSE;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_unshift(ice_arr_array arr, double val) {
-    ice_arr_array res = ice_arr_new(arr.len + 1);
-    arr.arr[0] = val;
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_pipe_sum(const ice_arr_pipe* pipe) {
+    ice_arr_pipe_state state;
+    double res = 0, n;
+    
+    if (ice_arr_pipe_begin(&state, pipe) == ICE_ARR_FALSE) {
+        return 0;
+    }
     
-    for (int i = 0; i < arr.len; i++) {
-        res.arr[i + 1] = arr.arr[i];
+    while (ice_arr_pipe_next(&state, &n) == ICE_ARR_TRUE) {
+        res += n;
     }
     
+    ice_arr_pipe_end(&state);
     return res;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_diff(ice_arr_array a1, ice_arr_array a2) {
-    int len = 0;
-    int count = 0;
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_pipe_count(const ice_arr_pipe* pipe) {
+    ice_arr_pipe_state state;
+    double n;
+    int res = 0;
     
-    for (int i = 0; i < a1.len; i++) {
-        if (ice_arr_matches(a2, a1.arr[i]) == 1) {
-            len++;
-        }
+    if (ice_arr_pipe_begin(&state, pipe) == ICE_ARR_FALSE) {
+        return 0;
     }
     
-    ice_arr_array res = ice_arr_new(len);
-    
-    for (int i = 0; i < a1.len; i++) {
-        if (ice_arr_matches(a2, a1.arr[i]) == 1) {
-            res.arr[count] = a1.arr[i];
-            count++;
-        }
+    while (ice_arr_pipe_next(&state, &n) == ICE_ARR_TRUE) {
+        res++;
     }
     
+    ice_arr_pipe_end(&state);
     return res;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_range(int i) {
-    ice_arr_array res = ice_arr_new(i);
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_pipe_min(const ice_arr_pipe* pipe) {
+    ice_arr_pipe_state state;
+    double res = HUGE_VAL, n;
+    
+    if (ice_arr_pipe_begin(&state, pipe) == ICE_ARR_FALSE) {
+        return res;
+    }
     
-    for (int j = 0; j < i; j++) {
-        res.arr[j] = i;
+    while (ice_arr_pipe_next(&state, &n) == ICE_ARR_TRUE) {
+        if (n < res) res = n;
     }
     
+    ice_arr_pipe_end(&state);
     return res;
 }
 
-ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_min(ice_arr_array arr) {
-    double n  = (1 / 0);
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_pipe_max(const ice_arr_pipe* pipe) {
+    ice_arr_pipe_state state;
+    double res = -HUGE_VAL, n;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] < n) {
-            n = arr.arr[i];
-        }
+    if (ice_arr_pipe_begin(&state, pipe) == ICE_ARR_FALSE) {
+        return res;
     }
     
-    return n;
-}
-
-ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_max(ice_arr_array arr) {
-    double n  = -(1 / 0);
-    
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] > n) {
-            n = arr.arr[i];
-        }
+    while (ice_arr_pipe_next(&state, &n) == ICE_ARR_TRUE) {
+        if (n > res) res = n;
     }
     
-    return n;
+    ice_arr_pipe_end(&state);
+    return res;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_compact(ice_arr_array arr) {
-    int zeros = ice_arr_matches(arr, 0);
-    int count = 0;
-    ice_arr_array res = ice_arr_new(arr.len - zeros);
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_pipe_reduce(const ice_arr_pipe* pipe, ice_arr_reduce_func f, double init, void* ctx) {
+    ice_arr_pipe_state state;
+    double res = init, n;
     
-    for (int i = 0; i < arr.len; i++) {
-        if (arr.arr[i] != 0) {
-            res.arr[count] = arr.arr[i];
-            count++;
-        }
+    if (ice_arr_pipe_begin(&state, pipe) == ICE_ARR_FALSE) {
+        return init;
     }
     
+    while (ice_arr_pipe_next(&state, &n) == ICE_ARR_TRUE) {
+        res = f(res, n, ctx);
+    }
+    
+    ice_arr_pipe_end(&state);
     return res;
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_tail(ice_arr_array arr) {
-    ice_arr_array res = ice_arr_new(arr.len - 1);
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_pipe_foreach(const ice_arr_pipe* pipe, ice_arr_ctx_iter_func f, void* ctx) {
+    ice_arr_pipe_state state;
+    double n;
     
-    for (int i = 1; i < arr.len; i++) {
-        res.arr[i - 1] = arr.arr[i];
+    if (ice_arr_pipe_begin(&state, pipe) == ICE_ARR_FALSE) {
+        return;
     }
     
-    return res;
+    while (ice_arr_pipe_next(&state, &n) == ICE_ARR_TRUE) {
+        f(n, ctx);
+    }
+    
+    ice_arr_pipe_end(&state);
 }
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_intersect(ice_arr_array a1, ice_arr_array a2) {
-    int len = 0;
+// No stage adds elements, So each result element gets written at or before index of source element it came from (dst can be source array)
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_pipe_into(ice_arr_array* dst, const ice_arr_pipe* pipe) {
+    ice_arr_pipe_state state;
+    double n;
     int count = 0;
     
-    for (int i = 0; i < a1.len; i++) {
-        if (ice_arr_matches(a2, a1.arr[i]) >= 1 && ice_arr_matches(a1, a1.arr[i]) >= 1) {
-            len++;
-        }
+    if (ice_arr_pipe_begin(&state, pipe) == ICE_ARR_FALSE) {
+        return ICE_ARR_FALSE;
     }
     
-    ice_arr_array res = ice_arr_new(len);
+    if (ice_arr_into_reserve(dst, state.src.len, &state.src, NULL) == ICE_ARR_FALSE) {
+        ice_arr_pipe_end(&state);
+        return ICE_ARR_FALSE;
+    }
     
-    for (int i = 0; i < a1.len; i++) {
-        if (ice_arr_matches(a2, a1.arr[i]) >= 1) {
-            if (ice_arr_matches(a1, a1.arr[i])) {
-                res.arr[count] = a2.arr[i];
-                count++;
-            }
-        } else if (ice_arr_matches(a1, a1.arr[i]) >= 1) {
-            if (ice_arr_matches(a2, a1.arr[i])) {
-                res.arr[count] = a1.arr[i];
-                count++;
-            }
-        }
+    while (ice_arr_pipe_next(&state, &n) == ICE_ARR_TRUE) {
+        dst->arr[count++] = n;
     }
     
+    ice_arr_pipe_end(&state);
+    dst->len = count;
+    return ICE_ARR_TRUE;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_pipe_to_array(const ice_arr_pipe* pipe) {
+    ice_arr_array res = ice_arr_empty();
+    ice_arr_pipe_into(&res, pipe);
     return res;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_foreach(ice_arr_array arr, ice_arr_iter_func f) {
-    for (int i = 0; i < arr.len; i++) {
-        f(arr.arr[i]);
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arr PARALLEL
+///////////////////////////////////////////////////////////////////////////////////////////
+// Work gets split into tasks that run on a pool of worker threads (Created on first use), Calling thread runs tasks too.
+// If pool is already running a job (Ex. parallel call from callback or from other thread) work runs on calling thread instead.
+typedef void (*ice_arr_task_func)(void* data, int task);
+
+typedef struct ice_arr_job {
+    double* src;
+    double* dst;
+    int len;
+    int tasks;
+    int* bounds;                // Chunk boundaries, Used by sort
+    int step;                   // Merge width in chunks, Used by sort
+    ice_arr_ctx_iter_func iter;
+    ice_arr_map_func map;
+    ice_arr_reduce_func reduce;
+    double* results;            // Result of each task, Used by reduce
+    void* ctx;
+} ice_arr_job;
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_cpu_count(void) {
+#if defined(ICE_CPU_H)
+    int n = (int) ice_cpu_cores_count();
+#elif defined(ICE_ARR_MICROSOFT)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int n = (int) info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    int n = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    int n = 1;
+#endif
+    return (n > 0) ? n : 1;
+}
+
+#if defined(ICE_ARR_NO_THREADS)
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_threads_count(void) {
+    return 1;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_threads_free(void) {}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_threads_set(int count) {
+    (void) count;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_parallel_run(ice_arr_task_func f, void* data, int tasks) {
+    for (int i = 0; i < tasks; i++) {
+        f(data, i);
     }
 }
+#else
+#if defined(ICE_ARR_MICROSOFT)
+typedef CONDITION_VARIABLE ice_arr_cond;
+typedef HANDLE ice_arr_thread;
+static SRWLOCK ice_arr_pool_lock = SRWLOCK_INIT;
+static CONDITION_VARIABLE ice_arr_pool_wake = CONDITION_VARIABLE_INIT;
+static CONDITION_VARIABLE ice_arr_pool_done = CONDITION_VARIABLE_INIT;
+#  define ICE_ARR_POOL_LOCK() AcquireSRWLockExclusive(&ice_arr_pool_lock)
+#  define ICE_ARR_POOL_UNLOCK() ReleaseSRWLockExclusive(&ice_arr_pool_lock)
+#  define ICE_ARR_POOL_WAIT(c) SleepConditionVariableSRW((c), &ice_arr_pool_lock, INFINITE, 0)
+#  define ICE_ARR_POOL_WAKE_ALL(c) WakeAllConditionVariable(c)
+#else
+typedef pthread_cond_t ice_arr_cond;
+typedef pthread_t ice_arr_thread;
+static pthread_mutex_t ice_arr_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t ice_arr_pool_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t ice_arr_pool_done = PTHREAD_COND_INITIALIZER;
+#  define ICE_ARR_POOL_LOCK() pthread_mutex_lock(&ice_arr_pool_lock)
+#  define ICE_ARR_POOL_UNLOCK() pthread_mutex_unlock(&ice_arr_pool_lock)
+#  define ICE_ARR_POOL_WAIT(c) pthread_cond_wait((c), &ice_arr_pool_lock)
+#  define ICE_ARR_POOL_WAKE_ALL(c) pthread_cond_broadcast(c)
+#endif
 
-ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_union(ice_arr_array a1, ice_arr_array a2) {
-    int len = 0;
-    int count = 0;
-    
-    for (int i = 0; i < a1.len; i++) {
-        if (ice_arr_matches(a2, a1.arr[i]) >= 1 && ice_arr_matches(a1, a1.arr[i]) >= 1) {
-            len++;
+static int ice_arr_threads_wanted = 0;
+
+// All fields are guarded by ice_arr_pool_lock
+typedef struct ice_arr_pool {
+    int started;
+    int workers;                // Started worker threads
+    int quit;
+    unsigned int gen;           // Increased each time job is posted, So sleeping workers know there is new job
+    ice_arr_task_func func;     // Job being run, NULL if pool is free
+    void* data;
+    int tasks;
+    int next;                   // Next task to be taken
+    int pending;                // Tasks not finished yet
+    ice_arr_thread threads[ICE_ARR_MAX_THREADS];
+} ice_arr_pool;
+
+static ice_arr_pool ice_arr_pool_state;
+
+// Runs tasks of current job until none is left, Must be called with pool locked
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_pool_drain(void) {
+    ice_arr_pool* pool = &ice_arr_pool_state;
+    
+    while (pool->next < pool->tasks) {
+        ice_arr_task_func f = pool->func;
+        void* data = pool->data;
+        int task = pool->next++;
+        
+        ICE_ARR_POOL_UNLOCK();
+        f(data, task);
+        ICE_ARR_POOL_LOCK();
+        
+        if (--pool->pending == 0) {
+            ICE_ARR_POOL_WAKE_ALL(&ice_arr_pool_done);
         }
     }
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_pool_work(unsigned int seen) {
+    ice_arr_pool* pool = &ice_arr_pool_state;
     
-    ice_arr_array res = ice_arr_new(len);
+    ICE_ARR_POOL_LOCK();
     
-    for (int i = 0; i < a1.len; i++) {
-        if (!(ice_arr_includes(res, a1.arr[i]) == ICE_ARR_TRUE)) {
-            res.arr[count] = a1.arr[i];
-            count++;
+    for (;;) {
+        while (pool->gen == seen && !pool->quit) {
+            ICE_ARR_POOL_WAIT(&ice_arr_pool_wake);
         }
+        
+        if (pool->quit) break;
+        
+        seen = pool->gen;
+        ice_arr_pool_drain();
     }
     
-    for (int i = 0; i < a2.len; i++) {
-        if (!(ice_arr_includes(res, a2.arr[i]) == ICE_ARR_TRUE)) {
-            res.arr[count] = a2.arr[i];
-            count++;
-        }
+    ICE_ARR_POOL_UNLOCK();
+}
+
+#if defined(ICE_ARR_MICROSOFT)
+static DWORD WINAPI ice_arr_pool_worker(LPVOID seen) {
+    ice_arr_pool_work((unsigned int) (size_t) seen);
+    return 0;
+}
+#else
+static void* ice_arr_pool_worker(void* seen) {
+    ice_arr_pool_work((unsigned int) (size_t) seen);
+    return NULL;
+}
+#endif
+
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_threads_count(void) {
+    int n = (ice_arr_threads_wanted > 0) ? ice_arr_threads_wanted : ice_arr_cpu_count();
+    return (n > ICE_ARR_MAX_THREADS) ? ICE_ARR_MAX_THREADS : n;
+}
+
+// Must be called with pool locked and no job running
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_pool_start(void) {
+    ice_arr_pool* pool = &ice_arr_pool_state;
+    int count = ice_arr_threads_count() - 1;
+    
+    pool->started = 1;
+    pool->workers = 0;
+    
+    for (int i = 0; i < count; i++) {
+        void* seen = (void*) (size_t) pool->gen;
+        
+#if defined(ICE_ARR_MICROSOFT)
+        pool->threads[i] = CreateThread(NULL, 0, ice_arr_pool_worker, seen, 0, NULL);
+        if (pool->threads[i] == NULL) break;
+#else
+        if (pthread_create(&pool->threads[i], NULL, ice_arr_pool_worker, seen) != 0) break;
+#endif
+        
+        pool->workers++;
     }
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_threads_free(void) {
+    ice_arr_pool* pool = &ice_arr_pool_state;
     
-    return res;
+    ICE_ARR_POOL_LOCK();
+    int workers = pool->workers;
+    pool->quit = 1;
+    ICE_ARR_POOL_WAKE_ALL(&ice_arr_pool_wake);
+    ICE_ARR_POOL_UNLOCK();
+    
+    for (int i = 0; i < workers; i++) {
+#if defined(ICE_ARR_MICROSOFT)
+        WaitForSingleObject(pool->threads[i], INFINITE);
+        CloseHandle(pool->threads[i]);
+#else
+        pthread_join(pool->threads[i], NULL);
+#endif
+    }
+    
+    ICE_ARR_POOL_LOCK();
+    pool->started = 0;
+    pool->workers = 0;
+    pool->quit = 0;
+    ICE_ARR_POOL_UNLOCK();
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_rotate(ice_arr_array* arr, int times) {
-    for (int i = 0; i < times; i++) {
-        int i, temp;
-        temp = arr->arr[0];
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_threads_set(int count) {
+    ice_arr_threads_free();
+    ice_arr_threads_wanted = (count > 0) ? count : 0;
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_parallel_run(ice_arr_task_func f, void* data, int tasks) {
+    ice_arr_pool* pool = &ice_arr_pool_state;
+    
+    ICE_ARR_POOL_LOCK();
+    
+    if (tasks > 1 && pool->func == NULL && !pool->quit && !pool->started) {
+        ice_arr_pool_start();
+    }
+    
+    if (tasks <= 1 || pool->func != NULL || pool->quit || pool->workers <= 0) {
+        ICE_ARR_POOL_UNLOCK();
         
-        for (i = 0; i < arr->len - 1; i++)  {
-            arr->arr[i] = arr->arr[i + 1];
+        for (int i = 0; i < tasks; i++) {
+            f(data, i);
         }
-        arr->arr[i] = temp;
+        
+        return;
     }
+    
+    pool->func = f;
+    pool->data = data;
+    pool->tasks = tasks;
+    pool->next = 0;
+    pool->pending = tasks;
+    pool->gen++;
+    ICE_ARR_POOL_WAKE_ALL(&ice_arr_pool_wake);
+    
+    ice_arr_pool_drain();
+    
+    while (pool->pending > 0) {
+        ICE_ARR_POOL_WAIT(&ice_arr_pool_done);
+    }
+    
+    pool->func = NULL;
+    ICE_ARR_POOL_UNLOCK();
 }
+#endif
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_move(ice_arr_array* a1, int from_index, int elems_count, int to_index, ice_arr_array* a2) {
-    if (a1->len + elems_count - 1 >= a1->real_len) {
-        ICE_ARR_REALLOC(a1->arr, (a1->real_len + ((a1->len + elems_count - 1) - a1->real_len / 2)));
+// Count of tasks to split n elements into, Each task gets at least ICE_ARR_PARALLEL_GRAIN elements
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_parallel_tasks(int n) {
+    int tasks = n / ICE_ARR_PARALLEL_GRAIN;
+    int threads = ice_arr_threads_count();
+    
+    if (tasks > threads) tasks = threads;
+    return (tasks < 1) ? 1 : tasks;
+}
+
+// First element of chunk, Chunk i is [ice_arr_chunk(n, tasks, i), ice_arr_chunk(n, tasks, i + 1))
+ICE_ARR_API int ICE_ARR_CALLCONV ice_arr_chunk(int n, int tasks, int i) {
+    return (int) (((long long) n * i) / tasks);
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_foreach_task(void* data, int task) {
+    ice_arr_job* job = (ice_arr_job*) data;
+    int end = ice_arr_chunk(job->len, job->tasks, task + 1);
+    
+    for (int i = ice_arr_chunk(job->len, job->tasks, task); i < end; i++) {
+        job->iter(job->src[i], job->ctx);
     }
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_map_task(void* data, int task) {
+    ice_arr_job* job = (ice_arr_job*) data;
+    int end = ice_arr_chunk(job->len, job->tasks, task + 1);
     
-    if (a2->len + elems_count - 1 >= a2->real_len) {
-        ICE_ARR_REALLOC(a2->arr, (a2->real_len + ((a2->len + elems_count - 1) - a2->real_len / 2)));
+    for (int i = ice_arr_chunk(job->len, job->tasks, task); i < end; i++) {
+        job->dst[i] = job->map(job->src[i], job->ctx);
     }
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_reduce_task(void* data, int task) {
+    ice_arr_job* job = (ice_arr_job*) data;
+    int start = ice_arr_chunk(job->len, job->tasks, task);
+    int end = ice_arr_chunk(job->len, job->tasks, task + 1);
+    double acc = job->src[start];
     
-    for (int i = 0; i < (elems_count - 1); i++) {
-        a2->arr[to_index + i] = a1->arr[from_index + i];
+    for (int i = start + 1; i < end; i++) {
+        acc = job->reduce(acc, job->src[i], job->ctx);
     }
+    
+    job->results[task] = acc;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_sort(ice_arr_array* arr) {
-    int i, j, swapped;
-    double temp;
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_parallel_foreach(ice_arr_array arr, ice_arr_ctx_iter_func f, void* ctx) {
+    ice_arr_job job = { 0 };
     
-    for (i = 0; i < arr->len; ++i) {
-        for (j = i + 1; j < arr->len; ++j) {
-            if (arr->arr[i] < arr->arr[j]) {
-                temp = arr->arr[i];
-                arr->arr[i] = arr->arr[j];
-                arr->arr[j] = temp;
-            }
-        }
+    job.src = arr.arr;
+    job.len = arr.len;
+    job.tasks = ice_arr_parallel_tasks(arr.len);
+    job.iter = f;
+    job.ctx = ctx;
+    
+    ice_arr_parallel_run(ice_arr_foreach_task, &job, job.tasks);
+}
+
+ICE_ARR_API ice_arr_bool ICE_ARR_CALLCONV ice_arr_map_into(ice_arr_array* dst, ice_arr_array arr, ice_arr_map_func f, void* ctx) {
+    ice_arr_job job = { 0 };
+    
+    if (ice_arr_into_reserve(dst, arr.len, &arr, NULL) == ICE_ARR_FALSE) {
+        return ICE_ARR_FALSE;
     }
+    
+    job.src = arr.arr;
+    job.dst = dst->arr;
+    job.len = arr.len;
+    job.tasks = ice_arr_parallel_tasks(arr.len);
+    job.map = f;
+    job.ctx = ctx;
+    
+    ice_arr_parallel_run(ice_arr_map_task, &job, job.tasks);
+    dst->len = arr.len;
+    return ICE_ARR_TRUE;
+}
+
+ICE_ARR_API ice_arr_array ICE_ARR_CALLCONV ice_arr_map(ice_arr_array arr, ice_arr_map_func f, void* ctx) {
+    ice_arr_array res = ice_arr_empty();
+    ice_arr_map_into(&res, arr, f, ctx);
+    return res;
 }
 
-ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_sort_ex(ice_arr_array* arr, ice_arr_res_func f) {
-    int i, j, swapped;
-    double temp;
+ICE_ARR_API double ICE_ARR_CALLCONV ice_arr_reduce(ice_arr_array arr, ice_arr_reduce_func f, double init, void* ctx) {
+    double results[ICE_ARR_MAX_THREADS];
+    ice_arr_job job = { 0 };
+    double acc = init;
     
-    for (i = 0; i < arr->len; ++i) {
-        for (j = i + 1; j < arr->len; ++j) {
-            if ((int) f(arr->arr[i], arr->arr[j]) == 1) {
-                temp = arr->arr[i];
-                arr->arr[i] = arr->arr[j];
-                arr->arr[j] = temp;
-            }
-        }
+    if (arr.len == 0) {
+        return init;
     }
+    
+    job.src = arr.arr;
+    job.len = arr.len;
+    job.tasks = ice_arr_parallel_tasks(arr.len);
+    job.reduce = f;
+    job.results = results;
+    job.ctx = ctx;
+    
+    ice_arr_parallel_run(ice_arr_reduce_task, &job, job.tasks);
+    
+    // Tasks results get combined in order, So f only needs to be associative (Not commutative)
+    for (int i = 0; i < job.tasks; i++) {
+        acc = f(acc, results[i], ctx);
+    }
+    
+    return acc;
 }
 
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_sort_task(void* data, int task) {
+    ice_arr_job* job = (ice_arr_job*) data;
+    ice_arr_array chunk = { job->src + job->bounds[task], job->bounds[task + 1] - job->bounds[task], 0, 0 };
+    
+    ice_arr_sort(&chunk);
+}
+
+// Merges chunk pair (task * 2 * step) and (task * 2 * step + step) from src to dst, Taking from left one on ties keeps merge stable
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_merge_task(void* data, int task) {
+    ice_arr_job* job = (ice_arr_job*) data;
+    int first = task * 2 * job->step;
+    int mid_chunk = first + job->step;
+    int last_chunk = first + 2 * job->step;
+    int i = job->bounds[first];
+    int mid = job->bounds[(mid_chunk < job->tasks) ? mid_chunk : job->tasks];
+    int end = job->bounds[(last_chunk < job->tasks) ? last_chunk : job->tasks];
+    int j = mid, k = i;
+    
+    while (i < mid && j < end) {
+        job->dst[k++] = (ice_arr_sort_key(job->src[j]) < ice_arr_sort_key(job->src[i])) ? job->src[j++] : job->src[i++];
+    }
+    
+    memcpy(job->dst + k, job->src + i, (mid - i) * sizeof(double));
+    k += mid - i;
+    memcpy(job->dst + k, job->src + j, (end - j) * sizeof(double));
+}
+
+ICE_ARR_API void ICE_ARR_CALLCONV ice_arr_parallel_sort(ice_arr_array* arr) {
+    int bounds[ICE_ARR_MAX_THREADS + 1];
+    ice_arr_job job = { 0 };
+    
+    job.len = arr->len;
+    job.tasks = ice_arr_parallel_tasks(arr->len);
+    
+    if (job.tasks <= 1) {
+        ice_arr_sort(arr);
+        return;
+    }
+    
+    double* tmp = (double*) ICE_ARR_MALLOC(arr->len * sizeof(double));
+    
+    if (tmp == NULL) {
+        ice_arr_sort(arr);
+        return;
+    }
+    
+    for (int i = 0; i <= job.tasks; i++) {
+        bounds[i] = ice_arr_chunk(arr->len, job.tasks, i);
+    }
+    
+    job.src = arr->arr;
+    job.dst = tmp;
+    job.bounds = bounds;
+    
+    // Each chunk gets sorted (Radix sort) by its own thread, Then sorted chunks get merged by pairs
+    ice_arr_parallel_run(ice_arr_sort_task, &job, job.tasks);
+    
+    for (job.step = 1; job.step < job.tasks; job.step *= 2) {
+        ice_arr_parallel_run(ice_arr_merge_task, &job, (job.tasks + 2 * job.step - 1) / (2 * job.step));
+        
+        double* t = job.src;
+        job.src = job.dst;
+        job.dst = t;
+    }
+    
+    if (job.src != arr->arr) {
+        memcpy(arr->arr, job.src, arr->len * sizeof(double));
+    }
+    
+    ICE_ARR_FREE(tmp);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_arr TYPED ARRAYS
+///////////////////////////////////////////////////////////////////////////////////////////
+// Expands ICE_ARR_ARRAY_IMPL for typed array, With plain loops as element type specific part
+// ACC: Type that name##_sum adds elements in, Other arguments are same as ICE_ARR_ARRAY_IMPL ones
+// LO/HI: Smallest and biggest value of T (Infinities for floats), name##_max/name##_min start from them so NaNs are skipped and empty array gives them back
+#define ICE_ARR_TYPED_IMPL(name, T, ACC, KT, KEY, UNKEY, HKEY, LO, HI)                              \
+ICE_ARR_API ACC ICE_ARR_CALLCONV name##_sum(name arr) {                                             \
+    ACC s0 = 0, s1 = 0, s2 = 0, s3 = 0;                                                             \
+    int i = 0;                                                                                      \
+                                                                                                    \
+    for (; i + 4 <= arr.len; i += 4) {                                                              \
+        s0 += arr.arr[i];                                                                           \
+        s1 += arr.arr[i + 1];                                                                       \
+        s2 += arr.arr[i + 2];                                                                       \
+        s3 += arr.arr[i + 3];                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    for (; i < arr.len; i++) {                                                                      \
+        s0 += arr.arr[i];                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    return (s0 + s1) + (s2 + s3);                                                                   \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API T ICE_ARR_CALLCONV name##_min(name arr) {                                               \
+    T res = (T) (HI);                                                                               \
+                                                                                                    \
+    for (int i = 0; i < arr.len; i++) {                                                             \
+        res = (arr.arr[i] < res) ? arr.arr[i] : res;                                                \
+    }                                                                                               \
+                                                                                                    \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API T ICE_ARR_CALLCONV name##_max(name arr) {                                               \
+    T res = (T) (LO);                                                                               \
+                                                                                                    \
+    for (int i = 0; i < arr.len; i++) {                                                             \
+        res = (arr.arr[i] > res) ? arr.arr[i] : res;                                                \
+    }                                                                                               \
+                                                                                                    \
+    return res;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API int ICE_ARR_CALLCONV name##_find(name arr, T val) {                                     \
+    for (int i = 0; i < arr.len; i++) {                                                             \
+        if (arr.arr[i] == val) {                                                                    \
+            return i;                                                                               \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    return -1;                                                                                      \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_API int ICE_ARR_CALLCONV name##_matches(name arr, T val) {                                  \
+    int count = 0;                                                                                  \
+                                                                                                    \
+    for (int i = 0; i < arr.len; i++) {                                                             \
+        count += (arr.arr[i] == val);                                                               \
+    }                                                                                               \
+                                                                                                    \
+    return count;                                                                                   \
+}                                                                                                   \
+                                                                                                    \
+ICE_ARR_ARRAY_IMPL(name, name, name##_view, name##_iter_func, name##_res_func, T, KT, KEY, UNKEY, HKEY)
+
+#if !defined(ICE_ARR_NO_TYPED)
+// Flips sign bit of positive floats and all bits of negative ones, Same as ice_arr_sort_key but for 32-bit floats
+ICE_ARR_API unsigned int ICE_ARR_CALLCONV ice_arr_f32_key(float f) {
+    unsigned int k;
+    memcpy(&k, &f, sizeof(k));
+    return (k & 0x80000000u) ? ~k : (k | 0x80000000u);
+}
+
+ICE_ARR_API float ICE_ARR_CALLCONV ice_arr_f32_unkey(unsigned int k) {
+    float f;
+    k = (k & 0x80000000u) ? (k & 0x7FFFFFFFu) : ~k;
+    memcpy(&f, &k, sizeof(f));
+    return f;
+}
+
+#define ICE_ARR_F32_HKEY(x) ice_arr_hashset_key((double) (x))
+#define ICE_ARR_I32_KEY(x) ((unsigned int) (x) ^ 0x80000000u)
+#define ICE_ARR_I32_UNKEY(k) ((int) ((k) ^ 0x80000000u))
+#define ICE_ARR_I64_KEY(x) ((unsigned long long) (x) ^ 0x8000000000000000ULL)
+#define ICE_ARR_I64_UNKEY(k) ((long long) ((k) ^ 0x8000000000000000ULL))
+#define ICE_ARR_INT_HKEY(x) ((unsigned long long) (long long) (x))
+#define ICE_ARR_U8_KEY(x) (x)
+
+ICE_ARR_TYPED_IMPL(ice_arr_f32, float, double, unsigned int, ice_arr_f32_key, ice_arr_f32_unkey, ICE_ARR_F32_HKEY, -HUGE_VAL, HUGE_VAL)
+ICE_ARR_TYPED_IMPL(ice_arr_i32, int, long long, unsigned int, ICE_ARR_I32_KEY, ICE_ARR_I32_UNKEY, ICE_ARR_INT_HKEY, INT_MIN, INT_MAX)
+ICE_ARR_TYPED_IMPL(ice_arr_i64, long long, long long, unsigned long long, ICE_ARR_I64_KEY, ICE_ARR_I64_UNKEY, ICE_ARR_INT_HKEY, LLONG_MIN, LLONG_MAX)
+ICE_ARR_TYPED_IMPL(ice_arr_u8, unsigned char, unsigned long long, unsigned char, ICE_ARR_U8_KEY, ICE_ARR_U8_KEY, ICE_ARR_INT_HKEY, 0, UCHAR_MAX)
+#endif
+
 #endif  // ICE_ARR_IMPL
 #endif  // ICE_ARR_H
@@ -199,6 +199,35 @@ THE SOFTWARE.
 #  define ICE_FS_FREE(ptr) free(ptr)
 #endif
 
+// SIMD newline search used by line functions (Define ICE_FS_NO_SIMD to use memchr instead)
+#if !defined(ICE_FS_NO_SIMD)
+#  if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ICE_FS_SSE2
+#  elif defined(__aarch64__) || defined(_M_ARM64)
+#    define ICE_FS_NEON
+#  endif
+#endif
+
+// Size of write buffer ice_fs_line_edits_apply streams new file through
+#ifndef ICE_FS_EDIT_BUFFER
+#  define ICE_FS_EDIT_BUFFER 1048576
+#endif
+
+// Size of buffer directory entries are read into at once by walker (Linux getdents64)
+#ifndef ICE_FS_WALK_BUFFER
+#  define ICE_FS_WALK_BUFFER 65536
+#endif
+
+// Size of buffer ice_fs_copy_file copies through when system can't copy files by itself
+#ifndef ICE_FS_COPY_BUFFER
+#  define ICE_FS_COPY_BUFFER 1048576
+#endif
+
+// Count of threads ice_fs_copy_dir copies files on while calling thread walks source tree
+#ifndef ICE_FS_COPY_THREADS
+#  define ICE_FS_COPY_THREADS 4
+#endif
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -211,6 +240,98 @@ typedef enum {
     ICE_FS_FALSE   = -1,
 } ice_fs_bool;
 
+typedef enum {
+    ICE_FS_MAP_READ         = 0,    // Read-only view, Writing to it crashes
+    ICE_FS_MAP_COPY         = 1,    // Copy-on-write view, Writes stay in memory of process and never reach file
+    ICE_FS_MAP_HUGE_PAGES   = 2,    // Combine with one of above to ask for huge pages (Ignored where system can't back files with them)
+} ice_fs_map_mode;
+
+typedef enum {
+    ICE_FS_MAP_NORMAL       = 0,    // Default read-ahead
+    ICE_FS_MAP_SEQUENTIAL   = 1,    // View will be read from start to end, So read ahead aggressively and drop pages after use
+    ICE_FS_MAP_RANDOM       = 2,    // View will be read in random order, So don't read ahead
+    ICE_FS_MAP_WILLNEED     = 3,    // Start reading whole view into memory now
+    ICE_FS_MAP_DONTNEED     = 4,    // View won't be needed soon, So its pages could be dropped
+} ice_fs_map_advice;
+
+// Memory-mapped file, Bytes are loaded by system when they are first touched instead of copied to heap
+typedef struct ice_fs_map_view {
+    void* data;                     // Mapped bytes (NULL if file is empty)
+    unsigned long long size;        // Size of file in bytes
+    ice_fs_map_mode mode;
+} ice_fs_map_view;
+
+// Line of text (Without line ending), Points into text it came from so it isn't NUL-terminated
+typedef struct ice_fs_line_view {
+    char* ptr;
+    unsigned long long len;
+} ice_fs_line_view;
+
+// Start offset of every line, Built in one pass so getting any line or range of lines is O(1)
+typedef struct ice_fs_line_index {
+    char* data;                     // Text lines point into
+    unsigned long long size;        // Size of text in bytes
+    int count;                      // Count of lines (Text after last newline counts as line)
+    int wide;                       // 1 if offsets are unsigned long long (Text bigger than 4 GB), Else they are unsigned int
+    void* offsets;                  // count + 1 offsets, Last one is size of text
+    ice_fs_map_view view;           // Mapping owned by index (Only if opened with ice_fs_line_index_open)
+} ice_fs_line_index;
+
+typedef enum {
+    ICE_FS_EDIT_INSERT      = 0,    // Insert line before line (Line index equal to count of lines appends)
+    ICE_FS_EDIT_REPLACE     = 1,    // Replace content of line (Line ending is kept)
+    ICE_FS_EDIT_REMOVE      = 2,    // Remove line with its line ending
+} ice_fs_edit_kind;
+
+typedef struct ice_fs_line_edit {
+    ice_fs_edit_kind kind;
+    int line;                       // Index of line in file before edits (Starts from 0)
+    int order;                      // Order edit was added in
+    char* content;                  // Copy of new content (NULL for ICE_FS_EDIT_REMOVE)
+} ice_fs_line_edit;
+
+// Batch of line edits, Applied to file in one pass no matter how many edits it has
+typedef struct ice_fs_line_edits {
+    ice_fs_line_edit* edits;
+    int count;
+    int cap;
+} ice_fs_line_edits;
+
+typedef enum {
+    ICE_FS_ENTRY_FILE       = 0,
+    ICE_FS_ENTRY_DIR        = 1,
+    ICE_FS_ENTRY_LINK       = 2,    // Symbolic link or junction (Never walked into)
+    ICE_FS_ENTRY_OTHER      = 3,    // Device, Pipe, Socket...
+} ice_fs_entry_type;
+
+typedef struct ice_fs_walk_options {
+    int max_depth;                  // Deepest level entries are returned from (0 is entries of root directory only), -1 for no limit
+    char* pattern;                  // Globs names of files must match separated by ';' (Like "*.png;*.jpg"), NULL matches all files
+    int dirs;                       // 1 to return directories too (They are walked into either way)
+} ice_fs_walk_options;
+
+typedef struct ice_fs_walk_entry {
+    char* path;                     // Path of entry (Root directory joined with names, Valid until next entry)
+    char* name;                     // Name of entry (Points into path)
+    int depth;                      // 0 for entries of root directory
+    ice_fs_entry_type type;
+} ice_fs_walk_entry;
+
+// Streaming depth-first walker, Holds one open directory per level instead of whole tree
+typedef struct ice_fs_walker {
+    ice_fs_walk_options opts;
+    char* path;                     // Path of last entry
+    int path_len;
+    int path_cap;
+    void* frames;                   // Open directories from root to current one
+    int depth;                      // Count of open directories
+    int frames_cap;
+    int descend;                    // 1 if last entry is directory to walk into before next entry
+} ice_fs_walker;
+
+// Called by ice_fs_walk_parallel for each entry (From many threads at once, Entry is valid only during call)
+typedef void (*ice_fs_walk_fn)(ice_fs_walk_entry* entry, void* user);
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 // ice_fs FUNCTIONS
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -251,6 +372,29 @@ ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_remove_line(char* fname, int l)
 ICE_FS_API  char**       ICE_FS_CALLCONV  ice_fs_lines(char* fname);
 ICE_FS_API  int          ICE_FS_CALLCONV  ice_fs_lines_count(char* fname);
 ICE_FS_API  char*        ICE_FS_CALLCONV  ice_fs_file_content(char* fname);
+ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_map(char* fname, ice_fs_map_mode mode, ice_fs_map_view* res);
+ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_map_advise(ice_fs_map_view* view, ice_fs_map_advice advice);
+ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_unmap(ice_fs_map_view* view);
+ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_line_index_open(char* fname, ice_fs_line_index* res);
+ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_line_index_from(char* data, unsigned long long size, ice_fs_line_index* res);
+ICE_FS_API  int          ICE_FS_CALLCONV  ice_fs_line_index_count(const ice_fs_line_index* index);
+ICE_FS_API  unsigned long long ICE_FS_CALLCONV ice_fs_line_index_offset(const ice_fs_line_index* index, int l);
+ICE_FS_API  ice_fs_line_view ICE_FS_CALLCONV ice_fs_line_index_get(const ice_fs_line_index* index, int l);
+ICE_FS_API  ice_fs_line_view ICE_FS_CALLCONV ice_fs_line_index_range(const ice_fs_line_index* index, int from, int to);
+ICE_FS_API  void         ICE_FS_CALLCONV  ice_fs_line_index_free(ice_fs_line_index* index);
+ICE_FS_API  ice_fs_line_edits ICE_FS_CALLCONV ice_fs_line_edits_new(void);
+ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_line_edits_insert(ice_fs_line_edits* edits, int l, char* content);
+ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_line_edits_replace(ice_fs_line_edits* edits, int l, char* content);
+ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_line_edits_remove(ice_fs_line_edits* edits, int l);
+ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_line_edits_apply(ice_fs_line_edits* edits, char* fname);
+ICE_FS_API  void         ICE_FS_CALLCONV  ice_fs_line_edits_free(ice_fs_line_edits* edits);
+ICE_FS_API  ice_fs_walk_options ICE_FS_CALLCONV ice_fs_walk_options_default(void);
+ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_walk_open(char* dir, const ice_fs_walk_options* opts, ice_fs_walker* res);
+ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_walk_next(ice_fs_walker* walker, ice_fs_walk_entry* entry);
+ICE_FS_API  void         ICE_FS_CALLCONV  ice_fs_walk_skip(ice_fs_walker* walker);
+ICE_FS_API  void         ICE_FS_CALLCONV  ice_fs_walk_close(ice_fs_walker* walker);
+ICE_FS_API  int          ICE_FS_CALLCONV  ice_fs_walk_parallel(char* dir, const ice_fs_walk_options* opts, int threads, ice_fs_walk_fn fn, void* user);
+ICE_FS_API  ice_fs_bool  ICE_FS_CALLCONV  ice_fs_glob_match(char* pattern, char* name);
 
 #if defined(__cplusplus)
 }
@@ -260,12 +404,26 @@ ICE_FS_API  char*        ICE_FS_CALLCONV  ice_fs_file_content(char* fname);
 // ice_fs IMPLEMENTATION
 ///////////////////////////////////////////////////////////////////////////////////////////
 #if defined(ICE_FS_IMPL)
+// Strict modes like -std=c99 or -D_POSIX_C_SOURCE=200809L hide madvise, DT_*, syscall, mkstemp, fdopen, fchmod...
+// So they are asked for before first system header (Only works if ice_fs.h is included before other system headers,
+// Else strict headers are already in and fallbacks below that check for MADV_*, DT_* and AT_SYMLINK_NOFOLLOW are used)
+#if !defined(ICE_FFI_MICROSOFT)
+#  if !defined(_DEFAULT_SOURCE)
+#    define _DEFAULT_SOURCE
+#  endif
+#  if defined(__APPLE__) && !defined(_DARWIN_C_SOURCE)
+#    define _DARWIN_C_SOURCE
+#  endif
+#endif
+
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
-#include <io.h>
 #include <limits.h>
+#include <errno.h>
 
 #if defined(ICE_FFI_MICROSOFT)
+#  include <io.h>
 #  include <windows.h>
 
 /*
@@ -1299,8 +1457,105 @@ static void dirent_set_errno(int error)
 #  include <dirent.h>
 #  include <sys/types.h>
 #  include <sys/stat.h>
+#  include <sys/mman.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  if defined(__linux__)
+#    include <sys/syscall.h>
+#    include <sys/ioctl.h>
+#    include <sys/sendfile.h>
+#  endif
+#endif
+
+// syscall is hidden by same strict modes as DT_*, So raw syscalls (getdents64, copy_file_range) are used only if both are there
+#if defined(__linux__) && defined(DT_DIR)
+#  define ICE_FS_LINUX_SYSCALL
+#endif
+
+#if !defined(ICE_FS_NO_THREADS) && !defined(ICE_FFI_MICROSOFT)
+#  include <pthread.h>
+#endif
+
+#if defined(ICE_FS_SSE2)
+#  include <emmintrin.h>
+#elif defined(ICE_FS_NEON)
+#  include <arm_neon.h>
 #endif
 
+#if defined(ICE_FS_SSE2) || defined(ICE_FS_NEON)
+// Index of lowest set bit (m must not be 0)
+ICE_FS_API int ICE_FS_CALLCONV ice_fs_ctz(unsigned long long m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i;
+#  if defined(_M_IX86)
+    if (_BitScanForward(&i, (unsigned long) m)) return (int) i;
+    _BitScanForward(&i, (unsigned long) (m >> 32));
+    return (int) i + 32;
+#  else
+    _BitScanForward64(&i, m);
+    return (int) i;
+#  endif
+#else
+    return __builtin_ctzll(m);
+#endif
+}
+#endif
+
+// Writes positions of up to max '\n' chars found from offset from to res, Returns count written (Less than max only
+// when end of data was reached, So callers continue from last position + 1 while it's max)
+ICE_FS_API int ICE_FS_CALLCONV ice_fs_find_newlines(const char* data, unsigned long long from, unsigned long long size, unsigned long long* res, int max) {
+    unsigned long long i = from;
+    int n = 0;
+
+#if defined(ICE_FS_SSE2)
+    const __m128i nl = _mm_set1_epi8('\n');
+    
+    for (; i + 16 <= size; i += 16) {
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (data + i)), nl));
+        
+        while (mask != 0) {
+            if (n == max) return n;
+            res[n++] = i + ice_fs_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    
+    for (; i < size && n < max; i++) {
+        if (data[i] == '\n') res[n++] = i;
+    }
+    
+#elif defined(ICE_FS_NEON)
+    const uint8x16_t nl = vdupq_n_u8('\n');
+    
+    // Narrowing shift packs 16 compare bytes into 64-bit mask with 4 bits per byte
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t eq = vceqq_u8(vld1q_u8((const uint8_t*) (data + i)), nl);
+        unsigned long long mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+        
+        while (mask != 0) {
+            if (n == max) return n;
+            int bit = ice_fs_ctz(mask);
+            res[n++] = i + (bit >> 2);
+            mask &= ~(0xFULL << (bit & ~3));
+        }
+    }
+    
+    for (; i < size && n < max; i++) {
+        if (data[i] == '\n') res[n++] = i;
+    }
+    
+#else
+    while (i < size && n < max) {
+        const char* p = (const char*) memchr(data + i, '\n', (size_t) (size - i));
+        if (p == NULL) break;
+        res[n++] = (unsigned long long) (p - data);
+        i = res[n - 1] + 1;
+    }
+#endif
+
+    return n;
+}
+
 ICE_FS_API char* ICE_FS_CALLCONV ice_fs_strfrom(char* str, int from, int to) {
     char* res = (char*) ICE_FS_MALLOC((to - from) * sizeof(char));
     int count = 0;
@@ -1326,6 +1581,7 @@ ICE_FS_API int ICE_FS_CALLCONV ice_fs_count_backslashes(char* str) {
 
 ICE_FS_API int ICE_FS_CALLCONV ice_fs_count_dots(char* str) {
     int count = 0;
+    size_t lenstr = strlen(str);
     
     for (int i = 0; i < lenstr; i++) {
         if (str[i] == '.') count++;
@@ -1434,20 +1690,6 @@ ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_remove_dir(char* dir) {
     return (rmdir(dir) < 0) ? ICE_FS_FALSE : ICE_FS_TRUE;
 }
 
-ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_copy_dir(char* d1, char* d2) {
-    char res[512];
-    
-#if defined(ICE_FFI_MICROSOFT)
-    sprintf(res, "xcopy %s %s\\%s /E /H /C /I\0", d1, d2, ice_fs_dir_name(d1));
-
-#else
-    sprintf(res, "cp %s %s\0", d1, d2);
-
-#endif
-
-    return (system(res) == 0) ? ICE_FS_TRUE : ICE_FS_FALSE;    
-}
-
 ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_remove_file(char* dir) {
     return (remove(dir) < 0) ? ICE_FS_FALSE : ICE_FS_TRUE;
 }
@@ -1456,18 +1698,6 @@ ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_rename_file(char* d1, char* d2) {
     return (rename(d1, d2) < 0) ? ICE_FS_FALSE : ICE_FS_TRUE;
 }
 
-ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_copy_file(char* d1, char* d2) {
-
-#if defined(ICE_FFI_MICROSOFT)
-    return (CopyFileA(d1, d2, TRUE)) ? ICE_FS_TRUE : ICE_FS_FALSE;
-    
-#else
-    return (system(d1, ice_fs_file_dir(d2)) == 0) ? ICE_FS_TRUE : ICE_FS_FALSE;
-
-#endif
-
-}
-
 ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_rename_dir(char* d1, char* d2) {
     return (rename(d1, d2) < 0) ? ICE_FS_FALSE : ICE_FS_TRUE;
 }
@@ -1610,21 +1840,65 @@ ICE_FS_API char** ICE_FS_CALLCONV ice_fs_split_dir(char* dir, char delim) {
     return res;
 }
 
+// Array and names are in single allocation, So whole result is freed with one ICE_FS_FREE
 ICE_FS_API char** ICE_FS_CALLCONV ice_fs_dir_list(char* dir) {
-    char* res[512];
-    DIR *d;
-    struct dirent *ent;
+    ice_fs_walk_options opts = ice_fs_walk_options_default();
+    ice_fs_walk_entry entry;
+    ice_fs_walker walker;
+    char* names = NULL;
+    size_t len = 0;
+    size_t cap = 0;
     int count = 0;
+    char** res;
     
-    if ((d = opendir(dir)) != NULL) {
-        while ((ent = readdir(d)) != NULL) {
-            res[count] = ent->d_name;
-            count++;
-        }
-        closedir(d);
-    } else {
+    opts.max_depth = 0;
+    opts.dirs = 1;
+    
+    if (ice_fs_walk_open(dir, &opts, &walker) == ICE_FS_FALSE) {
         return NULL;
     }
+    
+    // Names are packed one after another first, Array is built once count is known
+    while (ice_fs_walk_next(&walker, &entry) == ICE_FS_TRUE) {
+        size_t nlen = strlen(entry.name) + 1;
+        
+        if (len + nlen > cap) {
+            char* grown;
+            cap = (cap == 0) ? 1024 : cap * 2;
+            if (cap < len + nlen) cap = len + nlen;
+            grown = (char*) ICE_FS_REALLOC(names, cap);
+            
+            if (grown == NULL) {
+                ICE_FS_FREE(names);
+                ice_fs_walk_close(&walker);
+                return NULL;
+            }
+            
+            names = grown;
+        }
+        
+        memcpy(names + len, entry.name, nlen);
+        len += nlen;
+        count++;
+    }
+    
+    ice_fs_walk_close(&walker);
+    res = (char**) ICE_FS_MALLOC((count + 1) * sizeof(char*) + len);
+    
+    if (res != NULL) {
+        char* chars = (char*) (res + count + 1);
+        if (len > 0) memcpy(chars, names, len);
+        
+        for (int i = 0; i < count; i++) {
+            res[i] = chars;
+            chars += strlen(chars) + 1;
+        }
+        
+        res[count] = NULL;
+    }
+    
+    ICE_FS_FREE(names);
+    return res;
 }
 
 ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_dir_exists(char* dir) {
@@ -1798,90 +2072,1900 @@ ICE_FS_API char* ICE_FS_CALLCONV ice_fs_name_no_ext(char* fname) {
 }
 
 ICE_FS_API char* ICE_FS_CALLCONV ice_fs_get_line(char* fname, int l) {
-    int count = 0;
-    char line[1024];
+    unsigned long long nl[256];
+    unsigned long long start = 0;
+    unsigned long long end;
+    ice_fs_map_view view;
+    int seen = 0;
+    char* res;
+    
+    if (l < 0 || ice_fs_map(fname, ICE_FS_MAP_READ, &view) == ICE_FS_FALSE) {
+        return NULL;
+    }
     
-    while(fgets(line, sizeof(line), fopen(fname, "r")) != NULL) {
-        if (count == l) break;
-        count++;
+    const char* data = (const char*) view.data;
+    end = view.size;
+    
+    // Newline k ends line k, So scanning stops at newline l (start is always start of line seen)
+    for (;;) {
+        int n = ice_fs_find_newlines(data, start, view.size, nl, 256);
+        
+        if (seen + n > l) {
+            if (l > seen) start = nl[l - seen - 1] + 1;
+            end = nl[l - seen];
+            if (end > start && data[end - 1] == '\r') end--;
+            break;
+        }
+        
+        seen += n;
+        if (n > 0) start = nl[n - 1] + 1;
+        
+        // Line without newline after it exists only if it isn't empty
+        if (n < 256) {
+            if (seen < l || start >= view.size) {
+                ice_fs_unmap(&view);
+                return NULL;
+            }
+            
+            break;
+        }
     }
     
-    return line;
+    res = (char*) ICE_FS_MALLOC((size_t) (end - start) + 1);
+    
+    if (res != NULL) {
+        memcpy(res, data + start, (size_t) (end - start));
+        res[end - start] = '\0';
+    }
+    
+    ice_fs_unmap(&view);
+    return res;
 }
 
 ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_edit_line(char* fname, int l, char* content) {
-    ice_fs_remove_line(fname, l);
-    FILE* data = fopen(fname, "a");
-    for (int i = 0; i < l; i++) fprintf(data, "\0\n");
-    fprintf(data, "%s", content);
-    fclose(data);
+    ice_fs_line_edits edits = ice_fs_line_edits_new();
+    ice_fs_bool res = ice_fs_line_edits_replace(&edits, l, content);
+    
+    if (res == ICE_FS_TRUE) {
+        res = ice_fs_line_edits_apply(&edits, fname);
+    }
+    
+    ice_fs_line_edits_free(&edits);
+    return res;
 }
 
 ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_remove_line(char* fname, int l) {
-    unsigned int ctr = 0;
-    char str[512];
-    FILE* data = fopen(fname, "r");
-    FILE* temp_data = fopen("temp", "w");
-    while (!feof(data))
-    {
-        strcpy(str, "\0");
-        fgets(str, 256, data);
-        if (!feof(data)) {
-            ctr++;
-            if (ctr != l) fprintf(temp_data, str);
-        }
+    ice_fs_line_edits edits = ice_fs_line_edits_new();
+    ice_fs_bool res = ice_fs_line_edits_remove(&edits, l);
+    
+    if (res == ICE_FS_TRUE) {
+        res = ice_fs_line_edits_apply(&edits, fname);
     }
-    fclose(data);
-    fclose(temp_data);
-    remove(fname);
-    rename("temp", fname);
+    
+    ice_fs_line_edits_free(&edits);
+    return res;
 }
 
+// Array and copies of lines are in single allocation, So whole result is freed with one ICE_FS_FREE
 ICE_FS_API char** ICE_FS_CALLCONV ice_fs_lines(char* fname) {
-    int count = ice_fs_lines_count(fname);
-    size_t arrsize = 0;
+    ice_fs_line_index index;
+    char** lines;
+    char* chars;
     
-    for (int i = 0; i < count; i++) {
-        arrsize += strlen(ice_fs_get_line(fname, i));
+    if (ice_fs_line_index_open(fname, &index) == ICE_FS_FALSE) {
+        return NULL;
     }
     
-    char** lines = (char**) ICE_FS_MALLOC(arrsize * sizeof(char));
+    lines = (char**) ICE_FS_MALLOC((index.count + 1) * sizeof(char*) + (size_t) index.size + index.count);
     
-    for (int i = 0; i < count; i++) {
-        lines[i] = ice_fs_get_line(fname, i);
+    if (lines != NULL) {
+        chars = (char*) (lines + index.count + 1);
+        
+        for (int i = 0; i < index.count; i++) {
+            ice_fs_line_view line = ice_fs_line_index_get(&index, i);
+            lines[i] = chars;
+            memcpy(chars, line.ptr, (size_t) line.len);
+            chars[line.len] = '\0';
+            chars += line.len + 1;
+        }
+        
+        lines[index.count] = NULL;
     }
     
+    ice_fs_line_index_free(&index);
     return lines;
 }
 
 ICE_FS_API int ICE_FS_CALLCONV ice_fs_lines_count(char* fname) {
+    unsigned long long nl[256];
+    unsigned long long from = 0;
+    ice_fs_map_view view;
     int count = 0;
-    FILE* f = fopen(fname, "r");
-    char c;
     
-    if (f != NULL) {
-        do {
-            c = fgetc(f);
-            if (feof(f)) break;
-            if (c == '\n') count++;
-        } while (1);
-        fclose(f);
+    if (ice_fs_map(fname, ICE_FS_MAP_READ, &view) == ICE_FS_FALSE) {
+        return 0;
+    }
+    
+    ice_fs_map_advise(&view, ICE_FS_MAP_SEQUENTIAL);
+    
+    for (;;) {
+        int n = ice_fs_find_newlines((const char*) view.data, from, view.size, nl, 256);
+        count += n;
+        if (n > 0) from = nl[n - 1] + 1;
+        if (n < 256) break;
     }
     
+    // Text after last newline is line too
+    if (from < view.size) count++;
+    
+    ice_fs_unmap(&view);
     return count;
 }
 
 ICE_FS_API char* ICE_FS_CALLCONV ice_fs_file_content(char* fname) {
     FILE* f = fopen(fname, "rb");
+    
+    if (f == NULL) {
+        return NULL;
+    }
+    
     fseek(f, 0, SEEK_END);
     long fsize = ftell(f);
     fseek(f, 0, SEEK_SET);
     char *string = (char*) ICE_FS_MALLOC(fsize + 1);
-    fread(string, 1, fsize, f);
+    
+    if (string != NULL) {
+        fsize = (long) fread(string, 1, fsize, f);
+        string[fsize] = '\0';
+    }
+    
     fclose(f);
     
     return string;
 }
 
+// For big files use ice_fs_map instead of ice_fs_file_content, Pages are read on demand and shared with page cache
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_map(char* fname, ice_fs_map_mode mode, ice_fs_map_view* res) {
+    int copy = ((mode & ICE_FS_MAP_COPY) != 0);
+    
+    res->data = NULL;
+    res->size = 0;
+    res->mode = mode;
+
+#if defined(ICE_FFI_MICROSOFT)
+    LARGE_INTEGER size;
+    HANDLE f = CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    
+    if (f == INVALID_HANDLE_VALUE) {
+        return ICE_FS_FALSE;
+    }
+    
+    if (!GetFileSizeEx(f, &size) || (unsigned long long) size.QuadPart > (unsigned long long) ((SIZE_T) -1)) {
+        CloseHandle(f);
+        return ICE_FS_FALSE;
+    }
+    
+    // Mapping of empty file fails, So empty file is empty view
+    if (size.QuadPart == 0) {
+        CloseHandle(f);
+        return ICE_FS_TRUE;
+    }
+    
+    // Windows backs only pagefile mappings with large pages, So ICE_FS_MAP_HUGE_PAGES is ignored here
+    HANDLE m = CreateFileMappingA(f, NULL, copy ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+    
+    if (m == NULL) {
+        CloseHandle(f);
+        return ICE_FS_FALSE;
+    }
+    
+    // View keeps mapping alive, So both handles could be closed right away
+    res->data = MapViewOfFile(m, copy ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(m);
+    CloseHandle(f);
+    
+    if (res->data == NULL) {
+        return ICE_FS_FALSE;
+    }
+    
+    res->size = (unsigned long long) size.QuadPart;
+    return ICE_FS_TRUE;
+    
+#else
+    struct stat st;
+    int fd = open(fname, O_RDONLY);
+    
+    if (fd < 0) {
+        return ICE_FS_FALSE;
+    }
+    
+    if (fstat(fd, &st) < 0 || (unsigned long long) st.st_size > (unsigned long long) ((size_t) -1)) {
+        close(fd);
+        return ICE_FS_FALSE;
+    }
+    
+    if (st.st_size == 0) {
+        close(fd);
+        return ICE_FS_TRUE;
+    }
+    
+    // Mapping keeps file open, So descriptor could be closed right away
+    void* p = mmap(NULL, (size_t) st.st_size, copy ? (PROT_READ | PROT_WRITE) : PROT_READ, copy ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+    close(fd);
+    
+    if (p == MAP_FAILED) {
+        return ICE_FS_FALSE;
+    }
+    
+    // Transparent huge pages for file mappings are only hint on Linux (Needs kernel support for file THP)
+#if defined(MADV_HUGEPAGE)
+    if (mode & ICE_FS_MAP_HUGE_PAGES) {
+        madvise(p, (size_t) st.st_size, MADV_HUGEPAGE);
+    }
+#endif
+    
+    res->data = p;
+    res->size = (unsigned long long) st.st_size;
+    return ICE_FS_TRUE;
+#endif
+
+}
+
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_map_advise(ice_fs_map_view* view, ice_fs_map_advice advice) {
+    if (view->data == NULL) {
+        return ICE_FS_TRUE;
+    }
+
+#if defined(ICE_FFI_MICROSOFT)
+    // Only prefetch has equivalent for views (Windows 8 and later), Other hints have nothing to do
+    if (advice == ICE_FS_MAP_WILLNEED) {
+        typedef BOOL (WINAPI *ice_fs_prefetch_fn)(HANDLE, ULONG_PTR, void*, ULONG);
+        struct { void* addr; SIZE_T size; } range;
+        ice_fs_prefetch_fn prefetch = (ice_fs_prefetch_fn) GetProcAddress(GetModuleHandleA("kernel32.dll"), "PrefetchVirtualMemory");
+        
+        if (prefetch == NULL) {
+            return ICE_FS_FALSE;
+        }
+        
+        range.addr = view->data;
+        range.size = (SIZE_T) view->size;
+        return prefetch(GetCurrentProcess(), 1, &range, 0) ? ICE_FS_TRUE : ICE_FS_FALSE;
+    }
+    
+    return ICE_FS_TRUE;
+    
+#else
+    // MADV_DONTNEED on copy-on-write view would throw away changes, So pages are kept then
+    if (advice == ICE_FS_MAP_DONTNEED && (view->mode & ICE_FS_MAP_COPY)) {
+        return ICE_FS_TRUE;
+    }
+    
+#  if defined(MADV_NORMAL)
+    int adv = (advice == ICE_FS_MAP_SEQUENTIAL) ? MADV_SEQUENTIAL :
+              (advice == ICE_FS_MAP_RANDOM) ? MADV_RANDOM :
+              (advice == ICE_FS_MAP_WILLNEED) ? MADV_WILLNEED :
+              (advice == ICE_FS_MAP_DONTNEED) ? MADV_DONTNEED : MADV_NORMAL;
+    
+    return (madvise(view->data, (size_t) view->size, adv) < 0) ? ICE_FS_FALSE : ICE_FS_TRUE;
+#  elif defined(POSIX_MADV_NORMAL)
+    // Strict POSIX only has posix_madvise, It returns error number instead of setting errno
+    int adv = (advice == ICE_FS_MAP_SEQUENTIAL) ? POSIX_MADV_SEQUENTIAL :
+              (advice == ICE_FS_MAP_RANDOM) ? POSIX_MADV_RANDOM :
+              (advice == ICE_FS_MAP_WILLNEED) ? POSIX_MADV_WILLNEED :
+              (advice == ICE_FS_MAP_DONTNEED) ? POSIX_MADV_DONTNEED : POSIX_MADV_NORMAL;
+    
+    return (posix_madvise(view->data, (size_t) view->size, adv) != 0) ? ICE_FS_FALSE : ICE_FS_TRUE;
+#  else
+    // Hints are only hints, So view works same without them
+    return ICE_FS_TRUE;
+#  endif
+#endif
+
+}
+
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_unmap(ice_fs_map_view* view) {
+    ice_fs_bool res = ICE_FS_TRUE;
+    
+    if (view->data != NULL) {
+#if defined(ICE_FFI_MICROSOFT)
+        res = UnmapViewOfFile(view->data) ? ICE_FS_TRUE : ICE_FS_FALSE;
+#else
+        res = (munmap(view->data, (size_t) view->size) < 0) ? ICE_FS_FALSE : ICE_FS_TRUE;
+#endif
+    }
+    
+    view->data = NULL;
+    view->size = 0;
+    return res;
+}
+
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_line_index_push(ice_fs_line_index* index, unsigned long long* cap, unsigned long long offset) {
+    if ((unsigned long long) index->count + 1 >= *cap) {
+        void* offsets;
+        
+        if (index->count >= INT_MAX - 1) {
+            return ICE_FS_FALSE;
+        }
+        
+        *cap *= 2;
+        offsets = ICE_FS_REALLOC(index->offsets, (size_t) (*cap * (index->wide ? sizeof(unsigned long long) : sizeof(unsigned int))));
+        
+        if (offsets == NULL) {
+            return ICE_FS_FALSE;
+        }
+        
+        index->offsets = offsets;
+    }
+    
+    index->count++;
+    
+    if (index->wide) ((unsigned long long*) index->offsets)[index->count] = offset;
+    else ((unsigned int*) index->offsets)[index->count] = (unsigned int) offset;
+    
+    return ICE_FS_TRUE;
+}
+
+// Offsets take 4 bytes per line unless text is bigger than 4 GB, Capacity starts at guess of 1 line per 32 bytes
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_line_index_from(char* data, unsigned long long size, ice_fs_line_index* res) {
+    unsigned long long nl[256];
+    unsigned long long from = 0;
+    unsigned long long cap = size / 32 + 16;
+    
+    res->data = data;
+    res->size = size;
+    res->count = 0;
+    res->wide = (size > 0xFFFFFFFFULL);
+    res->view.data = NULL;
+    res->view.size = 0;
+    res->view.mode = ICE_FS_MAP_READ;
+    res->offsets = ICE_FS_MALLOC((size_t) (cap * (res->wide ? sizeof(unsigned long long) : sizeof(unsigned int))));
+    
+    if (res->offsets == NULL) {
+        return ICE_FS_FALSE;
+    }
+    
+    if (res->wide) ((unsigned long long*) res->offsets)[0] = 0;
+    else ((unsigned int*) res->offsets)[0] = 0;
+    
+    // Each newline starts next line (count is used as index of last offset while pushing)
+    for (;;) {
+        int n = ice_fs_find_newlines(data, from, size, nl, 256);
+        
+        for (int i = 0; i < n; i++) {
+            if (ice_fs_line_index_push(res, &cap, nl[i] + 1) == ICE_FS_FALSE) {
+                ICE_FS_FREE(res->offsets);
+                res->offsets = NULL;
+                return ICE_FS_FALSE;
+            }
+        }
+        
+        if (n > 0) from = nl[n - 1] + 1;
+        if (n < 256) break;
+    }
+    
+    // Last offset is end of text, Text after last newline is line too
+    if (from < size && ice_fs_line_index_push(res, &cap, size) == ICE_FS_FALSE) {
+        ICE_FS_FREE(res->offsets);
+        res->offsets = NULL;
+        return ICE_FS_FALSE;
+    }
+    
+    return ICE_FS_TRUE;
+}
+
+// *res is zeroed even on failure, So it is safe to pass to ice_fs_line_index_free either way
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_line_index_open(char* fname, ice_fs_line_index* res) {
+    ice_fs_map_view view;
+    
+    memset(res, 0, sizeof(ice_fs_line_index));
+    
+    if (ice_fs_map(fname, ICE_FS_MAP_READ, &view) == ICE_FS_FALSE) {
+        return ICE_FS_FALSE;
+    }
+    
+    ice_fs_map_advise(&view, ICE_FS_MAP_SEQUENTIAL);
+    
+    if (ice_fs_line_index_from((char*) view.data, view.size, res) == ICE_FS_FALSE) {
+        ice_fs_unmap(&view);
+        memset(res, 0, sizeof(ice_fs_line_index));
+        return ICE_FS_FALSE;
+    }
+    
+    // Lines are read in any order after index is built
+    ice_fs_map_advise(&view, ICE_FS_MAP_NORMAL);
+    res->view = view;
+    return ICE_FS_TRUE;
+}
+
+ICE_FS_API int ICE_FS_CALLCONV ice_fs_line_index_count(const ice_fs_line_index* index) {
+    return index->count;
+}
+
+// Returns offset where line starts (Size of text if l is count of lines)
+ICE_FS_API unsigned long long ICE_FS_CALLCONV ice_fs_line_index_offset(const ice_fs_line_index* index, int l) {
+    if (l < 0) l = 0;
+    if (l > index->count) l = index->count;
+    return index->wide ? ((unsigned long long*) index->offsets)[l] : ((unsigned int*) index->offsets)[l];
+}
+
+ICE_FS_API ice_fs_line_view ICE_FS_CALLCONV ice_fs_line_index_range(const ice_fs_line_index* index, int from, int to) {
+    ice_fs_line_view res = { NULL, 0 };
+    unsigned long long start, end;
+    
+    if (from < 0) from = 0;
+    if (to >= index->count) to = index->count - 1;
+    
+    if (from > to) {
+        return res;
+    }
+    
+    start = ice_fs_line_index_offset(index, from);
+    end = ice_fs_line_index_offset(index, to + 1);
+    
+    // Line ending of last line isn't part of range (\n or \r\n)
+    if (end > start && index->data[end - 1] == '\n') {
+        end--;
+        if (end > start && index->data[end - 1] == '\r') end--;
+    }
+    
+    res.ptr = index->data + start;
+    res.len = end - start;
+    return res;
+}
+
+ICE_FS_API ice_fs_line_view ICE_FS_CALLCONV ice_fs_line_index_get(const ice_fs_line_index* index, int l) {
+    if (l < 0 || l >= index->count) {
+        ice_fs_line_view res = { NULL, 0 };
+        return res;
+    }
+    
+    return ice_fs_line_index_range(index, l, l);
+}
+
+ICE_FS_API void ICE_FS_CALLCONV ice_fs_line_index_free(ice_fs_line_index* index) {
+    ICE_FS_FREE(index->offsets);
+    ice_fs_unmap(&index->view);
+    index->offsets = NULL;
+    index->data = NULL;
+    index->size = 0;
+    index->count = 0;
+}
+
+ICE_FS_API ice_fs_line_edits ICE_FS_CALLCONV ice_fs_line_edits_new(void) {
+    ice_fs_line_edits res = { NULL, 0, 0 };
+    return res;
+}
+
+// Insert and replace need content (Content of remove is ignored)
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_line_edits_add(ice_fs_line_edits* edits, ice_fs_edit_kind kind, int l, char* content) {
+    char* copy = NULL;
+    
+    if (l < 0 || (kind != ICE_FS_EDIT_REMOVE && content == NULL)) {
+        return ICE_FS_FALSE;
+    }
+    
+    if (edits->count == edits->cap) {
+        int cap = (edits->cap == 0) ? 16 : edits->cap * 2;
+        ice_fs_line_edit* arr = (ice_fs_line_edit*) ICE_FS_REALLOC(edits->edits, cap * sizeof(ice_fs_line_edit));
+        
+        if (arr == NULL) {
+            return ICE_FS_FALSE;
+        }
+        
+        edits->edits = arr;
+        edits->cap = cap;
+    }
+    
+    if (kind != ICE_FS_EDIT_REMOVE) {
+        size_t len = strlen(content);
+        copy = (char*) ICE_FS_MALLOC(len + 1);
+        
+        if (copy == NULL) {
+            return ICE_FS_FALSE;
+        }
+        
+        memcpy(copy, content, len + 1);
+    }
+    
+    edits->edits[edits->count].kind = kind;
+    edits->edits[edits->count].line = l;
+    edits->edits[edits->count].order = edits->count;
+    edits->edits[edits->count].content = copy;
+    edits->count++;
+    return ICE_FS_TRUE;
+}
+
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_line_edits_insert(ice_fs_line_edits* edits, int l, char* content) {
+    return ice_fs_line_edits_add(edits, ICE_FS_EDIT_INSERT, l, content);
+}
+
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_line_edits_replace(ice_fs_line_edits* edits, int l, char* content) {
+    return ice_fs_line_edits_add(edits, ICE_FS_EDIT_REPLACE, l, content);
+}
+
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_line_edits_remove(ice_fs_line_edits* edits, int l) {
+    return ice_fs_line_edits_add(edits, ICE_FS_EDIT_REMOVE, l, NULL);
+}
+
+ICE_FS_API int ICE_FS_CALLCONV ice_fs_line_edit_cmp(const void* a, const void* b) {
+    const ice_fs_line_edit* e1 = (const ice_fs_line_edit*) a;
+    const ice_fs_line_edit* e2 = (const ice_fs_line_edit*) b;
+    
+    if (e1->line != e2->line) return (e1->line < e2->line) ? -1 : 1;
+    return (e1->order < e2->order) ? -1 : (e1->order > e2->order);
+}
+
+// Creates empty file with unique name in same directory as fname (So rename over fname stays on same filesystem)
+ICE_FS_API FILE* ICE_FS_CALLCONV ice_fs_temp_file_near(char* fname, char* res) {
+
+#if defined(ICE_FFI_MICROSOFT)
+    char dir[MAX_PATH];
+    char* slash = NULL;
+    
+    if (strlen(fname) >= MAX_PATH) {
+        return NULL;
+    }
+    
+    strcpy(dir, fname);
+    
+    for (char* p = dir; *p != '\0'; p++) {
+        if (*p == '\\' || *p == '/') slash = p;
+    }
+    
+    if (slash == NULL) strcpy(dir, ".");
+    else slash[1] = '\0';
+    
+    if (GetTempFileNameA(dir, "ice", 0, res) == 0) {
+        return NULL;
+    }
+    
+    return fopen(res, "wb");
+    
+#else
+    struct stat st;
+    int fd;
+    
+    sprintf(res, "%s.XXXXXX", fname);
+    fd = mkstemp(res);
+    
+    if (fd < 0) {
+        return NULL;
+    }
+    
+    // mkstemp creates file only owner could read, So it gets permissions of file it replaces
+    if (stat(fname, &st) == 0) {
+        fchmod(fd, st.st_mode & 07777);
+    }
+    
+    return fdopen(fd, "wb");
+#endif
+
+}
+
+// Lines between edited ones are written straight from mapped file as one block, So cost is one pass over file
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_line_edits_apply(ice_fs_line_edits* edits, char* fname) {
+    unsigned long long nl[256];
+    unsigned long long pos = 0;             // Start of line cur
+    unsigned long long copied = 0;          // Bytes of old file already written
+    const char* eol = "\n";
+    const char* data;
+    ice_fs_map_view view;
+    int missing_eol = 0;                    // 1 if last line has no line ending and cur is past it
+    int cur = 0;
+    int ok = 1;
+    FILE* f;
+    char* tmp;
+    
+    if (edits->count == 0) {
+        return ICE_FS_TRUE;
+    }
+    
+    if (ice_fs_map(fname, ICE_FS_MAP_READ, &view) == ICE_FS_FALSE) {
+        return ICE_FS_FALSE;
+    }
+    
+    tmp = (char*) ICE_FS_MALLOC(strlen(fname) + 1024);
+    f = (tmp == NULL) ? NULL : ice_fs_temp_file_near(fname, tmp);
+    
+    if (f == NULL) {
+        ICE_FS_FREE(tmp);
+        ice_fs_unmap(&view);
+        return ICE_FS_FALSE;
+    }
+    
+    setvbuf(f, NULL, _IOFBF, ICE_FS_EDIT_BUFFER);
+    ice_fs_map_advise(&view, ICE_FS_MAP_SEQUENTIAL);
+    data = (const char*) view.data;
+    
+    // Inserted lines get same line ending as first line of file
+    if (ice_fs_find_newlines(data, 0, view.size, nl, 1) == 1 && nl[0] > 0 && data[nl[0] - 1] == '\r') {
+        eol = "\r\n";
+    }
+    
+    qsort(edits->edits, edits->count, sizeof(ice_fs_line_edit), ice_fs_line_edit_cmp);
+    
+    for (int i = 0; i < edits->count && ok;) {
+        int l = edits->edits[i].line;
+        int last = -1;                      // Index of last replace or remove of line l
+        
+        // Skips to start of line l
+        while (cur < l) {
+            int want = (l - cur < 256) ? (l - cur) : 256;
+            int n = ice_fs_find_newlines(data, pos, view.size, nl, want);
+            
+            if (n > 0) {
+                pos = nl[n - 1] + 1;
+                cur += n;
+            } else if (pos < view.size) {
+                pos = view.size;
+                cur++;
+                missing_eol = 1;
+            } else {
+                break;
+            }
+        }
+        
+        if (cur < l) {
+            ok = 0;
+            break;
+        }
+        
+        if (pos > copied && fwrite(data + copied, 1, (size_t) (pos - copied), f) != (size_t) (pos - copied)) ok = 0;
+        copied = pos;
+        
+        if (missing_eol && fputs(eol, f) < 0) ok = 0;
+        missing_eol = 0;
+        
+        for (; i < edits->count && edits->edits[i].line == l; i++) {
+            if (edits->edits[i].kind != ICE_FS_EDIT_INSERT) {
+                last = i;
+            } else if (fputs(edits->edits[i].content, f) < 0 || fputs(eol, f) < 0) {
+                ok = 0;
+            }
+        }
+        
+        if (last < 0) {
+            continue;
+        }
+        
+        // Line past end of file could only get lines inserted before it
+        if (pos >= view.size) {
+            ok = 0;
+            break;
+        }
+        
+        unsigned long long end = view.size;
+        unsigned long long content_end = view.size;
+        
+        if (ice_fs_find_newlines(data, pos, view.size, nl, 1) == 1) {
+            end = nl[0] + 1;
+            content_end = nl[0];
+            if (content_end > pos && data[content_end - 1] == '\r') content_end--;
+        }
+        
+        if (edits->edits[last].kind == ICE_FS_EDIT_REPLACE) {
+            if (fputs(edits->edits[last].content, f) < 0) ok = 0;
+            if (end > content_end && fwrite(data + content_end, 1, (size_t) (end - content_end), f) != (size_t) (end - content_end)) ok = 0;
+            
+            // Replaced last line still has no line ending, So lines appended after it need one first
+            missing_eol = (end == content_end);
+        }
+        
+        pos = end;
+        copied = end;
+        cur++;
+    }
+    
+    if (ok && view.size > copied && fwrite(data + copied, 1, (size_t) (view.size - copied), f) != (size_t) (view.size - copied)) ok = 0;
+    if (fflush(f) != 0) ok = 0;
+
+#if !defined(ICE_FFI_MICROSOFT)
+    // Data must reach disk before rename, Else crash could leave empty file under old name
+    if (ok && fsync(fileno(f)) < 0) ok = 0;
+#endif
+
+    if (fclose(f) != 0) ok = 0;
+    
+    // Windows can't replace file that is still mapped
+    ice_fs_unmap(&view);
+    
+#if defined(ICE_FFI_MICROSOFT)
+    if (ok && !MoveFileExA(tmp, fname, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) ok = 0;
+#else
+    if (ok && rename(tmp, fname) < 0) ok = 0;
+#endif
+
+    if (!ok) remove(tmp);
+    ICE_FS_FREE(tmp);
+    return ok ? ICE_FS_TRUE : ICE_FS_FALSE;
+}
+
+ICE_FS_API void ICE_FS_CALLCONV ice_fs_line_edits_free(ice_fs_line_edits* edits) {
+    for (int i = 0; i < edits->count; i++) ICE_FS_FREE(edits->edits[i].content);
+    ICE_FS_FREE(edits->edits);
+    edits->edits = NULL;
+    edits->count = 0;
+    edits->cap = 0;
+}
+
+// Directory stream walker reads entries from, Type of each entry comes with name (d_type on POSIX, Attributes on Windows) so no stat is needed per entry
+typedef struct ice_fs_dir_stream {
+#if defined(ICE_FFI_MICROSOFT)
+    HANDLE find;
+    WIN32_FIND_DATAA data;
+    int first;
+#elif defined(ICE_FS_LINUX_SYSCALL) && defined(SYS_getdents64)
+    int fd;
+    char* buf;
+    long len;
+    long pos;
+#else
+    DIR* dir;
+#endif
+    int base;                       // Length of directory path in walker path
+} ice_fs_dir_stream;
+
+#if !defined(ICE_FFI_MICROSOFT)
+// dirfd and fstatat came with AT_SYMLINK_NOFOLLOW in POSIX.1-2008, Without them ice_fs_entry_type_at gets -1 and gives up
+#  if defined(AT_SYMLINK_NOFOLLOW)
+#    define ICE_FS_DIRFD(dir) dirfd(dir)
+#  else
+#    define ICE_FS_DIRFD(dir) (-1)
+#  endif
+
+// Slow path for file systems that don't fill d_type, Links are not followed
+ICE_FS_API ice_fs_entry_type ICE_FS_CALLCONV ice_fs_entry_type_at(int fd, char* name) {
+#  if defined(AT_SYMLINK_NOFOLLOW)
+    struct stat st;
+    
+    if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) < 0) return ICE_FS_ENTRY_OTHER;
+    if (S_ISDIR(st.st_mode)) return ICE_FS_ENTRY_DIR;
+    if (S_ISLNK(st.st_mode)) return ICE_FS_ENTRY_LINK;
+    if (S_ISREG(st.st_mode)) return ICE_FS_ENTRY_FILE;
+    return ICE_FS_ENTRY_OTHER;
+#  else
+    // Type can't be found from name alone, So entry is reported as other and isn't walked into
+    (void) fd;
+    (void) name;
+    return ICE_FS_ENTRY_OTHER;
+#  endif
+}
+#endif
+
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_dir_stream_open(char* dir, ice_fs_dir_stream* res) {
+#if defined(ICE_FFI_MICROSOFT)
+    size_t len = strlen(dir);
+    char* patt = (char*) ICE_FS_MALLOC(len + 3);
+    
+    if (patt == NULL) return ICE_FS_FALSE;
+    
+    memcpy(patt, dir, len);
+    if (len > 0 && patt[len - 1] != '\\' && patt[len - 1] != '/') patt[len++] = '\\';
+    patt[len++] = '*';
+    patt[len] = '\0';
+    
+    // Basic info skips short names and large fetch asks for bigger batches of entries per call
+#if defined(FIND_FIRST_EX_LARGE_FETCH)
+    res->find = FindFirstFileExA(patt, FindExInfoBasic, &res->data, FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+#else
+    res->find = FindFirstFileExA(patt, FindExInfoStandard, &res->data, FindExSearchNameMatch, NULL, 0);
+#endif
+    
+    ICE_FS_FREE(patt);
+    res->first = 1;
+    return (res->find == INVALID_HANDLE_VALUE) ? ICE_FS_FALSE : ICE_FS_TRUE;
+#elif defined(ICE_FS_LINUX_SYSCALL) && defined(SYS_getdents64)
+#  if defined(O_DIRECTORY) && defined(O_CLOEXEC)
+    res->fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+#  else
+    res->fd = open(dir, O_RDONLY);
+#  endif
+    
+    if (res->fd < 0) return ICE_FS_FALSE;
+    
+    res->buf = (char*) ICE_FS_MALLOC(ICE_FS_WALK_BUFFER);
+    
+    if (res->buf == NULL) {
+        close(res->fd);
+        return ICE_FS_FALSE;
+    }
+    
+    res->len = 0;
+    res->pos = 0;
+    return ICE_FS_TRUE;
+#else
+    res->dir = opendir(dir);
+    return (res->dir == NULL) ? ICE_FS_FALSE : ICE_FS_TRUE;
+#endif
+}
+
+// Returns ICE_FS_FALSE once directory has no more entries, "." and ".." are skipped
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_dir_stream_next(ice_fs_dir_stream* stream, char** name, ice_fs_entry_type* type) {
+#if defined(ICE_FFI_MICROSOFT)
+    for (;;) {
+        char* n;
+        DWORD attrs;
+        
+        if (stream->first) {
+            stream->first = 0;
+        } else if (!FindNextFileA(stream->find, &stream->data)) {
+            return ICE_FS_FALSE;
+        }
+        
+        n = stream->data.cFileName;
+        if (n[0] == '.' && (n[1] == '\0' || (n[1] == '.' && n[2] == '\0'))) continue;
+        
+        attrs = stream->data.dwFileAttributes;
+        
+        // Junctions and symbolic links are reparse points, Walking into them could loop
+        if (attrs & FILE_ATTRIBUTE_REPARSE_POINT) *type = ICE_FS_ENTRY_LINK;
+        else if (attrs & FILE_ATTRIBUTE_DIRECTORY) *type = ICE_FS_ENTRY_DIR;
+        else if (attrs & FILE_ATTRIBUTE_DEVICE) *type = ICE_FS_ENTRY_OTHER;
+        else *type = ICE_FS_ENTRY_FILE;
+        
+        *name = n;
+        return ICE_FS_TRUE;
+    }
+#elif defined(ICE_FS_LINUX_SYSCALL) && defined(SYS_getdents64)
+    for (;;) {
+        char* d;
+        char* n;
+        unsigned short reclen;
+        unsigned char t;
+        
+        // One syscall fills whole buffer, Instead of readdir refilling its small one
+        if (stream->pos >= stream->len) {
+            stream->len = (long) syscall(SYS_getdents64, stream->fd, stream->buf, ICE_FS_WALK_BUFFER);
+            stream->pos = 0;
+            if (stream->len <= 0) return ICE_FS_FALSE;
+        }
+        
+        // linux_dirent64 is { u64 d_ino; s64 d_off; u16 d_reclen; u8 d_type; char d_name[]; }
+        d = stream->buf + stream->pos;
+        memcpy(&reclen, d + 16, sizeof(reclen));
+        t = (unsigned char) d[18];
+        n = d + 19;
+        stream->pos += reclen;
+        
+        if (n[0] == '.' && (n[1] == '\0' || (n[1] == '.' && n[2] == '\0'))) continue;
+        
+        switch (t) {
+            case DT_REG: *type = ICE_FS_ENTRY_FILE; break;
+            case DT_DIR: *type = ICE_FS_ENTRY_DIR; break;
+            case DT_LNK: *type = ICE_FS_ENTRY_LINK; break;
+            case DT_UNKNOWN: *type = ice_fs_entry_type_at(stream->fd, n); break;
+            default: *type = ICE_FS_ENTRY_OTHER; break;
+        }
+        
+        *name = n;
+        return ICE_FS_TRUE;
+    }
+#else
+    struct dirent* e;
+    
+    while ((e = readdir(stream->dir)) != NULL) {
+        char* n = e->d_name;
+        
+        if (n[0] == '.' && (n[1] == '\0' || (n[1] == '.' && n[2] == '\0'))) continue;
+        
+#if defined(DT_DIR)
+        switch (e->d_type) {
+            case DT_REG: *type = ICE_FS_ENTRY_FILE; break;
+            case DT_DIR: *type = ICE_FS_ENTRY_DIR; break;
+            case DT_LNK: *type = ICE_FS_ENTRY_LINK; break;
+            case DT_UNKNOWN: *type = ice_fs_entry_type_at(ICE_FS_DIRFD(stream->dir), n); break;
+            default: *type = ICE_FS_ENTRY_OTHER; break;
+        }
+#else
+        *type = ice_fs_entry_type_at(ICE_FS_DIRFD(stream->dir), n);
+#endif
+        
+        *name = n;
+        return ICE_FS_TRUE;
+    }
+    
+    return ICE_FS_FALSE;
+#endif
+}
+
+ICE_FS_API void ICE_FS_CALLCONV ice_fs_dir_stream_close(ice_fs_dir_stream* stream) {
+#if defined(ICE_FFI_MICROSOFT)
+    FindClose(stream->find);
+#elif defined(ICE_FS_LINUX_SYSCALL) && defined(SYS_getdents64)
+    close(stream->fd);
+    ICE_FS_FREE(stream->buf);
+#else
+    closedir(stream->dir);
+#endif
+}
+
+// Matches one character of name against p[i] (Literal, '?' or [class]), Returns index after it in pattern or 0 if no match
+ICE_FS_API unsigned long long ICE_FS_CALLCONV ice_fs_glob_char(const char* p, unsigned long long plen, unsigned long long i, char c) {
+#if defined(ICE_FFI_MICROSOFT)
+    // Windows file names are case insensitive, So are patterns
+    if (c >= 'A' && c <= 'Z') c = (char) (c + 32);
+#  define ICE_FS_GLOB_FOLD(ch) (((ch) >= 'A' && (ch) <= 'Z') ? (char) ((ch) + 32) : (ch))
+#else
+#  define ICE_FS_GLOB_FOLD(ch) (ch)
+#endif
+    if (p[i] == '?') return i + 1;
+    
+    if (p[i] == '[') {
+        unsigned long long j = i + 1;
+        int negate = 0;
+        int found = 0;
+        
+        if (j < plen && (p[j] == '!' || p[j] == '^')) {
+            negate = 1;
+            j++;
+        }
+        
+        // ']' right after opening is literal, Like in shells
+        do {
+            char lo, hi;
+            
+            if (j >= plen) return (ICE_FS_GLOB_FOLD(p[i]) == c) ? i + 1 : 0;
+            
+            lo = ICE_FS_GLOB_FOLD(p[j]);
+            hi = lo;
+            
+            if (j + 2 < plen && p[j + 1] == '-' && p[j + 2] != ']') {
+                hi = ICE_FS_GLOB_FOLD(p[j + 2]);
+                j += 2;
+            }
+            
+            if (c >= lo && c <= hi) found = 1;
+            j++;
+        } while (j >= plen || p[j] != ']');
+        
+        return (found != negate) ? j + 1 : 0;
+    }
+    
+    return (ICE_FS_GLOB_FOLD(p[i]) == c) ? i + 1 : 0;
+#undef ICE_FS_GLOB_FOLD
+}
+
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_glob_match_len(const char* p, unsigned long long plen, const char* name) {
+    unsigned long long pi = 0;
+    unsigned long long ni = 0;
+    unsigned long long star_pi = 0;
+    unsigned long long star_ni = 0;
+    int star = 0;
+    
+    // Last '*' is retried against one more character of name on mismatch, So no recursion is needed
+    while (name[ni] != '\0') {
+        if (pi < plen && p[pi] == '*') {
+            star = 1;
+            star_pi = ++pi;
+            star_ni = ni;
+            continue;
+        }
+        
+        if (pi < plen) {
+            unsigned long long next = ice_fs_glob_char(p, plen, pi, name[ni]);
+            
+            if (next != 0) {
+                pi = next;
+                ni++;
+                continue;
+            }
+        }
+        
+        if (!star) return ICE_FS_FALSE;
+        
+        pi = star_pi;
+        ni = ++star_ni;
+    }
+    
+    while (pi < plen && p[pi] == '*') pi++;
+    return (pi == plen) ? ICE_FS_TRUE : ICE_FS_FALSE;
+}
+
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_glob_match(char* pattern, char* name) {
+    return ice_fs_glob_match_len(pattern, strlen(pattern), name);
+}
+
+// Matches name against any of patterns separated by ';', NULL matches everything
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_glob_match_any(char* patterns, char* name) {
+    char* p = patterns;
+    
+    if (patterns == NULL) return ICE_FS_TRUE;
+    
+    for (;;) {
+        char* end = strchr(p, ';');
+        unsigned long long len = (end == NULL) ? strlen(p) : (unsigned long long) (end - p);
+        
+        if (ice_fs_glob_match_len(p, len, name) == ICE_FS_TRUE) return ICE_FS_TRUE;
+        if (end == NULL) return ICE_FS_FALSE;
+        
+        p = end + 1;
+    }
+}
+
+ICE_FS_API ice_fs_walk_options ICE_FS_CALLCONV ice_fs_walk_options_default(void) {
+    ice_fs_walk_options res;
+    res.max_depth = -1;
+    res.pattern = NULL;
+    res.dirs = 0;
+    return res;
+}
+
+// Appends name to path of directory ending at base, Returns length of new path or -1 if out of memory
+ICE_FS_API int ICE_FS_CALLCONV ice_fs_path_join_at(char** path, int* cap, int base, char* name) {
+    int len = (int) strlen(name);
+    int sep = (base > 0 && (*path)[base - 1] != '/' && (*path)[base - 1] != '\\');
+    int need = base + sep + len + 1;
+    
+    if (need > *cap) {
+        int grown_cap = *cap * 2;
+        char* grown;
+        
+        if (grown_cap < need) grown_cap = need;
+        grown = (char*) ICE_FS_REALLOC(*path, grown_cap);
+        if (grown == NULL) return -1;
+        
+        *path = grown;
+        *cap = grown_cap;
+    }
+    
+#if defined(ICE_FFI_MICROSOFT)
+    if (sep) (*path)[base] = '\\';
+#else
+    if (sep) (*path)[base] = '/';
+#endif
+
+    memcpy(*path + base + sep, name, len + 1);
+    return base + sep + len;
+}
+
+// Opens directory at current walker path as new deepest level
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_walk_push(ice_fs_walker* walker) {
+    ice_fs_dir_stream* frames = (ice_fs_dir_stream*) walker->frames;
+    
+    if (walker->depth == walker->frames_cap) {
+        int cap = (walker->frames_cap == 0) ? 16 : walker->frames_cap * 2;
+        frames = (ice_fs_dir_stream*) ICE_FS_REALLOC(frames, cap * sizeof(ice_fs_dir_stream));
+        if (frames == NULL) return ICE_FS_FALSE;
+        
+        walker->frames = frames;
+        walker->frames_cap = cap;
+    }
+    
+    if (ice_fs_dir_stream_open(walker->path, &frames[walker->depth]) == ICE_FS_FALSE) return ICE_FS_FALSE;
+    
+    frames[walker->depth].base = walker->path_len;
+    walker->depth++;
+    return ICE_FS_TRUE;
+}
+
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_walk_open(char* dir, const ice_fs_walk_options* opts, ice_fs_walker* res) {
+    int len = (int) strlen(dir);
+    
+    memset(res, 0, sizeof(ice_fs_walker));
+    res->opts = (opts == NULL) ? ice_fs_walk_options_default() : *opts;
+    res->path_cap = len + 256;
+    res->path = (char*) ICE_FS_MALLOC(res->path_cap);
+    
+    if (res->path == NULL) return ICE_FS_FALSE;
+    
+    memcpy(res->path, dir, len + 1);
+    res->path_len = len;
+    
+    if (ice_fs_walk_push(res) == ICE_FS_FALSE) {
+        ice_fs_walk_close(res);
+        return ICE_FS_FALSE;
+    }
+    
+    return ICE_FS_TRUE;
+}
+
+// Depth-first pre-order, Directory entry comes before its contents
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_walk_next(ice_fs_walker* walker, ice_fs_walk_entry* entry) {
+    // Directories that can't be opened (Like ones without permission) are skipped, Not treated as end of walk
+    if (walker->descend) {
+        walker->descend = 0;
+        ice_fs_walk_push(walker);
+    }
+    
+    while (walker->depth > 0) {
+        ice_fs_dir_stream* stream = &((ice_fs_dir_stream*) walker->frames)[walker->depth - 1];
+        int depth = walker->depth - 1;
+        ice_fs_entry_type type;
+        char* name;
+        int descend = 0;
+        int len;
+        
+        if (ice_fs_dir_stream_next(stream, &name, &type) == ICE_FS_FALSE) {
+            ice_fs_dir_stream_close(stream);
+            walker->depth--;
+            continue;
+        }
+        
+        if (type == ICE_FS_ENTRY_DIR) {
+            descend = (walker->opts.max_depth < 0 || depth < walker->opts.max_depth);
+            if (!walker->opts.dirs && !descend) continue;
+        } else if (ice_fs_glob_match_any(walker->opts.pattern, name) == ICE_FS_FALSE) {
+            continue;
+        }
+        
+        len = ice_fs_path_join_at(&walker->path, &walker->path_cap, stream->base, name);
+        if (len < 0) continue;
+        
+        walker->path_len = len;
+        
+        if (type == ICE_FS_ENTRY_DIR) {
+            // Hidden directories are walked into right away, Returned ones on next call so caller can skip them
+            if (!walker->opts.dirs) {
+                ice_fs_walk_push(walker);
+                continue;
+            }
+            
+            walker->descend = descend;
+        }
+        
+        entry->path = walker->path;
+        entry->name = walker->path + len - strlen(name);
+        entry->depth = depth;
+        entry->type = type;
+        return ICE_FS_TRUE;
+    }
+    
+    return ICE_FS_FALSE;
+}
+
+ICE_FS_API void ICE_FS_CALLCONV ice_fs_walk_skip(ice_fs_walker* walker) {
+    walker->descend = 0;
+}
+
+ICE_FS_API void ICE_FS_CALLCONV ice_fs_walk_close(ice_fs_walker* walker) {
+    ice_fs_dir_stream* frames = (ice_fs_dir_stream*) walker->frames;
+    
+    for (int i = 0; i < walker->depth; i++) ice_fs_dir_stream_close(&frames[i]);
+    
+    ICE_FS_FREE(walker->frames);
+    ICE_FS_FREE(walker->path);
+    memset(walker, 0, sizeof(ice_fs_walker));
+}
+
+#if defined(ICE_FS_NO_THREADS)
+typedef int ice_fs_lock;
+typedef int ice_fs_cond;
+#  define ICE_FS_LOCK_INIT(l) ((void) 0)
+#  define ICE_FS_LOCK_FREE(l) ((void) 0)
+#  define ICE_FS_LOCK(l) ((void) 0)
+#  define ICE_FS_UNLOCK(l) ((void) 0)
+#  define ICE_FS_COND_INIT(c) ((void) 0)
+#  define ICE_FS_COND_FREE(c) ((void) 0)
+#  define ICE_FS_COND_WAIT(c, l) ((void) 0)
+#  define ICE_FS_COND_WAKE(c) ((void) 0)
+#  define ICE_FS_COND_WAKE_ALL(c) ((void) 0)
+#elif defined(ICE_FFI_MICROSOFT)
+typedef SRWLOCK ice_fs_lock;
+typedef CONDITION_VARIABLE ice_fs_cond;
+#  define ICE_FS_LOCK_INIT(l) InitializeSRWLock(l)
+#  define ICE_FS_LOCK_FREE(l)
+#  define ICE_FS_LOCK(l) AcquireSRWLockExclusive(l)
+#  define ICE_FS_UNLOCK(l) ReleaseSRWLockExclusive(l)
+#  define ICE_FS_COND_INIT(c) InitializeConditionVariable(c)
+#  define ICE_FS_COND_FREE(c)
+#  define ICE_FS_COND_WAIT(c, l) SleepConditionVariableSRW(c, l, INFINITE, 0)
+#  define ICE_FS_COND_WAKE(c) WakeConditionVariable(c)
+#  define ICE_FS_COND_WAKE_ALL(c) WakeAllConditionVariable(c)
+#else
+typedef pthread_mutex_t ice_fs_lock;
+typedef pthread_cond_t ice_fs_cond;
+#  define ICE_FS_LOCK_INIT(l) pthread_mutex_init(l, NULL)
+#  define ICE_FS_LOCK_FREE(l) pthread_mutex_destroy(l)
+#  define ICE_FS_LOCK(l) pthread_mutex_lock(l)
+#  define ICE_FS_UNLOCK(l) pthread_mutex_unlock(l)
+#  define ICE_FS_COND_INIT(c) pthread_cond_init(c, NULL)
+#  define ICE_FS_COND_FREE(c) pthread_cond_destroy(c)
+#  define ICE_FS_COND_WAIT(c, l) pthread_cond_wait(c, l)
+#  define ICE_FS_COND_WAKE(c) pthread_cond_signal(c)
+#  define ICE_FS_COND_WAKE_ALL(c) pthread_cond_broadcast(c)
+#endif
+
+typedef struct ice_fs_walk_task {
+    char* path;
+    int depth;                      // Depth of entries inside directory
+} ice_fs_walk_task;
+
+// Shared stack of directories not listed yet, Threads take one, List it and push its subdirectories back
+typedef struct ice_fs_walk_pool {
+    ice_fs_walk_options opts;
+    ice_fs_walk_fn fn;
+    void* user;
+    ice_fs_walk_task* tasks;
+    int count;
+    int cap;
+    int active;                     // Threads listing directory right now (Which may push more tasks)
+    int entries;
+    ice_fs_lock lock;
+    ice_fs_cond cond;
+} ice_fs_walk_pool;
+
+ICE_FS_API void ICE_FS_CALLCONV ice_fs_walk_list(ice_fs_walk_pool* pool, ice_fs_walk_task* task, ice_fs_walk_task** subdirs, int* count, int* cap, int* entries) {
+    ice_fs_dir_stream stream;
+    ice_fs_entry_type type;
+    char* name;
+    int base = (int) strlen(task->path);
+    int path_cap = base + 256;
+    char* path;
+    
+    if (ice_fs_dir_stream_open(task->path, &stream) == ICE_FS_FALSE) return;
+    
+    path = (char*) ICE_FS_MALLOC(path_cap);
+    
+    if (path == NULL) {
+        ice_fs_dir_stream_close(&stream);
+        return;
+    }
+    
+    memcpy(path, task->path, base + 1);
+    
+    while (ice_fs_dir_stream_next(&stream, &name, &type) == ICE_FS_TRUE) {
+        ice_fs_walk_entry entry;
+        int descend = 0;
+        int len;
+        
+        if (type == ICE_FS_ENTRY_DIR) {
+            descend = (pool->opts.max_depth < 0 || task->depth < pool->opts.max_depth);
+            if (!pool->opts.dirs && !descend) continue;
+        } else if (ice_fs_glob_match_any(pool->opts.pattern, name) == ICE_FS_FALSE) {
+            continue;
+        }
+        
+        len = ice_fs_path_join_at(&path, &path_cap, base, name);
+        if (len < 0) continue;
+        
+        if (descend) {
+            if (*count == *cap) {
+                int grown_cap = (*cap == 0) ? 16 : *cap * 2;
+                ice_fs_walk_task* grown = (ice_fs_walk_task*) ICE_FS_REALLOC(*subdirs, grown_cap * sizeof(ice_fs_walk_task));
+                
+                if (grown != NULL) {
+                    *subdirs = grown;
+                    *cap = grown_cap;
+                }
+            }
+            
+            if (*count < *cap) {
+                (*subdirs)[*count].path = (char*) ICE_FS_MALLOC(len + 1);
+                
+                if ((*subdirs)[*count].path != NULL) {
+                    memcpy((*subdirs)[*count].path, path, len + 1);
+                    (*subdirs)[*count].depth = task->depth + 1;
+                    (*count)++;
+                }
+            }
+        }
+        
+        if (type == ICE_FS_ENTRY_DIR && !pool->opts.dirs) continue;
+        
+        entry.path = path;
+        entry.name = path + len - strlen(name);
+        entry.depth = task->depth;
+        entry.type = type;
+        pool->fn(&entry, pool->user);
+        (*entries)++;
+    }
+    
+    ice_fs_dir_stream_close(&stream);
+    ICE_FS_FREE(path);
+}
+
+ICE_FS_API void ICE_FS_CALLCONV ice_fs_walk_work(ice_fs_walk_pool* pool) {
+    ice_fs_walk_task* subdirs = NULL;
+    int subdirs_cap = 0;
+    
+    ICE_FS_LOCK(&pool->lock);
+    
+    for (;;) {
+        ice_fs_walk_task task;
+        int count = 0;
+        int entries = 0;
+        
+        // Empty stack isn't end while others are listing, They may still push subdirectories
+        while (pool->count == 0 && pool->active > 0) ICE_FS_COND_WAIT(&pool->cond, &pool->lock);
+        
+        if (pool->count == 0) break;
+        
+        task = pool->tasks[--pool->count];
+        pool->active++;
+        ICE_FS_UNLOCK(&pool->lock);
+        
+        ice_fs_walk_list(pool, &task, &subdirs, &count, &subdirs_cap, &entries);
+        ICE_FS_FREE(task.path);
+        
+        ICE_FS_LOCK(&pool->lock);
+        
+        if (pool->count + count > pool->cap) {
+            int grown_cap = pool->cap * 2;
+            ice_fs_walk_task* grown;
+            
+            if (grown_cap < pool->count + count) grown_cap = pool->count + count;
+            grown = (ice_fs_walk_task*) ICE_FS_REALLOC(pool->tasks, grown_cap * sizeof(ice_fs_walk_task));
+            
+            if (grown != NULL) {
+                pool->tasks = grown;
+                pool->cap = grown_cap;
+            }
+        }
+        
+        for (int i = 0; i < count; i++) {
+            if (pool->count < pool->cap) pool->tasks[pool->count++] = subdirs[i];
+            else ICE_FS_FREE(subdirs[i].path);
+        }
+        
+        pool->entries += entries;
+        pool->active--;
+        
+        if (count > 0 || pool->active == 0) ICE_FS_COND_WAKE_ALL(&pool->cond);
+    }
+    
+    ICE_FS_UNLOCK(&pool->lock);
+    ICE_FS_FREE(subdirs);
+}
+
+#if !defined(ICE_FS_NO_THREADS)
+#  if defined(ICE_FFI_MICROSOFT)
+static DWORD WINAPI ice_fs_walk_thread(LPVOID pool) {
+    ice_fs_walk_work((ice_fs_walk_pool*) pool);
+    return 0;
+}
+#  else
+static void* ice_fs_walk_thread(void* pool) {
+    ice_fs_walk_work((ice_fs_walk_pool*) pool);
+    return NULL;
+}
+#  endif
+#endif
+
+// threads counts calling thread too, 0 uses one per processor, Returns count of entries passed to fn or -1 if dir can't be opened
+ICE_FS_API int ICE_FS_CALLCONV ice_fs_walk_parallel(char* dir, const ice_fs_walk_options* opts, int threads, ice_fs_walk_fn fn, void* user) {
+    ice_fs_walk_pool pool;
+    ice_fs_dir_stream root;
+    size_t len = strlen(dir);
+    
+    if (ice_fs_dir_stream_open(dir, &root) == ICE_FS_FALSE) return -1;
+    ice_fs_dir_stream_close(&root);
+    
+    memset(&pool, 0, sizeof(ice_fs_walk_pool));
+    pool.opts = (opts == NULL) ? ice_fs_walk_options_default() : *opts;
+    pool.fn = fn;
+    pool.user = user;
+    pool.cap = 64;
+    pool.tasks = (ice_fs_walk_task*) ICE_FS_MALLOC(pool.cap * sizeof(ice_fs_walk_task));
+    
+    if (pool.tasks == NULL) return -1;
+    
+    pool.tasks[0].path = (char*) ICE_FS_MALLOC(len + 1);
+    
+    if (pool.tasks[0].path == NULL) {
+        ICE_FS_FREE(pool.tasks);
+        return -1;
+    }
+    
+    memcpy(pool.tasks[0].path, dir, len + 1);
+    pool.tasks[0].depth = 0;
+    pool.count = 1;
+    
+    ICE_FS_LOCK_INIT(&pool.lock);
+    ICE_FS_COND_INIT(&pool.cond);
+    
+#if defined(ICE_FS_NO_THREADS)
+    (void) threads;
+    ice_fs_walk_work(&pool);
+#else
+    if (threads <= 0) {
+#  if defined(ICE_FFI_MICROSOFT)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        threads = (int) info.dwNumberOfProcessors;
+#  else
+        threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#  endif
+        if (threads <= 0) threads = 1;
+    }
+    
+    {
+#  if defined(ICE_FFI_MICROSOFT)
+        HANDLE* handles = (HANDLE*) ICE_FS_MALLOC((threads - 1) * sizeof(HANDLE) + 1);
+#  else
+        pthread_t* handles = (pthread_t*) ICE_FS_MALLOC((threads - 1) * sizeof(pthread_t) + 1);
+#  endif
+        int started = 0;
+        
+        // Threads that fail to start are not fatal, Calling thread works through stack either way
+        for (int i = 0; handles != NULL && i < threads - 1; i++) {
+#  if defined(ICE_FFI_MICROSOFT)
+            handles[started] = CreateThread(NULL, 0, ice_fs_walk_thread, &pool, 0, NULL);
+            if (handles[started] != NULL) started++;
+#  else
+            if (pthread_create(&handles[started], NULL, ice_fs_walk_thread, &pool) == 0) started++;
+#  endif
+        }
+        
+        ice_fs_walk_work(&pool);
+        
+        for (int i = 0; i < started; i++) {
+#  if defined(ICE_FFI_MICROSOFT)
+            WaitForSingleObject(handles[i], INFINITE);
+            CloseHandle(handles[i]);
+#  else
+            pthread_join(handles[i], NULL);
+#  endif
+        }
+        
+        ICE_FS_FREE(handles);
+    }
+#endif
+    
+    ICE_FS_COND_FREE(&pool.cond);
+    ICE_FS_LOCK_FREE(&pool.lock);
+    ICE_FS_FREE(pool.tasks);
+    return pool.entries;
+}
+
+#if !defined(ICE_FFI_MICROSOFT)
+#  if defined(__linux__) && !defined(FICLONE)
+#    define FICLONE _IOW(0x94, 9, int)
+#  endif
+
+// Writes all of buffer, Retrying short and interrupted writes
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_write_all(int fd, char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return ICE_FS_FALSE;
+        }
+        
+        buf += n;
+        len -= (size_t) n;
+    }
+    
+    return ICE_FS_TRUE;
+}
+
+// Copies from current offset of in to end of file, Trying ways that keep data out of user space first
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_copy_fd(int in, int out, unsigned long long size) {
+    unsigned long long copied = 0;
+    char* buf;
+    
+#if defined(__linux__)
+    // Reflink shares extents of source (Btrfs, XFS, Bcachefs...), So no data is copied at all until one of files is changed
+    if (size > 0 && ioctl(out, FICLONE, in) == 0) return ICE_FS_TRUE;
+    
+#  if defined(ICE_FS_LINUX_SYSCALL) && defined(SYS_copy_file_range)
+    // Copy stays inside kernel, And file systems like NFS or SMB copy on server side
+    while (copied < size) {
+        long n = (long) syscall(SYS_copy_file_range, in, NULL, out, NULL, (size_t) (size - copied), 0);
+        
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        
+        copied += (unsigned long long) n;
+    }
+#  endif
+    
+    // Older kernels don't copy_file_range across file systems, sendfile still copies inside kernel
+    while (copied < size) {
+        ssize_t n = sendfile(out, in, NULL, (size_t) (size - copied));
+        
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        
+        copied += (unsigned long long) n;
+    }
+#endif
+    
+    // Whatever is left (Or all of file elsewhere) goes through buffer, Reading until end of file as size could be stale
+    buf = (char*) ICE_FS_MALLOC(ICE_FS_COPY_BUFFER);
+    if (buf == NULL) return ICE_FS_FALSE;
+    
+    for (;;) {
+        ssize_t n = read(in, buf, ICE_FS_COPY_BUFFER);
+        
+        if (n < 0 && errno == EINTR) continue;
+        
+        if (n < 0 || ice_fs_write_all(out, buf, (size_t) n) == ICE_FS_FALSE) {
+            ICE_FS_FREE(buf);
+            return ICE_FS_FALSE;
+        }
+        
+        if (n == 0) break;
+    }
+    
+    ICE_FS_FREE(buf);
+    return ICE_FS_TRUE;
+}
+#endif
+
+// Replaces d2 if it exists, Mode bits of d1 are kept (Fails if d1 and d2 are same file)
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_copy_file(char* d1, char* d2) {
+#if defined(ICE_FFI_MICROSOFT)
+    // CopyFile copies inside system (And on server side for network shares), Attributes are kept
+    return (CopyFileA(d1, d2, FALSE)) ? ICE_FS_TRUE : ICE_FS_FALSE;
+#else
+    struct stat st, ost;
+    int in, out;
+    ice_fs_bool res;
+    
+#  if defined(O_CLOEXEC)
+    in = open(d1, O_RDONLY | O_CLOEXEC);
+#  else
+    in = open(d1, O_RDONLY);
+#  endif
+
+    if (in < 0) return ICE_FS_FALSE;
+    
+    if (fstat(in, &st) < 0 || S_ISDIR(st.st_mode)) {
+        close(in);
+        return ICE_FS_FALSE;
+    }
+    
+    // No O_TRUNC, d2 could be d1 under another name (Hard link, Symbolic link, "./"...) and truncating it would lose source
+#  if defined(O_CLOEXEC)
+    out = open(d2, O_WRONLY | O_CREAT | O_CLOEXEC, st.st_mode & 07777);
+#  else
+    out = open(d2, O_WRONLY | O_CREAT, st.st_mode & 07777);
+#  endif
+
+    if (out < 0) {
+        close(in);
+        return ICE_FS_FALSE;
+    }
+    
+    // Same file is left as is, So it isn't unlinked below either
+    if (fstat(out, &ost) < 0 || (ost.st_dev == st.st_dev && ost.st_ino == st.st_ino)) {
+        close(in);
+        close(out);
+        return ICE_FS_FALSE;
+    }
+    
+    res = (ftruncate(out, 0) < 0) ? ICE_FS_FALSE : ice_fs_copy_fd(in, out, (unsigned long long) st.st_size);
+    
+    // open applies umask and leaves mode of existing file as is, So mode is set again
+    if (res == ICE_FS_TRUE && fchmod(out, st.st_mode & 07777) < 0) res = ICE_FS_FALSE;
+    
+    close(in);
+    if (close(out) < 0) res = ICE_FS_FALSE;
+    
+    // Half-copied file is worse than none
+    if (res == ICE_FS_FALSE) unlink(d2);
+    return res;
+#endif
+}
+
+typedef struct ice_fs_copy_job {
+    char* src;
+    char* dst;                      // Points into same allocation as src
+} ice_fs_copy_job;
+
+#if !defined(ICE_FFI_MICROSOFT)
+typedef struct ice_fs_copy_mode {
+    char* dir;
+    mode_t mode;
+} ice_fs_copy_mode;
+#endif
+
+// Files found by walker wait here for copy threads, So listing of tree and copying of files overlap
+typedef struct ice_fs_copy_pool {
+    ice_fs_copy_job* jobs;
+    int count;
+    int cap;
+    int done;                       // 1 once walker found all files
+    int failed;
+    ice_fs_lock lock;
+    ice_fs_cond cond;
+#if !defined(ICE_FFI_MICROSOFT)
+    ice_fs_copy_mode* dirs;         // Created directories (Used by walking thread only)
+    int dirs_count;
+    int dirs_cap;
+#endif
+} ice_fs_copy_pool;
+
+ICE_FS_API void ICE_FS_CALLCONV ice_fs_copy_work(ice_fs_copy_pool* pool) {
+    ICE_FS_LOCK(&pool->lock);
+    
+    for (;;) {
+        ice_fs_copy_job job;
+        ice_fs_bool res;
+        
+        while (pool->count == 0 && !pool->done) ICE_FS_COND_WAIT(&pool->cond, &pool->lock);
+        
+        if (pool->count == 0) break;
+        
+        job = pool->jobs[--pool->count];
+        ICE_FS_UNLOCK(&pool->lock);
+        
+        res = ice_fs_copy_file(job.src, job.dst);
+        ICE_FS_FREE(job.src);
+        
+        ICE_FS_LOCK(&pool->lock);
+        if (res == ICE_FS_FALSE) pool->failed = 1;
+    }
+    
+    ICE_FS_UNLOCK(&pool->lock);
+}
+
+#if !defined(ICE_FS_NO_THREADS)
+#  if defined(ICE_FFI_MICROSOFT)
+static DWORD WINAPI ice_fs_copy_thread(LPVOID pool) {
+    ice_fs_copy_work((ice_fs_copy_pool*) pool);
+    return 0;
+}
+#  else
+static void* ice_fs_copy_thread(void* pool) {
+    ice_fs_copy_work((ice_fs_copy_pool*) pool);
+    return NULL;
+}
+#  endif
+#endif
+
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_copy_dir_create(char* src, char* dst, ice_fs_copy_pool* pool) {
+#if defined(ICE_FFI_MICROSOFT)
+    (void) src;
+    (void) pool;
+    return (CreateDirectoryA(dst, NULL) || GetLastError() == ERROR_ALREADY_EXISTS) ? ICE_FS_TRUE : ICE_FS_FALSE;
+#else
+    struct stat st;
+    size_t len = strlen(dst) + 1;
+    
+    // Owner keeps write access until contents are copied, Exact mode is set once copy is done
+    if (stat(src, &st) < 0) return ICE_FS_FALSE;
+    if (mkdir(dst, (st.st_mode & 07777) | S_IRWXU) < 0 && errno != EEXIST) return ICE_FS_FALSE;
+    
+    if (pool->dirs_count == pool->dirs_cap) {
+        int grown_cap = (pool->dirs_cap == 0) ? 16 : pool->dirs_cap * 2;
+        ice_fs_copy_mode* grown = (ice_fs_copy_mode*) ICE_FS_REALLOC(pool->dirs, grown_cap * sizeof(ice_fs_copy_mode));
+        
+        if (grown == NULL) return ICE_FS_FALSE;
+        
+        pool->dirs = grown;
+        pool->dirs_cap = grown_cap;
+    }
+    
+    pool->dirs[pool->dirs_count].dir = (char*) ICE_FS_MALLOC(len);
+    if (pool->dirs[pool->dirs_count].dir == NULL) return ICE_FS_FALSE;
+    
+    memcpy(pool->dirs[pool->dirs_count].dir, dst, len);
+    pool->dirs[pool->dirs_count].mode = st.st_mode & 07777;
+    pool->dirs_count++;
+    return ICE_FS_TRUE;
+#endif
+}
+
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_copy_dir_entry(ice_fs_walk_entry* entry, char* dst, ice_fs_copy_pool* pool, int threaded) {
+    if (entry->type == ICE_FS_ENTRY_DIR) return ice_fs_copy_dir_create(entry->path, dst, pool);
+    
+#if !defined(ICE_FFI_MICROSOFT)
+    // Links are copied as links, Like cp -R does
+    if (entry->type == ICE_FS_ENTRY_LINK) {
+        char target[4096];
+        ssize_t len = readlink(entry->path, target, sizeof(target) - 1);
+        
+        if (len < 0) return ICE_FS_FALSE;
+        
+        target[len] = '\0';
+        unlink(dst);
+        return (symlink(target, dst) < 0) ? ICE_FS_FALSE : ICE_FS_TRUE;
+    }
+#endif
+    
+    // Devices, Pipes and sockets are not copied
+    if (entry->type == ICE_FS_ENTRY_OTHER) return ICE_FS_TRUE;
+    
+    if (!threaded) return ice_fs_copy_file(entry->path, dst);
+    
+    {
+        size_t src_len = strlen(entry->path) + 1;
+        size_t dst_len = strlen(dst) + 1;
+        char* paths = (char*) ICE_FS_MALLOC(src_len + dst_len);
+        
+        if (paths == NULL) return ICE_FS_FALSE;
+        
+        memcpy(paths, entry->path, src_len);
+        memcpy(paths + src_len, dst, dst_len);
+        
+        ICE_FS_LOCK(&pool->lock);
+        
+        if (pool->count == pool->cap) {
+            int grown_cap = (pool->cap == 0) ? 64 : pool->cap * 2;
+            ice_fs_copy_job* grown = (ice_fs_copy_job*) ICE_FS_REALLOC(pool->jobs, grown_cap * sizeof(ice_fs_copy_job));
+            
+            if (grown == NULL) {
+                ICE_FS_UNLOCK(&pool->lock);
+                ICE_FS_FREE(paths);
+                return ICE_FS_FALSE;
+            }
+            
+            pool->jobs = grown;
+            pool->cap = grown_cap;
+        }
+        
+        pool->jobs[pool->count].src = paths;
+        pool->jobs[pool->count].dst = paths + src_len;
+        pool->count++;
+        ICE_FS_COND_WAKE(&pool->cond);
+        ICE_FS_UNLOCK(&pool->lock);
+    }
+    
+    return ICE_FS_TRUE;
+}
+
+// Returns 1 if path is dir itself or inside it (path doesn't have to exist yet), Used to refuse copying directory into itself
+ICE_FS_API int ICE_FS_CALLCONV ice_fs_path_inside(char* dir, char* path) {
+#if defined(ICE_FFI_MICROSOFT)
+    // Full paths are made by text (".." is resolved), Names are case insensitive
+    char full_dir[MAX_PATH];
+    char full_path[MAX_PATH];
+    DWORD len = GetFullPathNameA(dir, MAX_PATH, full_dir, NULL);
+    DWORD path_len = GetFullPathNameA(path, MAX_PATH, full_path, NULL);
+    
+    if (len == 0 || len >= MAX_PATH || path_len == 0 || path_len >= MAX_PATH) return 0;
+    
+    while (len > 0 && (full_dir[len - 1] == '\\' || full_dir[len - 1] == '/')) len--;
+    
+    return (_strnicmp(full_dir, full_path, len) == 0 && (full_path[len] == '\0' || full_path[len] == '\\' || full_path[len] == '/')) ? 1 : 0;
+#else
+    struct stat d, st, up;
+    size_t len = strlen(path);
+    size_t cap = len + 64;
+    char* buf = (char*) ICE_FS_MALLOC(cap);
+    int res = 0;
+    
+    if (buf == NULL || stat(dir, &d) < 0) {
+        ICE_FS_FREE(buf);
+        return 0;
+    }
+    
+    // Deepest part of path that exists, Rest of it would be created inside that
+    memcpy(buf, path, len + 1);
+    
+    while (stat(buf, &st) < 0) {
+        if (strcmp(buf, ".") == 0) {
+            ICE_FS_FREE(buf);
+            return 0;
+        }
+        
+        while (len > 1 && buf[len - 1] == '/') len--;
+        while (len > 0 && buf[len - 1] != '/') len--;
+        while (len > 1 && buf[len - 1] == '/') len--;
+        
+        if (len == 0) buf[len++] = '.';
+        buf[len] = '\0';
+    }
+    
+    // Ancestors are reached through "..", So links and ".." in path can't hide dir (Root is its own parent)
+    for (;;) {
+        if (st.st_dev == d.st_dev && st.st_ino == d.st_ino) {
+            res = 1;
+            break;
+        }
+        
+        if (len + 4 > cap) {
+            char* grown = (char*) ICE_FS_REALLOC(buf, cap * 2);
+            if (grown == NULL) break;
+            buf = grown;
+            cap *= 2;
+        }
+        
+        memcpy(buf + len, "/..", 4);
+        len += 3;
+        
+        if (stat(buf, &up) < 0 || (up.st_dev == st.st_dev && up.st_ino == st.st_ino)) break;
+        st = up;
+    }
+    
+    ICE_FS_FREE(buf);
+    return res;
+#endif
+}
+
+// Copies directory d1 and all of its contents as d2 (Created if it doesn't exist), Files are copied on ICE_FS_COPY_THREADS threads while tree is walked
+// (Fails if d2 is d1 or inside it, Else copy would walk into its own output)
+ICE_FS_API ice_fs_bool ICE_FS_CALLCONV ice_fs_copy_dir(char* d1, char* d2) {
+    ice_fs_walk_options opts = ice_fs_walk_options_default();
+    ice_fs_walk_entry entry;
+    ice_fs_walker walker;
+    ice_fs_copy_pool pool;
+    size_t len1 = strlen(d1);
+    int base = (int) strlen(d2);
+    int dst_cap = base + 256;
+    char* dst;
+    int ok = 1;
+    int started = 0;
+#if !defined(ICE_FS_NO_THREADS)
+#  if defined(ICE_FFI_MICROSOFT)
+    HANDLE handles[ICE_FS_COPY_THREADS];
+#  else
+    pthread_t handles[ICE_FS_COPY_THREADS];
+#  endif
+#endif
+    
+    opts.dirs = 1;
+    memset(&pool, 0, sizeof(ice_fs_copy_pool));
+    
+    if (ice_fs_path_inside(d1, d2)) return ICE_FS_FALSE;
+    if (ice_fs_walk_open(d1, &opts, &walker) == ICE_FS_FALSE) return ICE_FS_FALSE;
+    
+    dst = (char*) ICE_FS_MALLOC(dst_cap);
+    
+    if (dst == NULL || ice_fs_copy_dir_create(d1, d2, &pool) == ICE_FS_FALSE) {
+        ICE_FS_FREE(dst);
+        ice_fs_walk_close(&walker);
+        return ICE_FS_FALSE;
+    }
+    
+    memcpy(dst, d2, base + 1);
+    ICE_FS_LOCK_INIT(&pool.lock);
+    ICE_FS_COND_INIT(&pool.cond);
+    
+#if !defined(ICE_FS_NO_THREADS)
+    for (int i = 0; i < ICE_FS_COPY_THREADS; i++) {
+#  if defined(ICE_FFI_MICROSOFT)
+        handles[started] = CreateThread(NULL, 0, ice_fs_copy_thread, &pool, 0, NULL);
+        if (handles[started] != NULL) started++;
+#  else
+        if (pthread_create(&handles[started], NULL, ice_fs_copy_thread, &pool) == 0) started++;
+#  endif
+    }
+#endif
+    
+    // Walk is pre-order, So directory is always created before files inside it are queued
+    while (ice_fs_walk_next(&walker, &entry) == ICE_FS_TRUE) {
+        char* rel = entry.path + len1;
+        
+        while (*rel == '/' || *rel == '\\') rel++;
+        
+        if (ice_fs_path_join_at(&dst, &dst_cap, base, rel) < 0 || ice_fs_copy_dir_entry(&entry, dst, &pool, started > 0) == ICE_FS_FALSE) {
+            ok = 0;
+            
+            // Files of directory that couldn't be created would fail anyway
+            if (entry.type == ICE_FS_ENTRY_DIR) ice_fs_walk_skip(&walker);
+        }
+    }
+    
+    ice_fs_walk_close(&walker);
+    ICE_FS_FREE(dst);
+    
+    ICE_FS_LOCK(&pool.lock);
+    pool.done = 1;
+    ICE_FS_COND_WAKE_ALL(&pool.cond);
+    ICE_FS_UNLOCK(&pool.lock);
+    
+#if !defined(ICE_FS_NO_THREADS)
+    for (int i = 0; i < started; i++) {
+#  if defined(ICE_FFI_MICROSOFT)
+        WaitForSingleObject(handles[i], INFINITE);
+        CloseHandle(handles[i]);
+#  else
+        pthread_join(handles[i], NULL);
+#  endif
+    }
+#endif
+    
+    if (pool.failed) ok = 0;
+    
+    ICE_FS_COND_FREE(&pool.cond);
+    ICE_FS_LOCK_FREE(&pool.lock);
+    ICE_FS_FREE(pool.jobs);
+    
+#if !defined(ICE_FFI_MICROSOFT)
+    // Deepest directories first, As parent could be made read-only
+    for (int i = pool.dirs_count - 1; i >= 0; i--) {
+        if (chmod(pool.dirs[i].dir, pool.dirs[i].mode) < 0) ok = 0;
+        ICE_FS_FREE(pool.dirs[i].dir);
+    }
+    
+    ICE_FS_FREE(pool.dirs);
+#endif
+
+    return ok ? ICE_FS_TRUE : ICE_FS_FALSE;
+}
+
 #endif  // ICE_FS_IMPL
 #endif  // ICE_FS_H
@@ -182,6 +182,24 @@ THE SOFTWARE.
 #endif
 
 // Custom memory allocators
+// (Define ICE_MATH_USE_ARENA to allocate from arena pushed by ice_arena_push, ice_arena.h must be included before ice_math.h with ICE_ARENA_IMPL)
+#if defined(ICE_MATH_USE_ARENA)
+#  if !defined(ICE_ARENA_H)
+#    error "ICE_MATH_USE_ARENA requires ice_arena.h to be included before ice_math.h"
+#  endif
+#  ifndef ICE_MATH_MALLOC
+#    define ICE_MATH_MALLOC(sz) ice_arena_scope_malloc(sz)
+#  endif
+#  ifndef ICE_MATH_CALLOC
+#    define ICE_MATH_CALLOC(n, sz) ice_arena_scope_calloc(n, sz)
+#  endif
+#  ifndef ICE_MATH_REALLOC
+#    define ICE_MATH_REALLOC(ptr, sz) ice_arena_scope_realloc(ptr, sz)
+#  endif
+#  ifndef ICE_MATH_FREE
+#    define ICE_MATH_FREE(ptr) ice_arena_scope_free(ptr)
+#  endif
+#endif
 #ifndef ICE_MATH_MALLOC
 #  define ICE_MATH_MALLOC(sz) malloc(sz)
 #endif
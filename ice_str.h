@@ -141,6 +141,15 @@ THE SOFTWARE.
 #  define ICE_STR_CALLCONV
 #endif
 
+// Keeps internal helpers out of callers, So constant arguments of caller don't reach code paths they can't take
+#if defined(__GNUC__) || defined(__GNUG__) || defined(__clang__)
+#  define ICE_STR_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#  define ICE_STR_NOINLINE __declspec(noinline)
+#else
+#  define ICE_STR_NOINLINE
+#endif
+
 // Platform detection
 #if !defined(ICE_STR_MICROSOFT)
 #  if defined(__WIN) || defined(_WIN32_) || defined(_WIN64_) || defined(WIN32) || defined(__WIN32__) || defined(WIN64) || defined(__WIN64__) || defined(WINDOWS) || defined(_WINDOWS) || defined(__WINDOWS) || defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__) || defined(_MSC_VER) || defined(__WINDOWS__) || defined(_X360) || defined(XBOX360) || defined(__X360) || defined(__X360__) || defined(_XBOXONE) || defined(XBONE) || defined(XBOX) || defined(__XBOX__) || defined(__XBOX) || defined(__xbox__) || defined(__xbox) || defined(_XBOX) || defined(xbox)
@@ -177,6 +186,24 @@ THE SOFTWARE.
 #endif
 
 // Custom memory allocators
+// (Define ICE_STR_USE_ARENA to allocate from arena pushed by ice_arena_push, ice_arena.h must be included before ice_str.h with ICE_ARENA_IMPL)
+#if defined(ICE_STR_USE_ARENA)
+#  if !defined(ICE_ARENA_H)
+#    error "ICE_STR_USE_ARENA requires ice_arena.h to be included before ice_str.h"
+#  endif
+#  ifndef ICE_STR_MALLOC
+#    define ICE_STR_MALLOC(sz) ice_arena_scope_malloc(sz)
+#  endif
+#  ifndef ICE_STR_CALLOC
+#    define ICE_STR_CALLOC(n, sz) ice_arena_scope_calloc(n, sz)
+#  endif
+#  ifndef ICE_STR_REALLOC
+#    define ICE_STR_REALLOC(ptr, sz) ice_arena_scope_realloc(ptr, sz)
+#  endif
+#  ifndef ICE_STR_FREE
+#    define ICE_STR_FREE(ptr) ice_arena_scope_free(ptr)
+#  endif
+#endif
 #ifndef ICE_STR_MALLOC
 #  define ICE_STR_MALLOC(sz) malloc(sz)
 #endif
@@ -190,6 +217,64 @@ THE SOFTWARE.
 #  define ICE_STR_FREE(ptr) free(ptr)
 #endif
 
+// SIMD kernels used by scanning functions (Define ICE_STR_NO_SIMD to only use scalar code, Useful for ANSI C targets)
+// SSE2 and NEON are used when compiler targets them, AVX2 is compiled in and picked at runtime if CPU supports it
+#if !defined(ICE_STR_NO_SIMD)
+#  if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ICE_STR_SSE2
+#    if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#      define ICE_STR_AVX2
+#    endif
+#  elif defined(__aarch64__) || defined(_M_ARM64)
+#    define ICE_STR_NEON
+#  endif
+#endif
+
+#if defined(ICE_STR_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#  define ICE_STR_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#  define ICE_STR_TARGET_AVX2
+#endif
+
+// Strings of ice_str_buf up to this length are stored inside struct itself without allocating
+#ifndef ICE_STR_SSO_CAP
+#  define ICE_STR_SSO_CAP 23
+#endif
+
+// Capacity multiplier used when ice_str_buf needs to grow (Must be bigger than 1)
+#ifndef ICE_STR_GROWTH_FACTOR
+#  define ICE_STR_GROWTH_FACTOR 1.5
+#endif
+
+// Substrings at least this long are searched with Boyer-Moore-Horspool instead of SIMD first/last char filter
+// (Skips of BMH only beat SIMD filter when substring is much longer than vector and text has many distinct chars)
+#ifndef ICE_STR_BMH_MIN
+#  define ICE_STR_BMH_MIN 256
+#endif
+
+// Size of first chunk of ice_str_builder (Next chunks are as big as whole built string so far)
+#ifndef ICE_STR_BUILDER_CHUNK
+#  define ICE_STR_BUILDER_CHUNK 256
+#endif
+
+// Max chars stored in one leaf of ice_str_rope
+#ifndef ICE_STR_ROPE_LEAF
+#  define ICE_STR_ROPE_LEAF 1024
+#endif
+
+// Size of storage blocks interned strings are copied to
+#ifndef ICE_STR_INTERN_BLOCK
+#  define ICE_STR_INTERN_BLOCK 65536
+#endif
+
+// Count of shards (Each with own lock) of ice_str_intern_sharded (Must be power of 2)
+#ifndef ICE_STR_INTERN_SHARDS
+#  define ICE_STR_INTERN_SHARDS 16
+#endif
+
+// Size of buffer ice_str_fmt_f64 and ice_str_fmt_i64 need (Longest output like -1.2345678901234567e-308 plus NUL)
+#define ICE_STR_FMT_NUM_MAX 32
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -202,6 +287,108 @@ typedef enum {
     ICE_STR_FALSE   = -1,
 } ice_str_bool;
 
+typedef enum {
+    ICE_STR_SIMD_NONE = 0,  // Scalar code
+    ICE_STR_SIMD_SSE2,      // 16 bytes per instruction
+    ICE_STR_SIMD_AVX2,      // 32 bytes per instruction
+    ICE_STR_SIMD_NEON,      // 16 bytes per instruction (AArch64)
+} ice_str_simd;
+
+// Non-owning string slice (Points into memory of existing string, Not NUL-terminated, Never freed)
+typedef struct ice_str_view {
+    char* ptr;                              // Points to first char of view
+    int len;                                // View length
+} ice_str_view;
+
+// Tokenizer state, Yields views into str so splitting allocates nothing
+typedef struct ice_str_tok {
+    char* str;                              // Text being split (Not copied, Must stay valid while tokenizing)
+    int len;                                // Text length
+    int pos;                                // Index where next token starts
+    char delim;                             // Delimiter
+} ice_str_tok;
+
+// Length-prefixed string, Length is known without scanning and appending grows memory geometrically
+// Short strings (Up to ICE_STR_SSO_CAP bytes) live inside struct, Use ice_str_buf_cstr to get NUL-terminated string
+typedef struct ice_str_buf {
+    int len;                                // String length
+    int cap;                                // Bytes that could be stored without growing (ICE_STR_SSO_CAP while string is inside struct)
+    union {
+        char* heap;                         // Allocated by ICE_STR_MALLOC when cap > ICE_STR_SSO_CAP
+        char sso[ICE_STR_SSO_CAP + 1];      // Used when cap == ICE_STR_SSO_CAP
+    } data;
+} ice_str_buf;
+
+// Match reported by ice_str_matcher
+typedef struct ice_str_hit {
+    int pattern;                            // Index of pattern in array matcher was created from
+    int pos;                                // Index where match starts in text
+    int len;                                // Match length
+} ice_str_hit;
+
+// Aho-Corasick automaton compiled from set of patterns, Text is scanned once whatever count of patterns is
+// Bytes are grouped into classes (All bytes not used by any pattern share class 0), So each state needs one row of classes
+typedef struct ice_str_matcher {
+    int* next;                              // Transitions, next[state + class] is next state premultiplied by classes (~state if it has matches)
+    int* out;                               // First pattern that ends at state, Or -1
+    int* dict;                              // Nearest state on failure chain that has patterns, Or 0
+    int* link;                              // Next pattern that ends at same state as pattern (Duplicates), Or -1
+    int* lens;                              // Pattern lengths
+    int states;                             // Count of states
+    int classes;                            // Count of byte classes
+    int count;                              // Count of patterns
+    unsigned char cls[256];                 // Class of each byte
+} ice_str_matcher;
+
+typedef struct ice_str_builder_chunk {
+    struct ice_str_builder_chunk* next;     // Next chunk, NULL for last one
+    char* data;                             // Chars (Allocated with room for NUL after cap chars)
+    int len;                                // Chars used
+    int cap;                                // Chars that fit in chunk
+} ice_str_builder_chunk;
+
+// String builder, Appended chars go to list of chunks so they're never moved until final flatten
+typedef struct ice_str_builder {
+    ice_str_builder_chunk* head;            // First chunk
+    ice_str_builder_chunk* tail;            // Chunk being filled
+    int len;                                // Count of chars in all chunks
+} ice_str_builder;
+
+// Rope node, Leaves store up to ICE_STR_ROPE_LEAF chars right after node
+typedef struct ice_str_rope_node {
+    struct ice_str_rope_node* left;         // Left child, NULL for leaves
+    struct ice_str_rope_node* right;        // Right child, NULL for leaves
+    int len;                                // Count of chars in subtree
+    int depth;                              // Height of subtree (0 for leaves)
+} ice_str_rope_node;
+
+// Text stored as balanced tree of leaves, Inserting or removing in middle costs O(log n) instead of moving whole text
+typedef struct ice_str_rope {
+    ice_str_rope_node* root;                // NULL when rope is empty
+} ice_str_rope;
+
+typedef struct ice_str_intern_slot {
+    unsigned long long hash;                // Hash of string (Compared before string itself)
+    char* str;                              // Interned string, NULL for empty slot
+} ice_str_intern_slot;
+
+// Interning pool, Equal strings get same pointer (Handle) so comparing them is pointer comparison
+// Strings are copied to storage blocks and stay at same address until pool is freed
+typedef struct ice_str_intern_pool {
+    ice_str_intern_slot* slots;             // Open addressing table (Linear probing, Capacity is power of 2)
+    int cap;                                // Count of slots
+    int count;                              // Count of interned strings
+    char* block;                            // Storage block being filled (Blocks are chained through their first pointer)
+    int block_used;                         // Bytes used in storage block
+    int block_size;                         // Size of storage block
+} ice_str_intern_pool;
+
+// Thread-safe interning pool, Strings are spread over shards by hash so threads rarely wait for same lock
+typedef struct ice_str_intern_sharded {
+    ice_str_intern_pool shards[ICE_STR_INTERN_SHARDS];
+    void* locks;                            // One lock per shard (Allocated by ice_str_intern_sharded_new, NULL with ICE_STR_NO_THREADS)
+} ice_str_intern_sharded;
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 // ice_str FUNCTIONS
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -226,6 +413,161 @@ ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_end_char(char* str, char ch
 ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_rev(char* str);
 ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_free(char* str);
 ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_arr_free(char** arr);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_upper_in_place(char* str);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_lower_in_place(char* str);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_capitalize_in_place(char* str);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_match_nocase(char* s1, char* s2);
+ICE_STR_API  unsigned long long ICE_STR_CALLCONV ice_str_hash_nocase(char* str);
+ICE_STR_API  unsigned long long ICE_STR_CALLCONV ice_str_hash(char* str);
+ICE_STR_API  unsigned long long ICE_STR_CALLCONV ice_str_hash_len(char* str, int len);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_find_char(char* str, char ch);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_count_char(char* str, char ch);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_count_lines(char* str);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_find(char* str, char* sub);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_rfind(char* str, char* sub);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_contains(char* str, char* sub);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_count(char* str, char* sub);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_replace(char* str, char* sub, char* rep);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_is_ascii(char* str);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_utf8_valid(char* str);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_utf8_valid_len(char* str, int len);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_utf8_len(char* str);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_utf8_offset(char* str, int index);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_utf8_codepoint(char* str, int index);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_utf8_encode(int codepoint, char* res);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_utf8_char(char* str, int index);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_utf8_sub(char* str, int from, int to);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_utf8_rev(char* str);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_parse_f64(char* str, int len, double* res);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_parse_i64(char* str, int len, long long* res);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_fmt_f64(double num, char* res);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_fmt_i64(long long num, char* res);
+ICE_STR_API  ice_str_simd  ICE_STR_CALLCONV  ice_str_simd_level(void);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_simd_set_level(ice_str_simd level);
+
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_new(void);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_from(char* str);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_from_len(char* str, int len);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_buf_cstr(const ice_str_buf* buf);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_buf_to_str(const ice_str_buf* buf);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_buf_len(const ice_str_buf* buf);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_reserve(ice_str_buf* buf, int cap);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_append(ice_str_buf* buf, char* str);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_append_len(ice_str_buf* buf, char* str, int len);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_append_buf(ice_str_buf* buf, const ice_str_buf* other);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_append_char(ice_str_buf* buf, char ch);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_buf_clear(ice_str_buf* buf);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_sub(const ice_str_buf* buf, int from, int to);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_clone(const ice_str_buf* buf);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_concat(const ice_str_buf* b1, const ice_str_buf* b2);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_rep(const ice_str_buf* buf, int count);
+ICE_STR_API  char          ICE_STR_CALLCONV  ice_str_buf_char(const ice_str_buf* buf, int index);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_match(const ice_str_buf* b1, const ice_str_buf* b2);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_upper(const ice_str_buf* buf);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_lower(const ice_str_buf* buf);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_capitalize(const ice_str_buf* buf);
+ICE_STR_API  ice_str_buf*  ICE_STR_CALLCONV  ice_str_buf_split(const ice_str_buf* buf, char delim, int* count);
+ICE_STR_API  ice_str_buf*  ICE_STR_CALLCONV  ice_str_buf_splitlines(const ice_str_buf* buf, int* count);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_join(const ice_str_buf* bufs, int count);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_join_with_delim(const ice_str_buf* bufs, int count, char delim);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_begin(const ice_str_buf* b1, const ice_str_buf* b2);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_end(const ice_str_buf* b1, const ice_str_buf* b2);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_end_char(const ice_str_buf* buf, char ch);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_rev(const ice_str_buf* buf);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_buf_free(ice_str_buf* buf);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_buf_upper_in_place(ice_str_buf* buf);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_buf_lower_in_place(ice_str_buf* buf);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_buf_find_char(const ice_str_buf* buf, char ch);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_buf_count_char(const ice_str_buf* buf, char ch);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_buf_find(const ice_str_buf* buf, const ice_str_buf* sub);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_buf_rfind(const ice_str_buf* buf, const ice_str_buf* sub);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_buf_count(const ice_str_buf* buf, const ice_str_buf* sub);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_buf_replace(const ice_str_buf* buf, const ice_str_buf* sub, const ice_str_buf* rep);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_buf_arr_free(ice_str_buf* bufs, int count);
+
+ICE_STR_API  ice_str_view  ICE_STR_CALLCONV  ice_str_view_of(char* str);
+ICE_STR_API  ice_str_view  ICE_STR_CALLCONV  ice_str_view_from_len(char* str, int len);
+ICE_STR_API  ice_str_view  ICE_STR_CALLCONV  ice_str_view_of_buf(const ice_str_buf* buf);
+ICE_STR_API  ice_str_view  ICE_STR_CALLCONV  ice_str_view_sub(ice_str_view view, int from, int to);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_view_match(ice_str_view v1, ice_str_view v2);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_view_match_str(ice_str_view view, char* str);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_view_find_char(ice_str_view view, char ch);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_view_find(ice_str_view view, ice_str_view sub);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_view_rfind(ice_str_view view, ice_str_view sub);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_view_count(ice_str_view view, ice_str_view sub);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_view_match_nocase(ice_str_view v1, ice_str_view v2);
+ICE_STR_API  unsigned long long ICE_STR_CALLCONV ice_str_view_hash_nocase(ice_str_view view);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_view_to_str(ice_str_view view);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_view_to_buf(ice_str_view view);
+ICE_STR_API  ice_str_tok   ICE_STR_CALLCONV  ice_str_tok_new(char* str, char delim);
+ICE_STR_API  ice_str_tok   ICE_STR_CALLCONV  ice_str_tok_new_len(char* str, int len, char delim);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_tok_next(ice_str_tok* tok, ice_str_view* res);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_tok_next_batch(ice_str_tok* tok, ice_str_view* res, int max);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_split_views(char* str, char delim, ice_str_view* res, int max);
+
+ICE_STR_API  ice_str_matcher ICE_STR_CALLCONV ice_str_matcher_new(char** patterns);
+ICE_STR_API  ice_str_matcher ICE_STR_CALLCONV ice_str_matcher_new_nocase(char** patterns);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_matcher_any(const ice_str_matcher* m, char* str);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_matcher_first(const ice_str_matcher* m, char* str, ice_str_hit* hit);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_matcher_scan(const ice_str_matcher* m, char* str, ice_str_hit* res, int max);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_matcher_scan_view(const ice_str_matcher* m, ice_str_view view, ice_str_hit* res, int max);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_matcher_free(ice_str_matcher* m);
+
+ICE_STR_API  ice_str_builder ICE_STR_CALLCONV ice_str_builder_new(void);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append(ice_str_builder* b, char* str);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_len(ice_str_builder* b, char* str, int len);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_char(ice_str_builder* b, char ch);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_view(ice_str_builder* b, ice_str_view view);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_buf(ice_str_builder* b, const ice_str_buf* buf);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_int(ice_str_builder* b, long long num);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_uint(ice_str_builder* b, unsigned long long num);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_hex(ice_str_builder* b, unsigned long long num);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_append_double(ice_str_builder* b, double num, int precision);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_builder_appendf(ice_str_builder* b, const char* fmt, ...);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_builder_len(const ice_str_builder* b);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_builder_to_str(const ice_str_builder* b);
+ICE_STR_API  ice_str_buf   ICE_STR_CALLCONV  ice_str_builder_to_buf(const ice_str_builder* b);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_builder_finish(ice_str_builder* b);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_builder_clear(ice_str_builder* b);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_builder_free(ice_str_builder* b);
+
+ICE_STR_API  ice_str_rope  ICE_STR_CALLCONV  ice_str_rope_new(char* str);
+ICE_STR_API  ice_str_rope  ICE_STR_CALLCONV  ice_str_rope_new_len(char* str, int len);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_rope_len(const ice_str_rope* rope);
+ICE_STR_API  char          ICE_STR_CALLCONV  ice_str_rope_char(const ice_str_rope* rope, int index);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_rope_insert(ice_str_rope* rope, int pos, char* str);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_rope_insert_len(ice_str_rope* rope, int pos, char* str, int len);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_rope_append(ice_str_rope* rope, char* str);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_rope_erase(ice_str_rope* rope, int pos, int len);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_rope_splice(ice_str_rope* rope, int pos, ice_str_rope* other);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_rope_sub(const ice_str_rope* rope, int from, int to);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_rope_to_str(const ice_str_rope* rope);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_rope_free(ice_str_rope* rope);
+
+ICE_STR_API  unsigned long long ICE_STR_CALLCONV ice_str_view_hash(ice_str_view view);
+ICE_STR_API  unsigned long long ICE_STR_CALLCONV ice_str_buf_hash(const ice_str_buf* buf);
+ICE_STR_API  ice_str_intern_pool ICE_STR_CALLCONV ice_str_intern_pool_new(void);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_intern_pool_add(ice_str_intern_pool* pool, char* str);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_intern_pool_add_len(ice_str_intern_pool* pool, char* str, int len);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_intern_pool_find(const ice_str_intern_pool* pool, char* str);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_intern_pool_find_len(const ice_str_intern_pool* pool, char* str, int len);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_intern_pool_count(const ice_str_intern_pool* pool);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_intern_pool_free(ice_str_intern_pool* pool);
+ICE_STR_API  ice_str_intern_sharded ICE_STR_CALLCONV ice_str_intern_sharded_new(void);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_intern_sharded_add(ice_str_intern_sharded* sh, char* str);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_intern_sharded_add_len(ice_str_intern_sharded* sh, char* str, int len);
+ICE_STR_API  char*         ICE_STR_CALLCONV  ice_str_intern_sharded_find(ice_str_intern_sharded* sh, char* str);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_intern_sharded_count(ice_str_intern_sharded* sh);
+ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_intern_sharded_free(ice_str_intern_sharded* sh);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_intern_len(const char* handle);
+ICE_STR_API  unsigned long long ICE_STR_CALLCONV ice_str_intern_hash(const char* handle);
+
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_view_utf8_valid(ice_str_view view);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_view_utf8_len(ice_str_view view);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_buf_utf8_valid(const ice_str_buf* buf);
+ICE_STR_API  int           ICE_STR_CALLCONV  ice_str_buf_utf8_len(const ice_str_buf* buf);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_view_parse_f64(ice_str_view view, double* res);
+ICE_STR_API  ice_str_bool  ICE_STR_CALLCONV  ice_str_view_parse_i64(ice_str_view view, long long* res);
 
 #if defined(__cplusplus)
 }
@@ -235,359 +577,1189 @@ ICE_STR_API  void          ICE_STR_CALLCONV  ice_str_arr_free(char** arr);
 // ice_str IMPLEMENTATION
 ///////////////////////////////////////////////////////////////////////////////////////////
 #if defined(ICE_STR_IMPL)
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <float.h>
 
-ICE_STR_API int ICE_STR_CALLCONV ice_str_len(char* str) {
+#if !defined(ICE_STR_NO_THREADS)
+#  if defined(ICE_STR_MICROSOFT)
+#    include <windows.h>
+#  else
+#    include <pthread.h>
+#  endif
+#endif
+
+#if defined(ICE_STR_SSE2) || defined(ICE_STR_AVX2)
+#  include <emmintrin.h>
+#  if defined(ICE_STR_AVX2)
+#    include <immintrin.h>
+#  endif
+#elif defined(ICE_STR_NEON)
+#  include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+// Length kernels read whole aligned blocks, So they could read bytes past NUL character (But never past page holding it)
+// AddressSanitizer doesn't know that's safe, So it's disabled for them
+#if defined(__SANITIZE_ADDRESS__)
+#  define ICE_STR_NO_ASAN __attribute__((no_sanitize_address))
+#elif defined(__has_feature)
+#  if __has_feature(address_sanitizer)
+#    define ICE_STR_NO_ASAN __attribute__((no_sanitize_address))
+#  endif
+#endif
+#if !defined(ICE_STR_NO_ASAN)
+#  define ICE_STR_NO_ASAN
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_str KERNELS
+///////////////////////////////////////////////////////////////////////////////////////////
+// Scanning, Substring search, Case conversion and UTF-8 validation used by ice_str_len, ice_str_find_char, ice_str_count_char, ice_str_split, ice_str_upper, etc...
+// Every kernel exists as scalar code, And SIMD versions replace them if available.
+typedef struct ice_str_kernels {
+    int (*len)(const char* str);
+    int (*find)(const char* str, int n, char ch);
+    int (*count)(const char* str, int n, char ch);
+    int (*search)(const char* str, int n, const char* sub, int m);
+    void (*upper)(char* dst, const char* src, int n);
+    void (*lower)(char* dst, const char* src, int n);
+    int (*ascii)(const char* str, int n);
+    int (*utf8_len)(const char* str, int n);
+    ice_str_bool (*utf8_valid)(const char* str, int n);
+} ice_str_kernels;
+
+// ASCII case tables, Other bytes (Including UTF-8 ones) map to themselves
+static const unsigned char ice_str_upper_table[256] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F,
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F,
+    0x60, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F,
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x7B, 0x7C, 0x7D, 0x7E, 0x7F,
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F,
+    0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF,
+    0xB0, 0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xBB, 0xBC, 0xBD, 0xBE, 0xBF,
+    0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF,
+    0xD0, 0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xDB, 0xDC, 0xDD, 0xDE, 0xDF,
+    0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF,
+    0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF,
+};
+
+static const unsigned char ice_str_lower_table[256] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,
+    0x40, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F,
+    0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x7B, 0x7C, 0x7D, 0x7E, 0x7F,
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F,
+    0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF,
+    0xB0, 0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xBB, 0xBC, 0xBD, 0xBE, 0xBF,
+    0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF,
+    0xD0, 0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xDB, 0xDC, 0xDD, 0xDE, 0xDF,
+    0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF,
+    0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF,
+};
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_scalar_len(const char* str) {
     int len = 0;
     while (str[len] != '\0') len++;
     return len;
 }
 
-ICE_STR_API int ICE_STR_CALLCONV ice_str_arr_len(char** arr) {
-    int arrlen = 0;
-    while (arr[arrlen] != NULL) arrlen++;
-    return arrlen;
+ICE_STR_API int ICE_STR_CALLCONV ice_str_scalar_find(const char* str, int n, char ch) {
+    for (int i = 0; i < n; i++) {
+        if (str[i] == ch) return i;
+    }
+    
+    return -1;
 }
 
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_sub(char* str, int from, int to) {
-    char* res = (char*) ICE_STR_MALLOC((to - from) + 1 * sizeof(char));
-    int count = 0;
-
-    for (int i = from; i <= to; i++) {
-        res[count] = str[i];
-        count++;
+ICE_STR_API int ICE_STR_CALLCONV ice_str_scalar_count(const char* str, int n, char ch) {
+    int res = 0;
+    
+    for (int i = 0; i < n; i++) {
+        res += (str[i] == ch);
     }
-
-    res[count] = '\0';
+    
     return res;
 }
 
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_strdup(char* str) {
-    int len = ice_str_len(str);
-    char* res = (char*) ICE_STR_MALLOC(len + 1 * sizeof(char));
-
-    for (int i = 0; i < len; i++) {
-        res[i] = str[i];
+// Substring search for m >= 2, Position is only compared when both its first and last chars match
+ICE_STR_API int ICE_STR_CALLCONV ice_str_scalar_search(const char* str, int n, const char* sub, int m) {
+    char first = sub[0];
+    char last = sub[m - 1];
+    
+    for (int i = 0; i + m <= n; i++) {
+        if (str[i] == first && str[i + m - 1] == last && memcmp(str + i + 1, sub + 1, m - 2) == 0) return i;
     }
-
-    res[len] = '\0';
-    return res;
+    
+    return -1;
 }
 
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_concat(char* s1, char* s2) {
-    int len_str1 = ice_str_len(s1);
-    int len_str2 = ice_str_len(s2);
+// dst could be same as src (In-place conversion)
+ICE_STR_API void ICE_STR_CALLCONV ice_str_scalar_upper(char* dst, const char* src, int n) {
+    for (int i = 0; i < n; i++) {
+        dst[i] = (char) ice_str_upper_table[(unsigned char) src[i]];
+    }
+}
 
-    char* res = (char*) ICE_STR_MALLOC((len_str1 + len_str2) * sizeof(char));
-    for (int i = 0; i < len_str1; i++) {
-        res[i] = s1[i];
+ICE_STR_API void ICE_STR_CALLCONV ice_str_scalar_lower(char* dst, const char* src, int n) {
+    for (int i = 0; i < n; i++) {
+        dst[i] = (char) ice_str_lower_table[(unsigned char) src[i]];
     }
+}
 
-    for (int i = 0; i < len_str2; i++) {
-        res[len_str1 + i] = s2[i];
+// Index of first byte >= 0x80, Or n if all bytes are ASCII (Checks 8 bytes at once)
+ICE_STR_API int ICE_STR_CALLCONV ice_str_scalar_ascii(const char* str, int n) {
+    int i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        unsigned long long w;
+        memcpy(&w, str + i, 8);
+        if ((w & 0x8080808080808080ULL) != 0) break;
+    }
+    
+    for (; i < n; i++) {
+        if ((unsigned char) str[i] >= 0x80) return i;
     }
+    
+    return n;
+}
 
-    res[len_str1 + len_str2] = '\0';
+// Count of codepoints, Which is count of bytes that aren't continuation bytes (10xxxxxx)
+ICE_STR_API int ICE_STR_CALLCONV ice_str_scalar_utf8_len(const char* str, int n) {
+    int res = 0;
+    
+    for (int i = 0; i < n; i++) {
+        res += (((unsigned char) str[i] & 0xC0) != 0x80);
+    }
+    
     return res;
 }
 
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_rep(char* str, int count) {
-    int lenstr = ice_str_len(str);
-    char* res = (char*) ICE_STR_MALLOC((lenstr * count) + 1 * sizeof(char));
-    int times = 0;
+// Length of valid multi-byte sequence at s (First byte >= 0x80), Or 0 if it's invalid
+// Rejects overlong forms, Surrogates (U+D800 to U+DFFF) and codepoints above U+10FFFF
+ICE_STR_API int ICE_STR_CALLCONV ice_str_utf8_seq_len(const unsigned char* s, int n) {
+    unsigned char c = s[0];
+    
+    if (c >= 0xC2 && c <= 0xDF) {
+        return (n >= 2 && (s[1] & 0xC0) == 0x80) ? 2 : 0;
+    }
+    
+    if (c >= 0xE0 && c <= 0xEF) {
+        unsigned char lo = (c == 0xE0) ? 0xA0 : 0x80;
+        unsigned char hi = (c == 0xED) ? 0x9F : 0xBF;
+        return (n >= 3 && s[1] >= lo && s[1] <= hi && (s[2] & 0xC0) == 0x80) ? 3 : 0;
+    }
+    
+    if (c >= 0xF0 && c <= 0xF4) {
+        unsigned char lo = (c == 0xF0) ? 0x90 : 0x80;
+        unsigned char hi = (c == 0xF4) ? 0x8F : 0xBF;
+        return (n >= 4 && s[1] >= lo && s[1] <= hi && (s[2] & 0xC0) == 0x80 && (s[3] & 0xC0) == 0x80) ? 4 : 0;
+    }
+    
+    return 0;
+}
 
-    for (int i = 0; i < count; i++) {
-        for (int j = 0; j < lenstr; j++) {
-            res[(lenstr * i) + j] = str[j];
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_scalar_utf8_valid(const char* str, int n) {
+    const unsigned char* s = (const unsigned char*) str;
+    int i = 0;
+    
+    while (i < n) {
+        if (s[i] < 0x80) {
+            i += ice_str_scalar_ascii(str + i, n - i);
+            if (i == n) break;
         }
-
-        times++;
+        
+        int len = ice_str_utf8_seq_len(s + i, n - i);
+        if (len == 0) return ICE_STR_FALSE;
+        i += len;
     }
-
-    res[lenstr * count] = '\0';
-    return res;
+    
+    return ICE_STR_TRUE;
 }
 
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_char(char* str, int index) {
-    char* c = (char*) ICE_STR_MALLOC(2 * sizeof(char));
-    c[0] = str[index];
-    c[1] = '\0';
-    return c;
+#if defined(ICE_STR_SSE2) || defined(ICE_STR_AVX2) || defined(ICE_STR_NEON)
+// Index of lowest set bit (m must not be 0)
+ICE_STR_API int ICE_STR_CALLCONV ice_str_ctz(unsigned long long m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i;
+    _BitScanForward64(&i, m);
+    return (int) i;
+#else
+    return __builtin_ctzll(m);
+#endif
 }
+#endif
 
-ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_match(char* s1, char* s2) {
-    int len_str1 = ice_str_len(s1);
-    int len_str2 = ice_str_len(s2);
-    int matches = 0;
+#if defined(ICE_STR_SSE2)
+// Aligned loads never cross page boundary, So reading from aligned block that holds str start is safe
+// even if it begins before str, Bytes before str are masked out
+ICE_STR_API ICE_STR_NO_ASAN int ICE_STR_CALLCONV ice_str_sse2_len(const char* str) {
+    const char* p = (const char*) ((size_t) str & ~(size_t) 15);
+    __m128i z = _mm_setzero_si128();
+    unsigned int m = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*) p), z));
+    
+    m &= 0xFFFFu << (str - p);
+    
+    while (m == 0) {
+        p += 16;
+        m = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*) p), z));
+    }
+    
+    return (int) (p - str) + ice_str_ctz(m);
+}
 
-    if (len_str1 != len_str2) {
-        return ICE_STR_FALSE;
+ICE_STR_API int ICE_STR_CALLCONV ice_str_sse2_find(const char* str, int n, char ch) {
+    __m128i v = _mm_set1_epi8(ch);
+    int i = 0;
+    
+    for (; i + 16 <= n; i += 16) {
+        int m = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (str + i)), v));
+        if (m != 0) return i + ice_str_ctz((unsigned int) m);
     }
+    
+    int res = ice_str_scalar_find(str + i, n - i, ch);
+    return (res < 0) ? -1 : i + res;
+}
 
-    for (int i = 0; i < len_str1; i++) {
-        if (s1[i] == s2[i]) {
-            matches++;
+// Equal bytes are 0xFF (-1), So subtracting masks counts matches per byte lane, Lanes get summed before they overflow
+ICE_STR_API int ICE_STR_CALLCONV ice_str_sse2_count(const char* str, int n, char ch) {
+    __m128i v = _mm_set1_epi8(ch);
+    __m128i z = _mm_setzero_si128();
+    __m128i total = _mm_setzero_si128();
+    int i = 0;
+    
+    while (i + 16 <= n) {
+        __m128i c = _mm_setzero_si128();
+        int end = (n - i) / 16;
+        if (end > 255) end = 255;
+        
+        for (int j = 0; j < end; j++, i += 16) {
+            c = _mm_sub_epi8(c, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (str + i)), v));
         }
+        
+        total = _mm_add_epi64(total, _mm_sad_epu8(c, z));
     }
-
-    return (matches == len_str1) ? ICE_STR_TRUE : ICE_STR_FALSE;
+    
+    return _mm_cvtsi128_si32(total) + _mm_cvtsi128_si32(_mm_srli_si128(total, 8)) + ice_str_scalar_count(str + i, n - i, ch);
 }
 
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_upper(char* str) {
-    int lenstr = ice_str_len(str);
-    char* res = (char*) ICE_STR_MALLOC(lenstr + 1 * sizeof(char));
+// Compares 16 positions at once by their first and last chars, Then verifies candidates with memcmp
+ICE_STR_API int ICE_STR_CALLCONV ice_str_sse2_search(const char* str, int n, const char* sub, int m) {
+    __m128i first = _mm_set1_epi8(sub[0]);
+    __m128i last = _mm_set1_epi8(sub[m - 1]);
+    int i = 0;
+    
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (str + i)), first);
+        __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (str + i + m - 1)), last);
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_and_si128(a, b));
+        
+        while (mask != 0) {
+            int j = ice_str_ctz(mask);
+            if (memcmp(str + i + j + 1, sub + 1, m - 2) == 0) return i + j;
+            mask &= mask - 1;
+        }
+    }
+    
+    int res = ice_str_scalar_search(str + i, n - i, sub, m);
+    return (res < 0) ? -1 : i + res;
+}
 
-    for (int i = 0; i < lenstr; i++) {
-        if (str[i] == 'a') res[i] = 'A';
-        else if (str[i] == 'b') res[i] = 'B';
-        else if (str[i] == 'c') res[i] = 'C';
-        else if (str[i] == 'd') res[i] = 'D';
-        else if (str[i] == 'e') res[i] = 'E';
-        else if (str[i] == 'f') res[i] = 'F';
-        else if (str[i] == 'g') res[i] = 'G';
-        else if (str[i] == 'h') res[i] = 'H';
-        else if (str[i] == 'i') res[i] = 'I';
-        else if (str[i] == 'j') res[i] = 'J';
-        else if (str[i] == 'k') res[i] = 'K';
-        else if (str[i] == 'l') res[i] = 'L';
-        else if (str[i] == 'm') res[i] = 'M';
-        else if (str[i] == 'n') res[i] = 'N';
-        else if (str[i] == 'o') res[i] = 'O';
-        else if (str[i] == 'p') res[i] = 'P';
-        else if (str[i] == 'q') res[i] = 'Q';
-        else if (str[i] == 'r') res[i] = 'R';
-        else if (str[i] == 's') res[i] = 'S';
-        else if (str[i] == 't') res[i] = 'T';
-        else if (str[i] == 'u') res[i] = 'U';
-        else if (str[i] == 'v') res[i] = 'V';
-        else if (str[i] == 'w') res[i] = 'W';
-        else if (str[i] == 'x') res[i] = 'X';
-        else if (str[i] == 'y') res[i] = 'Y';
-        else if (str[i] == 'z') res[i] = 'Z';
-        else res[i] = str[i];
+// Letters are found by comparing with range bounds (Bytes >= 0x80 are negative so they're never in range),
+// Then their case bit (0x20) gets flipped
+ICE_STR_API void ICE_STR_CALLCONV ice_str_sse2_case(char* dst, const char* src, int n, char first) {
+    __m128i lo = _mm_set1_epi8((char) (first - 1));
+    __m128i hi = _mm_set1_epi8((char) (first + 26));
+    __m128i bit = _mm_set1_epi8(0x20);
+    int i = 0;
+    
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*) (src + i));
+        __m128i m = _mm_and_si128(_mm_cmpgt_epi8(x, lo), _mm_cmplt_epi8(x, hi));
+        _mm_storeu_si128((__m128i*) (dst + i), _mm_xor_si128(x, _mm_and_si128(m, bit)));
     }
+    
+    if (first == 'a') ice_str_scalar_upper(dst + i, src + i, n - i);
+    else ice_str_scalar_lower(dst + i, src + i, n - i);
+}
 
-    res[lenstr] = '\0';
-    return res;
+ICE_STR_API void ICE_STR_CALLCONV ice_str_sse2_upper(char* dst, const char* src, int n) {
+    ice_str_sse2_case(dst, src, n, 'a');
 }
 
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_lower(char* str) {
-    int lenstr = ice_str_len(str);
-    char* res = (char*) ICE_STR_MALLOC(lenstr + 1 * sizeof(char));
+ICE_STR_API void ICE_STR_CALLCONV ice_str_sse2_lower(char* dst, const char* src, int n) {
+    ice_str_sse2_case(dst, src, n, 'A');
+}
 
-    for (int i = 0; i < lenstr; i++) {
-        if (str[i] == 'A') res[i] = 'a';
-        else if (str[i] == 'B') res[i] = 'b';
-        else if (str[i] == 'C') res[i] = 'c';
-        else if (str[i] == 'D') res[i] = 'd';
-        else if (str[i] == 'E') res[i] = 'e';
-        else if (str[i] == 'F') res[i] = 'f';
-        else if (str[i] == 'G') res[i] = 'g';
-        else if (str[i] == 'H') res[i] = 'h';
-        else if (str[i] == 'I') res[i] = 'i';
-        else if (str[i] == 'J') res[i] = 'j';
-        else if (str[i] == 'K') res[i] = 'k';
-        else if (str[i] == 'L') res[i] = 'l';
-        else if (str[i] == 'M') res[i] = 'm';
-        else if (str[i] == 'N') res[i] = 'n';
-        else if (str[i] == 'O') res[i] = 'o';
-        else if (str[i] == 'P') res[i] = 'p';
-        else if (str[i] == 'Q') res[i] = 'q';
-        else if (str[i] == 'R') res[i] = 'r';
-        else if (str[i] == 'S') res[i] = 's';
-        else if (str[i] == 'T') res[i] = 't';
-        else if (str[i] == 'U') res[i] = 'u';
-        else if (str[i] == 'V') res[i] = 'v';
-        else if (str[i] == 'W') res[i] = 'w';
-        else if (str[i] == 'X') res[i] = 'x';
-        else if (str[i] == 'Y') res[i] = 'y';
-        else if (str[i] == 'Z') res[i] = 'z';
-        else res[i] = str[i];
+ICE_STR_API int ICE_STR_CALLCONV ice_str_sse2_ascii(const char* str, int n) {
+    int i = 0;
+    
+    for (; i + 16 <= n; i += 16) {
+        int m = _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) (str + i)));
+        if (m != 0) return i + ice_str_ctz((unsigned int) m);
     }
-
-    res[lenstr] = '\0';
-    return res;
+    
+    return i + ice_str_scalar_ascii(str + i, n - i);
 }
 
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_capitalize(char* str) {
-    int lenstr = ice_str_len(str);
-    char* res = (char*) ICE_STR_MALLOC(lenstr + 1 * sizeof(char));
-
-    if (str[0] == 'a') res[0] = 'A';
-    else if (str[0] == 'b') res[0] = 'B';
-    else if (str[0] == 'c') res[0] = 'C';
-    else if (str[0] == 'd') res[0] = 'D';
-    else if (str[0] == 'e') res[0] = 'E';
-    else if (str[0] == 'f') res[0] = 'F';
-    else if (str[0] == 'g') res[0] = 'G';
-    else if (str[0] == 'h') res[0] = 'H';
-    else if (str[0] == 'i') res[0] = 'I';
-    else if (str[0] == 'j') res[0] = 'J';
-    else if (str[0] == 'k') res[0] = 'K';
-    else if (str[0] == 'l') res[0] = 'L';
-    else if (str[0] == 'm') res[0] = 'M';
-    else if (str[0] == 'n') res[0] = 'N';
-    else if (str[0] == 'o') res[0] = 'O';
-    else if (str[0] == 'p') res[0] = 'R';
-    else if (str[0] == 'q') res[0] = 'Q';
-    else if (str[0] == 'r') res[0] = 'R';
-    else if (str[0] == 's') res[0] = 'S';
-    else if (str[0] == 't') res[0] = 'T';
-    else if (str[0] == 'u') res[0] = 'U';
-    else if (str[0] == 'v') res[0] = 'V';
-    else if (str[0] == 'w') res[0] = 'W';
-    else if (str[0] == 'x') res[0] = 'X';
-    else if (str[0] == 'y') res[0] = 'Y';
-    else if (str[0] == 'z') res[0] = 'Z';
-    else res[0] = str[0];
-
-    for (int i = 1; i < lenstr; i++) {
-        res[i] = str[i];
+// Continuation bytes (0x80 to 0xBF) are -128 to -65 as signed bytes, So they're counted with one compare
+ICE_STR_API int ICE_STR_CALLCONV ice_str_sse2_utf8_len(const char* str, int n) {
+    __m128i cont = _mm_set1_epi8(-64);
+    __m128i z = _mm_setzero_si128();
+    __m128i total = _mm_setzero_si128();
+    int i = 0;
+    
+    while (i + 16 <= n) {
+        __m128i c = _mm_setzero_si128();
+        int end = (n - i) / 16;
+        if (end > 255) end = 255;
+        
+        for (int j = 0; j < end; j++, i += 16) {
+            c = _mm_sub_epi8(c, _mm_cmplt_epi8(_mm_loadu_si128((const __m128i*) (str + i)), cont));
+        }
+        
+        total = _mm_add_epi64(total, _mm_sad_epu8(c, z));
     }
-
-    res[lenstr] = '\0';
-    return res;
+    
+    return i - (_mm_cvtsi128_si32(total) + _mm_cvtsi128_si32(_mm_srli_si128(total, 8))) + ice_str_scalar_utf8_len(str + i, n - i);
 }
 
-ICE_STR_API char** ICE_STR_CALLCONV ice_str_split(char* str, char delim) {
-    int arrlen = 0;
-    int count = 0;
-    int elems = 0;
-    int lenstr = ice_str_len(str);
-
-    for (int i = 0; i < lenstr; i++) {
-        if (str[i] == delim) {
-            arrlen++;
+// SSE2 has no byte shuffle for table lookups, So ASCII runs are skipped 16 bytes at once and
+// multi-byte sequences are checked one by one
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_sse2_utf8_valid(const char* str, int n) {
+    const unsigned char* s = (const unsigned char*) str;
+    int i = 0;
+    
+    while (i < n) {
+        if (s[i] < 0x80) {
+            i += ice_str_sse2_ascii(str + i, n - i);
+            if (i == n) break;
         }
+        
+        int len = ice_str_utf8_seq_len(s + i, n - i);
+        if (len == 0) return ICE_STR_FALSE;
+        i += len;
     }
+    
+    return ICE_STR_TRUE;
+}
+#endif
 
-    ice_str_bool last_char_not_delim = (ice_str_end_char(str, delim) == ICE_STR_FALSE) ? ICE_STR_TRUE : ICE_STR_FALSE;
+#if defined(ICE_STR_AVX2) || defined(ICE_STR_NEON)
+// UTF-8 validation by table lookups (Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte")
+// Each byte and byte before it get looked up by high nibble of previous byte, Low nibble of previous byte and
+// high nibble of current byte, Every table entry has bit set for each error that nibble allows, So AND of
+// 3 lookups is non-zero only where 2-byte pattern is invalid. 3rd and 4th bytes of long sequences are checked
+// separately by looking 2 and 3 bytes back.
+#define ICE_STR_UTF8_TOO_SHORT      0x01    // Lead byte followed by lead byte or ASCII
+#define ICE_STR_UTF8_TOO_LONG       0x02    // ASCII followed by continuation byte
+#define ICE_STR_UTF8_OVERLONG_3     0x04    // E0 followed by 80 to 9F
+#define ICE_STR_UTF8_TOO_LARGE      0x08    // F4 followed by 90 to BF, Or F5 to FF
+#define ICE_STR_UTF8_SURROGATE      0x10    // ED followed by A0 to BF
+#define ICE_STR_UTF8_OVERLONG_2     0x20    // C0 or C1
+#define ICE_STR_UTF8_TOO_LARGE_1000 0x40    // F5 to FF followed by 80 to 8F
+#define ICE_STR_UTF8_OVERLONG_4     0x40    // F0 followed by 80 to 8F
+#define ICE_STR_UTF8_TWO_CONTS      0x80    // 2 continuation bytes (Valid only inside 3 or 4 byte sequence)
+#define ICE_STR_UTF8_CARRY          (ICE_STR_UTF8_TOO_SHORT | ICE_STR_UTF8_TOO_LONG | ICE_STR_UTF8_TWO_CONTS)
 
-    if (last_char_not_delim == ICE_STR_TRUE) {
-        arrlen++;
-    }
+static const unsigned char ice_str_utf8_byte1_high[16] = {
+    // 0xxx (ASCII)
+    ICE_STR_UTF8_TOO_LONG, ICE_STR_UTF8_TOO_LONG, ICE_STR_UTF8_TOO_LONG, ICE_STR_UTF8_TOO_LONG,
+    ICE_STR_UTF8_TOO_LONG, ICE_STR_UTF8_TOO_LONG, ICE_STR_UTF8_TOO_LONG, ICE_STR_UTF8_TOO_LONG,
+    // 10xx (Continuation)
+    ICE_STR_UTF8_TWO_CONTS, ICE_STR_UTF8_TWO_CONTS, ICE_STR_UTF8_TWO_CONTS, ICE_STR_UTF8_TWO_CONTS,
+    // 1100, 1101 (2 byte lead)
+    ICE_STR_UTF8_TOO_SHORT | ICE_STR_UTF8_OVERLONG_2,
+    ICE_STR_UTF8_TOO_SHORT,
+    // 1110 (3 byte lead)
+    ICE_STR_UTF8_TOO_SHORT | ICE_STR_UTF8_OVERLONG_3 | ICE_STR_UTF8_SURROGATE,
+    // 1111 (4 byte lead)
+    ICE_STR_UTF8_TOO_SHORT | ICE_STR_UTF8_TOO_LARGE | ICE_STR_UTF8_TOO_LARGE_1000 | ICE_STR_UTF8_OVERLONG_4,
+};
 
-    int* arr_elem_lengths = (int*) ICE_STR_MALLOC(arrlen * sizeof(int));
+static const unsigned char ice_str_utf8_byte1_low[16] = {
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_OVERLONG_3 | ICE_STR_UTF8_OVERLONG_2 | ICE_STR_UTF8_OVERLONG_4,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_OVERLONG_2,
+    ICE_STR_UTF8_CARRY,
+    ICE_STR_UTF8_CARRY,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_TOO_LARGE,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_TOO_LARGE | ICE_STR_UTF8_TOO_LARGE_1000,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_TOO_LARGE | ICE_STR_UTF8_TOO_LARGE_1000,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_TOO_LARGE | ICE_STR_UTF8_TOO_LARGE_1000,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_TOO_LARGE | ICE_STR_UTF8_TOO_LARGE_1000,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_TOO_LARGE | ICE_STR_UTF8_TOO_LARGE_1000,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_TOO_LARGE | ICE_STR_UTF8_TOO_LARGE_1000,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_TOO_LARGE | ICE_STR_UTF8_TOO_LARGE_1000,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_TOO_LARGE | ICE_STR_UTF8_TOO_LARGE_1000,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_TOO_LARGE | ICE_STR_UTF8_TOO_LARGE_1000 | ICE_STR_UTF8_SURROGATE,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_TOO_LARGE | ICE_STR_UTF8_TOO_LARGE_1000,
+    ICE_STR_UTF8_CARRY | ICE_STR_UTF8_TOO_LARGE | ICE_STR_UTF8_TOO_LARGE_1000,
+};
 
-    for (int i = 0; i < lenstr; i++) {
-        count++;
+static const unsigned char ice_str_utf8_byte2_high[16] = {
+    // 0xxx (ASCII)
+    ICE_STR_UTF8_TOO_SHORT, ICE_STR_UTF8_TOO_SHORT, ICE_STR_UTF8_TOO_SHORT, ICE_STR_UTF8_TOO_SHORT,
+    ICE_STR_UTF8_TOO_SHORT, ICE_STR_UTF8_TOO_SHORT, ICE_STR_UTF8_TOO_SHORT, ICE_STR_UTF8_TOO_SHORT,
+    // 1000
+    ICE_STR_UTF8_TOO_LONG | ICE_STR_UTF8_OVERLONG_2 | ICE_STR_UTF8_TWO_CONTS | ICE_STR_UTF8_OVERLONG_3 | ICE_STR_UTF8_TOO_LARGE_1000 | ICE_STR_UTF8_OVERLONG_4,
+    // 1001
+    ICE_STR_UTF8_TOO_LONG | ICE_STR_UTF8_OVERLONG_2 | ICE_STR_UTF8_TWO_CONTS | ICE_STR_UTF8_OVERLONG_3 | ICE_STR_UTF8_TOO_LARGE,
+    // 1010, 1011
+    ICE_STR_UTF8_TOO_LONG | ICE_STR_UTF8_OVERLONG_2 | ICE_STR_UTF8_TWO_CONTS | ICE_STR_UTF8_SURROGATE | ICE_STR_UTF8_TOO_LARGE,
+    ICE_STR_UTF8_TOO_LONG | ICE_STR_UTF8_OVERLONG_2 | ICE_STR_UTF8_TWO_CONTS | ICE_STR_UTF8_SURROGATE | ICE_STR_UTF8_TOO_LARGE,
+    // 11xx (Lead)
+    ICE_STR_UTF8_TOO_SHORT, ICE_STR_UTF8_TOO_SHORT, ICE_STR_UTF8_TOO_SHORT, ICE_STR_UTF8_TOO_SHORT,
+};
 
-        if (str[i] == delim) {
-            arr_elem_lengths[elems] = count;
-            elems++;
-        }
-    }
+// Block ending with these bytes ends inside multi-byte sequence (Subtracting with saturation gives non-zero)
+static const unsigned char ice_str_utf8_max_tail[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+};
+#endif
 
-    if (last_char_not_delim == ICE_STR_TRUE) {
-        arr_elem_lengths[arrlen - 1] = lenstr + 1;
-        elems++;
+#if defined(ICE_STR_AVX2)
+ICE_STR_API ICE_STR_NO_ASAN ICE_STR_TARGET_AVX2 int ICE_STR_CALLCONV ice_str_avx2_len(const char* str) {
+    const char* p = (const char*) ((size_t) str & ~(size_t) 31);
+    __m256i z = _mm256_setzero_si256();
+    unsigned int m = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*) p), z));
+    
+    m &= 0xFFFFFFFFu << (str - p);
+    
+    while (m == 0) {
+        p += 32;
+        m = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*) p), z));
     }
+    
+    return (int) (p - str) + ice_str_ctz(m);
+}
 
-    int sum = 0;
-
-    for (int i = 0; i < elems; i++) {
-        sum += arr_elem_lengths[i];
+ICE_STR_API ICE_STR_TARGET_AVX2 int ICE_STR_CALLCONV ice_str_avx2_find(const char* str, int n, char ch) {
+    __m256i v = _mm256_set1_epi8(ch);
+    int i = 0;
+    
+    for (; i + 32 <= n; i += 32) {
+        unsigned int m = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) (str + i)), v));
+        if (m != 0) return i + ice_str_ctz(m);
     }
+    
+    int res = ice_str_scalar_find(str + i, n - i, ch);
+    return (res < 0) ? -1 : i + res;
+}
 
-    char** res = (char**) ICE_STR_MALLOC(sum * sizeof(char));
-
-    for (int i = 0; i < elems; i++) {
-        if (i == 0) {
-            res[i] = ice_str_sub(str, 0, arr_elem_lengths[i] - 2);
-        } else {
-            res[i] = ice_str_sub(str, arr_elem_lengths[i - 1], arr_elem_lengths[i] - 2);
+ICE_STR_API ICE_STR_TARGET_AVX2 int ICE_STR_CALLCONV ice_str_avx2_count(const char* str, int n, char ch) {
+    __m256i v = _mm256_set1_epi8(ch);
+    __m256i z = _mm256_setzero_si256();
+    __m256i total = _mm256_setzero_si256();
+    long long lanes[4];
+    int i = 0;
+    
+    while (i + 32 <= n) {
+        __m256i c = _mm256_setzero_si256();
+        int end = (n - i) / 32;
+        if (end > 255) end = 255;
+        
+        for (int j = 0; j < end; j++, i += 32) {
+            c = _mm256_sub_epi8(c, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) (str + i)), v));
         }
+        
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(c, z));
     }
-
-    return res;
+    
+    _mm256_storeu_si256((__m256i*) lanes, total);
+    return (int) (lanes[0] + lanes[1] + lanes[2] + lanes[3]) + ice_str_scalar_count(str + i, n - i, ch);
 }
 
-ICE_STR_API char** ICE_STR_CALLCONV ice_str_splitlines(char* str) {
-    return ice_str_split(str, '\n');
+ICE_STR_API ICE_STR_TARGET_AVX2 int ICE_STR_CALLCONV ice_str_avx2_search(const char* str, int n, const char* sub, int m) {
+    __m256i first = _mm256_set1_epi8(sub[0]);
+    __m256i last = _mm256_set1_epi8(sub[m - 1]);
+    int i = 0;
+    
+    for (; i + m - 1 + 32 <= n; i += 32) {
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) (str + i)), first);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) (str + i + m - 1)), last);
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_and_si256(a, b));
+        
+        while (mask != 0) {
+            int j = ice_str_ctz(mask);
+            if (memcmp(str + i + j + 1, sub + 1, m - 2) == 0) return i + j;
+            mask &= mask - 1;
+        }
+    }
+    
+    int res = ice_str_scalar_search(str + i, n - i, sub, m);
+    return (res < 0) ? -1 : i + res;
 }
 
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_join(char** strs) {
-    int arrlen = 0;
-    int strs_size = 0;
-
-    while (strs[arrlen] != NULL) arrlen++;
-
-    for (int i = 0; i < arrlen; i++) {
-        strs_size += ice_str_len(strs[i]);
+ICE_STR_API ICE_STR_TARGET_AVX2 void ICE_STR_CALLCONV ice_str_avx2_case(char* dst, const char* src, int n, char first) {
+    __m256i lo = _mm256_set1_epi8((char) (first - 1));
+    __m256i hi = _mm256_set1_epi8((char) (first + 26));
+    __m256i bit = _mm256_set1_epi8(0x20);
+    int i = 0;
+    
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*) (src + i));
+        __m256i m = _mm256_and_si256(_mm256_cmpgt_epi8(x, lo), _mm256_cmpgt_epi8(hi, x));
+        _mm256_storeu_si256((__m256i*) (dst + i), _mm256_xor_si256(x, _mm256_and_si256(m, bit)));
     }
+    
+    if (first == 'a') ice_str_scalar_upper(dst + i, src + i, n - i);
+    else ice_str_scalar_lower(dst + i, src + i, n - i);
+}
 
-    char* res = (char*) ICE_STR_MALLOC(strs_size + 1 * sizeof(char));
-    int res_s = 0;
-
-    for (int i = 0; i < arrlen; i++) {
-        int lenstr = ice_str_len(strs[i]);
+ICE_STR_API ICE_STR_TARGET_AVX2 void ICE_STR_CALLCONV ice_str_avx2_upper(char* dst, const char* src, int n) {
+    ice_str_avx2_case(dst, src, n, 'a');
+}
 
-        for (int j = 0; j < lenstr; j++) {
-            res[j + res_s] = strs[i][j];
-        }
+ICE_STR_API ICE_STR_TARGET_AVX2 void ICE_STR_CALLCONV ice_str_avx2_lower(char* dst, const char* src, int n) {
+    ice_str_avx2_case(dst, src, n, 'A');
+}
 
-        res_s += lenstr;
+ICE_STR_API ICE_STR_TARGET_AVX2 int ICE_STR_CALLCONV ice_str_avx2_ascii(const char* str, int n) {
+    int i = 0;
+    
+    for (; i + 32 <= n; i += 32) {
+        unsigned int m = (unsigned int) _mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*) (str + i)));
+        if (m != 0) return i + ice_str_ctz(m);
     }
-
-    res[res_s] = '\0';
-    return res;
+    
+    return i + ice_str_scalar_ascii(str + i, n - i);
 }
 
-ICE_STR_API char* ICE_STR_CALLCONV ice_str_join_with_delim(char** strs, char delim) {
-    int count = 0;
-    int res_s = 0;
-    int arrlen = 0;
-    int strs_size = 0;
-
-    while (strs[arrlen] != NULL) arrlen++;
-
-    for (int i = 0; i < arrlen; i++) {
-        strs_size += ice_str_len(strs[i]);
+ICE_STR_API ICE_STR_TARGET_AVX2 int ICE_STR_CALLCONV ice_str_avx2_utf8_len(const char* str, int n) {
+    __m256i cont = _mm256_set1_epi8(-64);
+    __m256i z = _mm256_setzero_si256();
+    __m256i total = _mm256_setzero_si256();
+    long long lanes[4];
+    int i = 0;
+    
+    while (i + 32 <= n) {
+        __m256i c = _mm256_setzero_si256();
+        int end = (n - i) / 32;
+        if (end > 255) end = 255;
+        
+        for (int j = 0; j < end; j++, i += 32) {
+            c = _mm256_sub_epi8(c, _mm256_cmpgt_epi8(cont, _mm256_loadu_si256((const __m256i*) (str + i))));
+        }
+        
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(c, z));
     }
+    
+    _mm256_storeu_si256((__m256i*) lanes, total);
+    return i - (int) (lanes[0] + lanes[1] + lanes[2] + lanes[3]) + ice_str_scalar_utf8_len(str + i, n - i);
+}
 
-    char* res = (char*) ICE_STR_MALLOC(1 + strs_size + arrlen * sizeof(char));
-
-    for (int i = 0; i < arrlen; i++) {
-        int lstr = ice_str_len(strs[i]);
-
-        for (int j = 0; j < lstr; j++) {
-            res[j + res_s + ((i > 0) ? 1 : 0)] = strs[i][j];
+// Last block is copied to zeroed buffer, So sequence cut by end of string is followed by ASCII and gets reported as too short
+ICE_STR_API ICE_STR_TARGET_AVX2 ice_str_bool ICE_STR_CALLCONV ice_str_avx2_utf8_valid(const char* str, int n) {
+    __m256i b1h = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) ice_str_utf8_byte1_high));
+    __m256i b1l = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) ice_str_utf8_byte1_low));
+    __m256i b2h = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) ice_str_utf8_byte2_high));
+    __m256i max_tail = _mm256_loadu_si256((const __m256i*) ice_str_utf8_max_tail);
+    __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i prev = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+    __m256i err = _mm256_setzero_si256();
+    unsigned char last[32];
+    int i = 0;
+    
+    for (;;) {
+        __m256i x;
+        
+        if (i + 32 <= n) {
+            x = _mm256_loadu_si256((const __m256i*) (str + i));
+        } else {
+            memset(last, 0, 32);
+            memcpy(last, str + i, n - i);
+            x = _mm256_loadu_si256((const __m256i*) last);
         }
-
-        if (i != 0) {
-            res[res_s] = delim;
-            res_s += lstr + count++;
+        
+        if (_mm256_movemask_epi8(x) == 0) {
+            // ASCII block is only invalid if previous block ended inside sequence
+            err = _mm256_or_si256(err, incomplete);
         } else {
-            res_s += lstr + count++;
+            __m256i shifted = _mm256_permute2x128_si256(prev, x, 0x21);
+            __m256i prev1 = _mm256_alignr_epi8(x, shifted, 15);
+            __m256i prev2 = _mm256_alignr_epi8(x, shifted, 14);
+            __m256i prev3 = _mm256_alignr_epi8(x, shifted, 13);
+            
+            __m256i sc = _mm256_and_si256(
+                _mm256_and_si256(
+                    _mm256_shuffle_epi8(b1h, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                    _mm256_shuffle_epi8(b1l, _mm256_and_si256(prev1, nibble))),
+                _mm256_shuffle_epi8(b2h, _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble)));
+            
+            // Bytes 2 and 3 after 3 or 4 byte lead must be continuation bytes (Those are only places where TWO_CONTS is allowed)
+            __m256i must23 = _mm256_or_si256(
+                _mm256_subs_epu8(prev2, _mm256_set1_epi8((char) (0xE0 - 0x80))),
+                _mm256_subs_epu8(prev3, _mm256_set1_epi8((char) (0xF0 - 0x80))));
+            
+            err = _mm256_or_si256(err, _mm256_xor_si256(_mm256_and_si256(must23, _mm256_set1_epi8((char) 0x80)), sc));
+            if (!_mm256_testz_si256(err, err)) return ICE_STR_FALSE;
         }
+        
+        if (i + 32 > n) break;
+        
+        incomplete = _mm256_subs_epu8(x, max_tail);
+        prev = x;
+        i += 32;
     }
-
-    res[res_s - 1] = '\0';
+    
+    return _mm256_testz_si256(err, err) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Checks if CPU and OS both support AVX2 (OS must save YMM registers)
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_cpu_has_avx2(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return ICE_STR_FALSE;
+    
+    __cpuid(info, 1);
+    if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 28))) return ICE_STR_FALSE;
+    if ((_xgetbv(0) & 6) != 6) return ICE_STR_FALSE;
+    
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) ? ICE_STR_TRUE : ICE_STR_FALSE;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? ICE_STR_TRUE : ICE_STR_FALSE;
+#endif
+}
+#endif
+
+#if defined(ICE_STR_NEON)
+// NEON has no movemask, So each byte of compare result is narrowed to 4 bits of 64-bit mask
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_neon_mask(uint8x16_t cmp) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0);
+}
+
+ICE_STR_API ICE_STR_NO_ASAN int ICE_STR_CALLCONV ice_str_neon_len(const char* str) {
+    const char* p = (const char*) ((size_t) str & ~(size_t) 15);
+    unsigned long long m = ice_str_neon_mask(vceqzq_u8(vld1q_u8((const unsigned char*) p)));
+    
+    m &= ~0ULL << (4 * (str - p));
+    
+    while (m == 0) {
+        p += 16;
+        m = ice_str_neon_mask(vceqzq_u8(vld1q_u8((const unsigned char*) p)));
+    }
+    
+    return (int) (p - str) + ice_str_ctz(m) / 4;
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_neon_find(const char* str, int n, char ch) {
+    uint8x16_t v = vdupq_n_u8((unsigned char) ch);
+    int i = 0;
+    
+    for (; i + 16 <= n; i += 16) {
+        unsigned long long m = ice_str_neon_mask(vceqq_u8(vld1q_u8((const unsigned char*) (str + i)), v));
+        if (m != 0) return i + ice_str_ctz(m) / 4;
+    }
+    
+    int res = ice_str_scalar_find(str + i, n - i, ch);
+    return (res < 0) ? -1 : i + res;
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_neon_count(const char* str, int n, char ch) {
+    uint8x16_t v = vdupq_n_u8((unsigned char) ch);
+    int res = 0;
+    int i = 0;
+    
+    while (i + 16 <= n) {
+        uint8x16_t c = vdupq_n_u8(0);
+        int end = (n - i) / 16;
+        if (end > 255) end = 255;
+        
+        for (int j = 0; j < end; j++, i += 16) {
+            c = vsubq_u8(c, vceqq_u8(vld1q_u8((const unsigned char*) (str + i)), v));
+        }
+        
+        res += (int) vaddlvq_u8(c);
+    }
+    
+    return res + ice_str_scalar_count(str + i, n - i, ch);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_neon_search(const char* str, int n, const char* sub, int m) {
+    uint8x16_t first = vdupq_n_u8((unsigned char) sub[0]);
+    uint8x16_t last = vdupq_n_u8((unsigned char) sub[m - 1]);
+    int i = 0;
+    
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        uint8x16_t a = vceqq_u8(vld1q_u8((const unsigned char*) (str + i)), first);
+        uint8x16_t b = vceqq_u8(vld1q_u8((const unsigned char*) (str + i + m - 1)), last);
+        unsigned long long mask = ice_str_neon_mask(vandq_u8(a, b));
+        
+        // Each candidate owns 4 bits of mask
+        while (mask != 0) {
+            int j = ice_str_ctz(mask) / 4;
+            if (memcmp(str + i + j + 1, sub + 1, m - 2) == 0) return i + j;
+            mask &= ~(0xFULL << (4 * j));
+        }
+    }
+    
+    int res = ice_str_scalar_search(str + i, n - i, sub, m);
+    return (res < 0) ? -1 : i + res;
+}
+
+// Unsigned compare, So subtracting first maps letters to 0..25 and everything else above it
+ICE_STR_API void ICE_STR_CALLCONV ice_str_neon_case(char* dst, const char* src, int n, char first) {
+    uint8x16_t base = vdupq_n_u8((unsigned char) first);
+    uint8x16_t range = vdupq_n_u8(26);
+    uint8x16_t bit = vdupq_n_u8(0x20);
+    int i = 0;
+    
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t x = vld1q_u8((const unsigned char*) (src + i));
+        uint8x16_t m = vcltq_u8(vsubq_u8(x, base), range);
+        vst1q_u8((unsigned char*) (dst + i), veorq_u8(x, vandq_u8(m, bit)));
+    }
+    
+    if (first == 'a') ice_str_scalar_upper(dst + i, src + i, n - i);
+    else ice_str_scalar_lower(dst + i, src + i, n - i);
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_neon_upper(char* dst, const char* src, int n) {
+    ice_str_neon_case(dst, src, n, 'a');
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_neon_lower(char* dst, const char* src, int n) {
+    ice_str_neon_case(dst, src, n, 'A');
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_neon_ascii(const char* str, int n) {
+    int i = 0;
+    
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t x = vld1q_u8((const unsigned char*) (str + i));
+        
+        if (vmaxvq_u8(x) >= 0x80) {
+            return i + ice_str_ctz(ice_str_neon_mask(vcgeq_u8(x, vdupq_n_u8(0x80)))) / 4;
+        }
+    }
+    
+    return i + ice_str_scalar_ascii(str + i, n - i);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_neon_utf8_len(const char* str, int n) {
+    int8x16_t cont = vdupq_n_s8(-64);
+    int res = 0;
+    int i = 0;
+    
+    while (i + 16 <= n) {
+        uint8x16_t c = vdupq_n_u8(0);
+        int end = (n - i) / 16;
+        if (end > 255) end = 255;
+        
+        for (int j = 0; j < end; j++, i += 16) {
+            c = vsubq_u8(c, vcltq_s8(vld1q_s8((const signed char*) (str + i)), cont));
+        }
+        
+        res += (int) vaddlvq_u8(c);
+    }
+    
+    return i - res + ice_str_scalar_utf8_len(str + i, n - i);
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_neon_utf8_valid(const char* str, int n) {
+    uint8x16_t b1h = vld1q_u8(ice_str_utf8_byte1_high);
+    uint8x16_t b1l = vld1q_u8(ice_str_utf8_byte1_low);
+    uint8x16_t b2h = vld1q_u8(ice_str_utf8_byte2_high);
+    uint8x16_t max_tail = vld1q_u8(ice_str_utf8_max_tail + 16);
+    uint8x16_t nibble = vdupq_n_u8(0x0F);
+    uint8x16_t prev = vdupq_n_u8(0);
+    uint8x16_t incomplete = vdupq_n_u8(0);
+    uint8x16_t err = vdupq_n_u8(0);
+    unsigned char last[16];
+    int i = 0;
+    
+    for (;;) {
+        uint8x16_t x;
+        
+        if (i + 16 <= n) {
+            x = vld1q_u8((const unsigned char*) (str + i));
+        } else {
+            memset(last, 0, 16);
+            memcpy(last, str + i, n - i);
+            x = vld1q_u8(last);
+        }
+        
+        if (vmaxvq_u8(x) < 0x80) {
+            err = vorrq_u8(err, incomplete);
+        } else {
+            uint8x16_t prev1 = vextq_u8(prev, x, 15);
+            uint8x16_t prev2 = vextq_u8(prev, x, 14);
+            uint8x16_t prev3 = vextq_u8(prev, x, 13);
+            
+            uint8x16_t sc = vandq_u8(
+                vandq_u8(vqtbl1q_u8(b1h, vshrq_n_u8(prev1, 4)), vqtbl1q_u8(b1l, vandq_u8(prev1, nibble))),
+                vqtbl1q_u8(b2h, vshrq_n_u8(x, 4)));
+            
+            uint8x16_t must23 = vorrq_u8(vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80)), vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80)));
+            
+            err = vorrq_u8(err, veorq_u8(vandq_u8(must23, vdupq_n_u8(0x80)), sc));
+            if (vmaxvq_u8(err) != 0) return ICE_STR_FALSE;
+        }
+        
+        if (i + 16 > n) break;
+        
+        incomplete = vqsubq_u8(x, max_tail);
+        prev = x;
+        i += 16;
+    }
+    
+    return (vmaxvq_u8(err) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+#endif
+
+static ice_str_kernels ice_str_kernels_table;
+static int ice_str_kernels_level = -1;
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_simd_set_level(ice_str_simd level) {
+    ice_str_kernels k = { ice_str_scalar_len, ice_str_scalar_find, ice_str_scalar_count, ice_str_scalar_search, ice_str_scalar_upper, ice_str_scalar_lower, ice_str_scalar_ascii, ice_str_scalar_utf8_len, ice_str_scalar_utf8_valid };
+    
+    switch (level) {
+        case ICE_STR_SIMD_NONE:
+            break;
+#if defined(ICE_STR_SSE2)
+        case ICE_STR_SIMD_SSE2: {
+            ice_str_kernels sse2 = { ice_str_sse2_len, ice_str_sse2_find, ice_str_sse2_count, ice_str_sse2_search, ice_str_sse2_upper, ice_str_sse2_lower, ice_str_sse2_ascii, ice_str_sse2_utf8_len, ice_str_sse2_utf8_valid };
+            k = sse2;
+            break;
+        }
+#endif
+#if defined(ICE_STR_AVX2)
+        case ICE_STR_SIMD_AVX2: {
+            if (ice_str_cpu_has_avx2() == ICE_STR_FALSE) return ICE_STR_FALSE;
+            
+            ice_str_kernels avx2 = { ice_str_avx2_len, ice_str_avx2_find, ice_str_avx2_count, ice_str_avx2_search, ice_str_avx2_upper, ice_str_avx2_lower, ice_str_avx2_ascii, ice_str_avx2_utf8_len, ice_str_avx2_utf8_valid };
+            k = avx2;
+            break;
+        }
+#endif
+#if defined(ICE_STR_NEON)
+        case ICE_STR_SIMD_NEON: {
+            ice_str_kernels neon = { ice_str_neon_len, ice_str_neon_find, ice_str_neon_count, ice_str_neon_search, ice_str_neon_upper, ice_str_neon_lower, ice_str_neon_ascii, ice_str_neon_utf8_len, ice_str_neon_utf8_valid };
+            k = neon;
+            break;
+        }
+#endif
+        default:
+            return ICE_STR_FALSE;
+    }
+    
+    ice_str_kernels_table = k;
+    ice_str_kernels_level = (int) level;
+    return ICE_STR_TRUE;
+}
+
+// Picks best kernels supported by CPU, Unless ice_str_simd_set_level was called before
+ICE_STR_API void ICE_STR_CALLCONV ice_str_kernels_init(void) {
+    if (ice_str_kernels_level < 0) {
+        if (ice_str_simd_set_level(ICE_STR_SIMD_AVX2) == ICE_STR_FALSE &&
+            ice_str_simd_set_level(ICE_STR_SIMD_SSE2) == ICE_STR_FALSE &&
+            ice_str_simd_set_level(ICE_STR_SIMD_NEON) == ICE_STR_FALSE) {
+            ice_str_simd_set_level(ICE_STR_SIMD_NONE);
+        }
+    }
+}
+
+// Kernels get picked at first call, Which may happen on many threads at once (Ex. ice_str_intern_sharded_add),
+// So picking runs once per process and other callers wait for it to finish before reading table.
+#if defined(ICE_STR_NO_THREADS)
+ICE_STR_API ice_str_kernels* ICE_STR_CALLCONV ice_str_get_kernels(void) {
+    ice_str_kernels_init();
+    return &ice_str_kernels_table;
+}
+#elif defined(ICE_STR_MICROSOFT)
+static INIT_ONCE ice_str_kernels_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK ice_str_kernels_init_once(PINIT_ONCE once, PVOID param, PVOID* ctx) {
+    (void) once;
+    (void) param;
+    (void) ctx;
+    ice_str_kernels_init();
+    return TRUE;
+}
+
+ICE_STR_API ice_str_kernels* ICE_STR_CALLCONV ice_str_get_kernels(void) {
+    InitOnceExecuteOnce(&ice_str_kernels_once, ice_str_kernels_init_once, NULL, NULL);
+    return &ice_str_kernels_table;
+}
+#else
+static pthread_once_t ice_str_kernels_once = PTHREAD_ONCE_INIT;
+
+static void ice_str_kernels_init_once(void) {
+    ice_str_kernels_init();
+}
+
+ICE_STR_API ice_str_kernels* ICE_STR_CALLCONV ice_str_get_kernels(void) {
+    pthread_once(&ice_str_kernels_once, ice_str_kernels_init_once);
+    return &ice_str_kernels_table;
+}
+#endif
+
+ICE_STR_API ice_str_simd ICE_STR_CALLCONV ice_str_simd_level(void) {
+    ice_str_get_kernels();
+    return (ice_str_simd) ice_str_kernels_level;
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_len(char* str) {
+    return ice_str_get_kernels()->len(str);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_arr_len(char** arr) {
+    int arrlen = 0;
+    while (arr[arrlen] != NULL) arrlen++;
+    return arrlen;
+}
+
+// to is inclusive, So substring has (to - from + 1) chars and NUL after them
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_sub(char* str, int from, int to) {
+    char* res = (char*) ICE_STR_MALLOC((to - from) + 2);
+    int count = 0;
+
+    for (int i = from; i <= to; i++) {
+        res[count] = str[i];
+        count++;
+    }
+
+    res[count] = '\0';
+    return res;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_strdup(char* str) {
+    int len = ice_str_len(str);
+    char* res = (char*) ICE_STR_MALLOC(len + 1 * sizeof(char));
+
+    for (int i = 0; i < len; i++) {
+        res[i] = str[i];
+    }
+
+    res[len] = '\0';
+    return res;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_concat(char* s1, char* s2) {
+    int len_str1 = ice_str_len(s1);
+    int len_str2 = ice_str_len(s2);
+
+    char* res = (char*) ICE_STR_MALLOC(len_str1 + len_str2 + 1);
+
+    if (res != NULL) {
+        memcpy(res, s1, len_str1);
+        memcpy(res + len_str1, s2, len_str2 + 1);
+    }
+
+    return res;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_rep(char* str, int count) {
+    int lenstr = ice_str_len(str);
+    char* res = (char*) ICE_STR_MALLOC((lenstr * count) + 1 * sizeof(char));
+    int times = 0;
+
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < lenstr; j++) {
+            res[(lenstr * i) + j] = str[j];
+        }
+
+        times++;
+    }
+
+    res[lenstr * count] = '\0';
+    return res;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_char(char* str, int index) {
+    char* c = (char*) ICE_STR_MALLOC(2 * sizeof(char));
+    c[0] = str[index];
+    c[1] = '\0';
+    return c;
+}
+
+// Stops at first different char (Strings of different lengths differ at NUL of shorter one)
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_match(char* s1, char* s2) {
+    if (s1 == s2) {
+        return ICE_STR_TRUE;
+    }
+
+    return (strcmp(s1, s2) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_upper(char* str) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    int lenstr = k->len(str);
+    char* res = (char*) ICE_STR_MALLOC(lenstr + 1);
+
+    if (res != NULL) {
+        k->upper(res, str, lenstr + 1);
+    }
+
+    return res;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_lower(char* str) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    int lenstr = k->len(str);
+    char* res = (char*) ICE_STR_MALLOC(lenstr + 1);
+
+    if (res != NULL) {
+        k->lower(res, str, lenstr + 1);
+    }
+
+    return res;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_capitalize(char* str) {
+    int lenstr = ice_str_len(str);
+    char* res = (char*) ICE_STR_MALLOC(lenstr + 1);
+
+    if (res != NULL) {
+        memcpy(res, str, lenstr + 1);
+        res[0] = (char) ice_str_upper_table[(unsigned char) res[0]];
+    }
+
+    return res;
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_upper_in_place(char* str) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    k->upper(str, str, k->len(str));
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_lower_in_place(char* str) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    k->lower(str, str, k->len(str));
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_capitalize_in_place(char* str) {
+    str[0] = (char) ice_str_upper_table[(unsigned char) str[0]];
+}
+
+// Compares through lower case table, Stops at first different char
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_match_nocase(char* s1, char* s2) {
+    int i = 0;
+
+    while (ice_str_lower_table[(unsigned char) s1[i]] == ice_str_lower_table[(unsigned char) s2[i]]) {
+        if (s1[i] == '\0') return ICE_STR_TRUE;
+        i++;
+    }
+
+    return ICE_STR_FALSE;
+}
+
+// FNV-1a hash of lower cased chars, So strings that differ only in case get same hash
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_hash_nocase_len(char* str, int len) {
+    unsigned long long res = 14695981039346656037ULL;
+
+    for (int i = 0; i < len; i++) {
+        res ^= ice_str_lower_table[(unsigned char) str[i]];
+        res *= 1099511628211ULL;
+    }
+
+    return res;
+}
+
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_hash_nocase(char* str) {
+    return ice_str_hash_nocase_len(str, ice_str_len(str));
+}
+
+// Delimiters are counted and found by SIMD kernels, Returned array ends with NULL (Same as arrays taken by ice_str_arr_len)
+ICE_STR_API char** ICE_STR_CALLCONV ice_str_split(char* str, char delim) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    int lenstr = k->len(str);
+    int arrlen = k->count(str, lenstr, delim);
+    ice_str_tok tok = ice_str_tok_new_len(str, lenstr, delim);
+    ice_str_view view;
+
+    if (lenstr > 0 && str[lenstr - 1] != delim) {
+        arrlen++;
+    }
+
+    char** res = (char**) ICE_STR_MALLOC((arrlen + 1) * sizeof(char*));
+
+    if (res == NULL) {
+        return NULL;
+    }
+
+    for (int i = 0; ice_str_tok_next(&tok, &view) == ICE_STR_TRUE; i++) {
+        res[i] = ice_str_view_to_str(view);
+    }
+
+    res[arrlen] = NULL;
     return res;
 }
 
+ICE_STR_API char** ICE_STR_CALLCONV ice_str_splitlines(char* str) {
+    return ice_str_split(str, '\n');
+}
+
+// Strings are appended to builder as they're walked, So each is read once and copied once more at finish
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_join(char** strs) {
+    ice_str_builder b = ice_str_builder_new();
+
+    for (int i = 0; strs[i] != NULL; i++) {
+        ice_str_builder_append(&b, strs[i]);
+    }
+
+    return ice_str_builder_finish(&b);
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_join_with_delim(char** strs, char delim) {
+    ice_str_builder b = ice_str_builder_new();
+
+    for (int i = 0; strs[i] != NULL; i++) {
+        if (i > 0) ice_str_builder_append_char(&b, delim);
+        ice_str_builder_append(&b, strs[i]);
+    }
+
+    return ice_str_builder_finish(&b);
+}
+
+// Stops at first different char, So s1 is never read past its end
 ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_begin(char* s1, char* s2) {
-    int lenstr = ice_str_len(s2);
-    char* sub = ice_str_sub(s1, 0, lenstr - 1);
-    
-    return ice_str_match(sub, s2);
+    for (int i = 0; s2[i] != '\0'; i++) {
+        if (s1[i] != s2[i]) return ICE_STR_FALSE;
+    }
+
+    return ICE_STR_TRUE;
 }
 
 ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_end(char* s1, char* s2) {
     int lenstr1 = ice_str_len(s1);
     int lenstr2 = ice_str_len(s2);
 
-    char* sub = ice_str_sub(s1, lenstr1 - lenstr2, lenstr1 - 1);
-    return ice_str_match(sub, s2);
+    if (lenstr2 > lenstr1) {
+        return ICE_STR_FALSE;
+    }
+
+    return (memcmp(s1 + (lenstr1 - lenstr2), s2, lenstr2) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
 }
 
 ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_end_char(char* str, char ch) {
     int lenstr = ice_str_len(str);
-    return (str[lenstr - 1] == ch) ? ICE_STR_TRUE : ICE_STR_FALSE;
+    return (lenstr > 0 && str[lenstr - 1] == ch) ? ICE_STR_TRUE : ICE_STR_FALSE;
 }
 
 ICE_STR_API char* ICE_STR_CALLCONV ice_str_rev(char* str) {
     int lenstr = ice_str_len(str);
-    char* res = (char*) ICE_STR_MALLOC(lenstr * sizeof(char));
+    char* res = (char*) ICE_STR_MALLOC(lenstr + 1);
 
     for (int i = 0; i < lenstr; i++) {
         res[(lenstr - 1) - i] = str[i];
@@ -602,12 +1774,3541 @@ ICE_STR_API void ICE_STR_CALLCONV ice_str_free(char* str) {
 }
 
 ICE_STR_API void ICE_STR_CALLCONV ice_str_arr_free(char** arr) {
-    for (int i = 0; i < ice_str_arr_len(arr); i++) {
+    if (arr == NULL) {
+        return;
+    }
+    
+    for (int i = 0; arr[i] != NULL; i++) {
         ICE_STR_FREE(arr[i]);
     }
     
     ICE_STR_FREE(arr);
 }
 
+// Returns index of first ch in str, Or -1 if there is none
+ICE_STR_API int ICE_STR_CALLCONV ice_str_find_char(char* str, char ch) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    return k->find(str, k->len(str), ch);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_count_char(char* str, char ch) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    return k->count(str, k->len(str), ch);
+}
+
+// Returns count of strings ice_str_splitlines gives (Newline at end doesn't start another line)
+ICE_STR_API int ICE_STR_CALLCONV ice_str_count_lines(char* str) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    int lenstr = k->len(str);
+    int res = k->count(str, lenstr, '\n');
+    return (lenstr > 0 && str[lenstr - 1] != '\n') ? res + 1 : res;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_str SEARCH
+///////////////////////////////////////////////////////////////////////////////////////////
+// Boyer-Moore-Horspool, Skips by distance of last char of window from end of sub (Good for long substrings)
+// (Internal, Only ice_str_search calls it with m >= ICE_STR_BMH_MIN, Not inlined so short constant subs of callers don't look like they reach sub[m - 1])
+static ICE_STR_NOINLINE int ICE_STR_CALLCONV ice_str_bmh(const char* str, int n, const char* sub, int m) {
+    int skip[256];
+    unsigned char last = (unsigned char) sub[m - 1];
+    
+    for (int i = 0; i < 256; i++) skip[i] = m;
+    for (int i = 0; i < m - 1; i++) skip[(unsigned char) sub[i]] = m - 1 - i;
+    
+    for (int i = 0; i + m <= n; ) {
+        unsigned char ch = (unsigned char) str[i + m - 1];
+        if (ch == last && memcmp(str + i, sub, m - 1) == 0) return i;
+        i += skip[ch];
+    }
+    
+    return -1;
+}
+
+// Returns index of first sub (m chars) in str (n chars), Or -1 if there is none (Empty sub is found at 0)
+ICE_STR_API int ICE_STR_CALLCONV ice_str_search(const char* str, int n, const char* sub, int m) {
+    if (m == 0) return 0;
+    if (m > n) return -1;
+    if (m == 1) return ice_str_get_kernels()->find(str, n, sub[0]);
+    if (m >= ICE_STR_BMH_MIN) return ice_str_bmh(str, n, sub, m);
+    return ice_str_get_kernels()->search(str, n, sub, m);
+}
+
+// Returns index of last sub (m chars) in str (n chars), Or -1 if there is none (Empty sub is found at n)
+ICE_STR_API int ICE_STR_CALLCONV ice_str_rsearch(const char* str, int n, const char* sub, int m) {
+    if (m == 0) return n;
+    
+    for (int i = n - m; i >= 0; i--) {
+        if (str[i] == sub[0] && str[i + m - 1] == sub[m - 1] && memcmp(str + i, sub, m) == 0) return i;
+    }
+    
+    return -1;
+}
+
+// Counts non-overlapping sub (m chars) in str (n chars), Empty sub is never counted
+ICE_STR_API int ICE_STR_CALLCONV ice_str_search_count(const char* str, int n, const char* sub, int m) {
+    int res = 0;
+    int i = 0;
+    
+    if (m == 0) return 0;
+    if (m == 1) return ice_str_get_kernels()->count(str, n, sub[0]);
+    
+    for (;;) {
+        int pos = ice_str_search(str + i, n - i, sub, m);
+        if (pos < 0) break;
+        res++;
+        i += pos + m;
+    }
+    
+    return res;
+}
+
+// Copies str (n chars) into res with every non-overlapping sub replaced by rep, res must have room for result
+ICE_STR_API int ICE_STR_CALLCONV ice_str_search_replace(char* res, const char* str, int n, const char* sub, int m, const char* rep, int r) {
+    int len = 0;
+    int i = 0;
+    
+    for (;;) {
+        int pos = ice_str_search(str + i, n - i, sub, m);
+        if (pos < 0) break;
+        
+        memcpy(res + len, str + i, pos);
+        len += pos;
+        memcpy(res + len, rep, r);
+        len += r;
+        i += pos + m;
+    }
+    
+    memcpy(res + len, str + i, n - i);
+    return len + (n - i);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_find(char* str, char* sub) {
+    return ice_str_search(str, ice_str_len(str), sub, ice_str_len(sub));
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_rfind(char* str, char* sub) {
+    return ice_str_rsearch(str, ice_str_len(str), sub, ice_str_len(sub));
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_contains(char* str, char* sub) {
+    return (ice_str_find(str, sub) >= 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_count(char* str, char* sub) {
+    return ice_str_search_count(str, ice_str_len(str), sub, ice_str_len(sub));
+}
+
+// Matches are counted first, So result is allocated once with exact size
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_replace(char* str, char* sub, char* rep) {
+    int lenstr = ice_str_len(str);
+    int lensub = ice_str_len(sub);
+    int lenrep = ice_str_len(rep);
+    int count = ice_str_search_count(str, lenstr, sub, lensub);
+    char* res = (char*) ICE_STR_MALLOC(lenstr + count * (lenrep - lensub) + 1);
+    
+    if (res == NULL) {
+        return NULL;
+    }
+    
+    if (count == 0) {
+        memcpy(res, str, lenstr + 1);
+        return res;
+    }
+    
+    res[ice_str_search_replace(res, str, lenstr, sub, lensub, rep, lenrep)] = '\0';
+    return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_str BUFFERS
+///////////////////////////////////////////////////////////////////////////////////////////
+// Length of ice_str_buf is stored, So functions here never scan for NUL and compare lengths before bytes.
+// Indexes are clamped to string bounds, Functions returning new buffer return empty one if memory can't be allocated.
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_new(void) {
+    ice_str_buf res;
+    
+    memset(&res, 0, sizeof(res));
+    res.cap = ICE_STR_SSO_CAP;
+    return res;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_buf_cstr(const ice_str_buf* buf) {
+    return (buf->cap > ICE_STR_SSO_CAP) ? buf->data.heap : (char*) buf->data.sso;
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_buf_len(const ice_str_buf* buf) {
+    return buf->len;
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_buf_clamp(int n, int len) {
+    return (n < 0) ? 0 : ((n > len) ? len : n);
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_reserve(ice_str_buf* buf, int cap) {
+    char* mem;
+    
+    if (cap <= buf->cap) {
+        return ICE_STR_TRUE;
+    }
+    
+    if (buf->cap > ICE_STR_SSO_CAP) {
+        mem = (char*) ICE_STR_REALLOC(buf->data.heap, cap + 1);
+        
+        if (mem == NULL) {
+            return ICE_STR_FALSE;
+        }
+    } else {
+        mem = (char*) ICE_STR_MALLOC(cap + 1);
+        
+        if (mem == NULL) {
+            return ICE_STR_FALSE;
+        }
+        
+        memcpy(mem, buf->data.sso, buf->len + 1);
+    }
+    
+    buf->data.heap = mem;
+    buf->cap = cap;
+    return ICE_STR_TRUE;
+}
+
+// Makes room for len more bytes, Growing capacity by ICE_STR_GROWTH_FACTOR so appending is amortized O(1)
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_grow(ice_str_buf* buf, int len) {
+    int need = buf->len + len;
+    int cap;
+    
+    if (need <= buf->cap) {
+        return ICE_STR_TRUE;
+    }
+    
+    cap = (int) (buf->cap * ICE_STR_GROWTH_FACTOR);
+    return ice_str_buf_reserve(buf, (cap < need) ? need : cap);
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_append_len(ice_str_buf* buf, char* str, int len) {
+    char* dst = ice_str_buf_cstr(buf);
+    int offset = -1;
+    
+    if (len <= 0) {
+        return ICE_STR_TRUE;
+    }
+    
+    // str could point into buf itself, So it's found again after growing moves memory
+    if (str >= dst && str <= dst + buf->len) {
+        offset = (int) (str - dst);
+    }
+    
+    if (ice_str_buf_grow(buf, len) == ICE_STR_FALSE) {
+        return ICE_STR_FALSE;
+    }
+    
+    dst = ice_str_buf_cstr(buf);
+    
+    if (offset >= 0) {
+        str = dst + offset;
+    }
+    
+    memmove(dst + buf->len, str, len);
+    buf->len += len;
+    dst[buf->len] = '\0';
+    return ICE_STR_TRUE;
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_append(ice_str_buf* buf, char* str) {
+    return ice_str_buf_append_len(buf, str, (int) strlen(str));
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_append_buf(ice_str_buf* buf, const ice_str_buf* other) {
+    return ice_str_buf_append_len(buf, ice_str_buf_cstr(other), other->len);
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_append_char(ice_str_buf* buf, char ch) {
+    return ice_str_buf_append_len(buf, &ch, 1);
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_from_len(char* str, int len) {
+    ice_str_buf res = ice_str_buf_new();
+    ice_str_buf_append_len(&res, str, len);
+    return res;
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_from(char* str) {
+    return ice_str_buf_from_len(str, (int) strlen(str));
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_buf_to_str(const ice_str_buf* buf) {
+    char* res = (char*) ICE_STR_MALLOC(buf->len + 1);
+    
+    if (res != NULL) {
+        memcpy(res, ice_str_buf_cstr(buf), buf->len + 1);
+    }
+    
+    return res;
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_buf_clear(ice_str_buf* buf) {
+    buf->len = 0;
+    ice_str_buf_cstr(buf)[0] = '\0';
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_sub(const ice_str_buf* buf, int from, int to) {
+    from = ice_str_buf_clamp(from, buf->len);
+    to = ice_str_buf_clamp(to + 1, buf->len);
+    return ice_str_buf_from_len(ice_str_buf_cstr(buf) + from, to - from);
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_clone(const ice_str_buf* buf) {
+    return ice_str_buf_from_len(ice_str_buf_cstr(buf), buf->len);
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_concat(const ice_str_buf* b1, const ice_str_buf* b2) {
+    ice_str_buf res = ice_str_buf_new();
+    
+    if (ice_str_buf_reserve(&res, b1->len + b2->len) == ICE_STR_TRUE) {
+        ice_str_buf_append_len(&res, ice_str_buf_cstr(b1), b1->len);
+        ice_str_buf_append_len(&res, ice_str_buf_cstr(b2), b2->len);
+    }
+    
+    return res;
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_rep(const ice_str_buf* buf, int count) {
+    ice_str_buf res = ice_str_buf_new();
+    
+    if (count > 0 && ice_str_buf_reserve(&res, buf->len * count) == ICE_STR_TRUE) {
+        for (int i = 0; i < count; i++) {
+            ice_str_buf_append_len(&res, ice_str_buf_cstr(buf), buf->len);
+        }
+    }
+    
+    return res;
+}
+
+// Returns NUL character if index is out of bounds
+ICE_STR_API char ICE_STR_CALLCONV ice_str_buf_char(const ice_str_buf* buf, int index) {
+    return (index >= 0 && index < buf->len) ? ice_str_buf_cstr(buf)[index] : '\0';
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_match(const ice_str_buf* b1, const ice_str_buf* b2) {
+    if (b1->len != b2->len) {
+        return ICE_STR_FALSE;
+    }
+    
+    return (memcmp(ice_str_buf_cstr(b1), ice_str_buf_cstr(b2), b1->len) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Converts ASCII letters in range [from, to) of buf to upper case (upper is 1) or lower case (upper is 0)
+ICE_STR_API void ICE_STR_CALLCONV ice_str_buf_case(ice_str_buf* buf, int from, int to, int upper) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    char* str = ice_str_buf_cstr(buf) + from;
+    
+    if (upper) k->upper(str, str, to - from);
+    else k->lower(str, str, to - from);
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_buf_upper_in_place(ice_str_buf* buf) {
+    ice_str_buf_case(buf, 0, buf->len, 1);
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_buf_lower_in_place(ice_str_buf* buf) {
+    ice_str_buf_case(buf, 0, buf->len, 0);
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_upper(const ice_str_buf* buf) {
+    ice_str_buf res = ice_str_buf_clone(buf);
+    ice_str_buf_case(&res, 0, res.len, 1);
+    return res;
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_lower(const ice_str_buf* buf) {
+    ice_str_buf res = ice_str_buf_clone(buf);
+    ice_str_buf_case(&res, 0, res.len, 0);
+    return res;
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_capitalize(const ice_str_buf* buf) {
+    ice_str_buf res = ice_str_buf_clone(buf);
+    ice_str_buf_case(&res, 0, (res.len > 0) ? 1 : 0, 1);
+    return res;
+}
+
+// Returns array of count buffers (Free with ice_str_buf_arr_free), Empty string gives no buffers and
+// delimiter at end of string doesn't give empty buffer after it (Same as ice_str_split)
+ICE_STR_API ice_str_buf* ICE_STR_CALLCONV ice_str_buf_split(const ice_str_buf* buf, char delim, int* count) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    char* str = ice_str_buf_cstr(buf);
+    ice_str_buf* res;
+    int len = k->count(str, buf->len, delim);
+    ice_str_tok tok = ice_str_tok_new_len(str, buf->len, delim);
+    ice_str_view view;
+    
+    *count = 0;
+    
+    if (buf->len > 0 && str[buf->len - 1] != delim) {
+        len++;
+    }
+    
+    res = (ice_str_buf*) ICE_STR_MALLOC(((len > 0) ? len : 1) * sizeof(ice_str_buf));
+    
+    if (res == NULL) {
+        return NULL;
+    }
+    
+    while (ice_str_tok_next(&tok, &view) == ICE_STR_TRUE) {
+        res[(*count)++] = ice_str_view_to_buf(view);
+    }
+    
+    return res;
+}
+
+ICE_STR_API ice_str_buf* ICE_STR_CALLCONV ice_str_buf_splitlines(const ice_str_buf* buf, int* count) {
+    return ice_str_buf_split(buf, '\n', count);
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_join_with_delim_ex(const ice_str_buf* bufs, int count, char* delim, int delim_len) {
+    ice_str_buf res = ice_str_buf_new();
+    int total = 0;
+    
+    for (int i = 0; i < count; i++) {
+        total += bufs[i].len + ((i > 0) ? delim_len : 0);
+    }
+    
+    if (ice_str_buf_reserve(&res, total) == ICE_STR_TRUE) {
+        for (int i = 0; i < count; i++) {
+            if (i > 0) ice_str_buf_append_len(&res, delim, delim_len);
+            ice_str_buf_append_len(&res, ice_str_buf_cstr(&bufs[i]), bufs[i].len);
+        }
+    }
+    
+    return res;
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_join(const ice_str_buf* bufs, int count) {
+    return ice_str_buf_join_with_delim_ex(bufs, count, NULL, 0);
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_join_with_delim(const ice_str_buf* bufs, int count, char delim) {
+    return ice_str_buf_join_with_delim_ex(bufs, count, &delim, 1);
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_begin(const ice_str_buf* b1, const ice_str_buf* b2) {
+    if (b2->len > b1->len) {
+        return ICE_STR_FALSE;
+    }
+    
+    return (memcmp(ice_str_buf_cstr(b1), ice_str_buf_cstr(b2), b2->len) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_end(const ice_str_buf* b1, const ice_str_buf* b2) {
+    if (b2->len > b1->len) {
+        return ICE_STR_FALSE;
+    }
+    
+    return (memcmp(ice_str_buf_cstr(b1) + (b1->len - b2->len), ice_str_buf_cstr(b2), b2->len) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_end_char(const ice_str_buf* buf, char ch) {
+    return (buf->len > 0 && ice_str_buf_cstr(buf)[buf->len - 1] == ch) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_rev(const ice_str_buf* buf) {
+    ice_str_buf res = ice_str_buf_clone(buf);
+    char* str = ice_str_buf_cstr(&res);
+    
+    if (res.len != buf->len) {
+        return res;
+    }
+    
+    for (int i = 0, j = res.len - 1; i < j; i++, j--) {
+        char temp = str[i];
+        str[i] = str[j];
+        str[j] = temp;
+    }
+    
+    return res;
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_buf_find_char(const ice_str_buf* buf, char ch) {
+    return ice_str_get_kernels()->find(ice_str_buf_cstr(buf), buf->len, ch);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_buf_count_char(const ice_str_buf* buf, char ch) {
+    return ice_str_get_kernels()->count(ice_str_buf_cstr(buf), buf->len, ch);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_buf_find(const ice_str_buf* buf, const ice_str_buf* sub) {
+    return ice_str_search(ice_str_buf_cstr(buf), buf->len, ice_str_buf_cstr(sub), sub->len);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_buf_rfind(const ice_str_buf* buf, const ice_str_buf* sub) {
+    return ice_str_rsearch(ice_str_buf_cstr(buf), buf->len, ice_str_buf_cstr(sub), sub->len);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_buf_count(const ice_str_buf* buf, const ice_str_buf* sub) {
+    return ice_str_search_count(ice_str_buf_cstr(buf), buf->len, ice_str_buf_cstr(sub), sub->len);
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_buf_replace(const ice_str_buf* buf, const ice_str_buf* sub, const ice_str_buf* rep) {
+    char* str = ice_str_buf_cstr(buf);
+    int count = ice_str_search_count(str, buf->len, ice_str_buf_cstr(sub), sub->len);
+    ice_str_buf res = ice_str_buf_new();
+    
+    if (count == 0) {
+        ice_str_buf_append_len(&res, str, buf->len);
+        return res;
+    }
+    
+    if (ice_str_buf_reserve(&res, buf->len + count * (rep->len - sub->len)) == ICE_STR_TRUE) {
+        res.len = ice_str_search_replace(ice_str_buf_cstr(&res), str, buf->len, ice_str_buf_cstr(sub), sub->len, ice_str_buf_cstr(rep), rep->len);
+        ice_str_buf_cstr(&res)[res.len] = '\0';
+    }
+    
+    return res;
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_buf_free(ice_str_buf* buf) {
+    if (buf->cap > ICE_STR_SSO_CAP) {
+        ICE_STR_FREE(buf->data.heap);
+    }
+    
+    *buf = ice_str_buf_new();
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_buf_arr_free(ice_str_buf* bufs, int count) {
+    if (bufs == NULL) {
+        return;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        ice_str_buf_free(&bufs[i]);
+    }
+    
+    ICE_STR_FREE(bufs);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_str VIEWS AND TOKENIZER
+///////////////////////////////////////////////////////////////////////////////////////////
+// Views point into memory of existing string, So they allocate nothing and copy nothing.
+// They stay valid until string they point to gets freed or changed.
+ICE_STR_API ice_str_view ICE_STR_CALLCONV ice_str_view_from_len(char* str, int len) {
+    ice_str_view res;
+    res.ptr = str;
+    res.len = (len > 0) ? len : 0;
+    return res;
+}
+
+ICE_STR_API ice_str_view ICE_STR_CALLCONV ice_str_view_of(char* str) {
+    return ice_str_view_from_len(str, ice_str_len(str));
+}
+
+ICE_STR_API ice_str_view ICE_STR_CALLCONV ice_str_view_of_buf(const ice_str_buf* buf) {
+    return ice_str_view_from_len(ice_str_buf_cstr(buf), buf->len);
+}
+
+ICE_STR_API ice_str_view ICE_STR_CALLCONV ice_str_view_sub(ice_str_view view, int from, int to) {
+    from = ice_str_buf_clamp(from, view.len);
+    to = ice_str_buf_clamp(to + 1, view.len);
+    return ice_str_view_from_len(view.ptr + from, to - from);
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_view_match(ice_str_view v1, ice_str_view v2) {
+    if (v1.len != v2.len) {
+        return ICE_STR_FALSE;
+    }
+    
+    return (memcmp(v1.ptr, v2.ptr, v1.len) == 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Compares without scanning whole str first, Stops at first different char
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_view_match_str(ice_str_view view, char* str) {
+    for (int i = 0; i < view.len; i++) {
+        if (str[i] != view.ptr[i]) return ICE_STR_FALSE;
+    }
+    
+    return (str[view.len] == '\0') ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_view_match_nocase(ice_str_view v1, ice_str_view v2) {
+    if (v1.len != v2.len) {
+        return ICE_STR_FALSE;
+    }
+    
+    for (int i = 0; i < v1.len; i++) {
+        if (ice_str_lower_table[(unsigned char) v1.ptr[i]] != ice_str_lower_table[(unsigned char) v2.ptr[i]]) return ICE_STR_FALSE;
+    }
+    
+    return ICE_STR_TRUE;
+}
+
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_view_hash_nocase(ice_str_view view) {
+    return ice_str_hash_nocase_len(view.ptr, view.len);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_view_find_char(ice_str_view view, char ch) {
+    return ice_str_get_kernels()->find(view.ptr, view.len, ch);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_view_find(ice_str_view view, ice_str_view sub) {
+    return ice_str_search(view.ptr, view.len, sub.ptr, sub.len);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_view_rfind(ice_str_view view, ice_str_view sub) {
+    return ice_str_rsearch(view.ptr, view.len, sub.ptr, sub.len);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_view_count(ice_str_view view, ice_str_view sub) {
+    return ice_str_search_count(view.ptr, view.len, sub.ptr, sub.len);
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_view_to_str(ice_str_view view) {
+    char* res = (char*) ICE_STR_MALLOC(view.len + 1);
+    
+    if (res != NULL) {
+        memcpy(res, view.ptr, view.len);
+        res[view.len] = '\0';
+    }
+    
+    return res;
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_view_to_buf(ice_str_view view) {
+    return ice_str_buf_from_len(view.ptr, view.len);
+}
+
+ICE_STR_API ice_str_tok ICE_STR_CALLCONV ice_str_tok_new_len(char* str, int len, char delim) {
+    ice_str_tok res;
+    res.str = str;
+    res.len = (len > 0) ? len : 0;
+    res.pos = 0;
+    res.delim = delim;
+    return res;
+}
+
+ICE_STR_API ice_str_tok ICE_STR_CALLCONV ice_str_tok_new(char* str, char delim) {
+    return ice_str_tok_new_len(str, ice_str_len(str), delim);
+}
+
+// Yields same tokens as ice_str_split: Empty tokens between delimiters are yielded,
+// But delimiter at end of text doesn't yield empty token after it
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_tok_next(ice_str_tok* tok, ice_str_view* res) {
+    int end;
+    
+    if (tok->pos >= tok->len) {
+        return ICE_STR_FALSE;
+    }
+    
+    end = ice_str_get_kernels()->find(tok->str + tok->pos, tok->len - tok->pos, tok->delim);
+    end = (end < 0) ? tok->len : tok->pos + end;
+    
+    res->ptr = tok->str + tok->pos;
+    res->len = end - tok->pos;
+    tok->pos = end + 1;
+    return ICE_STR_TRUE;
+}
+
+// Fills res with up to max next tokens and returns their count (0 once all tokens were yielded)
+ICE_STR_API int ICE_STR_CALLCONV ice_str_tok_next_batch(ice_str_tok* tok, ice_str_view* res, int max) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    char* str = tok->str;
+    int pos = tok->pos;
+    int count = 0;
+    
+    while (count < max && pos < tok->len) {
+        int end = k->find(str + pos, tok->len - pos, tok->delim);
+        end = (end < 0) ? tok->len : pos + end;
+        
+        res[count].ptr = str + pos;
+        res[count].len = end - pos;
+        count++;
+        pos = end + 1;
+    }
+    
+    tok->pos = pos;
+    return count;
+}
+
+// Splits str into views without allocating, Returns count of tokens (Could be bigger than max, Then only max views are written)
+ICE_STR_API int ICE_STR_CALLCONV ice_str_split_views(char* str, char delim, ice_str_view* res, int max) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    int lenstr = k->len(str);
+    int count = k->count(str, lenstr, delim);
+    ice_str_tok tok = ice_str_tok_new_len(str, lenstr, delim);
+    
+    if (lenstr > 0 && str[lenstr - 1] != delim) {
+        count++;
+    }
+    
+    ice_str_tok_next_batch(&tok, res, max);
+    return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_str MATCHER
+///////////////////////////////////////////////////////////////////////////////////////////
+// Builds trie of patterns, Then turns it into full DFA by filling missing transitions from failure states (BFS order)
+ICE_STR_API ice_str_matcher ICE_STR_CALLCONV ice_str_matcher_build(char** patterns, int nocase) {
+    ice_str_matcher m;
+    int maxstates = 1;
+    int* fail;
+    int* queue;
+    
+    memset(&m, 0, sizeof(m));
+    
+    // Class 0 is for bytes that no pattern uses, With nocase both cases of letter share class
+    m.classes = 1;
+    
+    for (int p = 0; patterns[p] != NULL; p++) {
+        for (int i = 0; patterns[p][i] != '\0'; i++) {
+            unsigned char ch = (unsigned char) patterns[p][i];
+            if (nocase) ch = ice_str_lower_table[ch];
+            
+            if (m.cls[ch] == 0) {
+                m.cls[ch] = (unsigned char) m.classes;
+                if (nocase) m.cls[ice_str_upper_table[ch]] = (unsigned char) m.classes;
+                m.classes++;
+            }
+            
+            maxstates++;
+        }
+        
+        m.count++;
+    }
+    
+    m.next = (int*) ICE_STR_MALLOC((size_t) maxstates * m.classes * sizeof(int));
+    m.out = (int*) ICE_STR_MALLOC(maxstates * sizeof(int));
+    m.dict = (int*) ICE_STR_MALLOC(maxstates * sizeof(int));
+    m.link = (int*) ICE_STR_MALLOC((m.count + 1) * sizeof(int));
+    m.lens = (int*) ICE_STR_MALLOC((m.count + 1) * sizeof(int));
+    fail = (int*) ICE_STR_MALLOC(maxstates * sizeof(int));
+    queue = (int*) ICE_STR_MALLOC(maxstates * sizeof(int));
+    
+    if (m.next == NULL || m.out == NULL || m.dict == NULL || m.link == NULL || m.lens == NULL || fail == NULL || queue == NULL) {
+        ICE_STR_FREE(fail);
+        ICE_STR_FREE(queue);
+        ice_str_matcher_free(&m);
+        return m;
+    }
+    
+    // Trie (States here are plain indexes, -1 means no transition yet)
+    m.states = 1;
+    
+    for (int i = 0; i < m.classes; i++) m.next[i] = -1;
+    m.out[0] = -1;
+    m.dict[0] = 0;
+    
+    for (int p = 0; p < m.count; p++) {
+        int state = 0;
+        int len = 0;
+        
+        for (; patterns[p][len] != '\0'; len++) {
+            int* t = &m.next[state * m.classes + m.cls[(unsigned char) patterns[p][len]]];
+            
+            if (*t < 0) {
+                *t = m.states;
+                
+                for (int i = 0; i < m.classes; i++) m.next[m.states * m.classes + i] = -1;
+                m.out[m.states] = -1;
+                m.states++;
+            }
+            
+            state = *t;
+        }
+        
+        m.lens[p] = len;
+        m.link[p] = -1;
+        
+        // Empty pattern would match everywhere, So it's skipped
+        if (len == 0) continue;
+        
+        if (m.out[state] < 0) {
+            m.out[state] = p;
+        } else {
+            int q = m.out[state];
+            while (m.link[q] >= 0) q = m.link[q];
+            m.link[q] = p;
+        }
+    }
+    
+    // Failure links and missing transitions
+    int head = 0, tail = 0;
+    
+    for (int c = 0; c < m.classes; c++) {
+        int t = m.next[c];
+        
+        if (t < 0) {
+            m.next[c] = 0;
+        } else {
+            fail[t] = 0;
+            m.dict[t] = 0;
+            queue[tail++] = t;
+        }
+    }
+    
+    while (head < tail) {
+        int state = queue[head++];
+        
+        for (int c = 0; c < m.classes; c++) {
+            int* t = &m.next[state * m.classes + c];
+            int f = m.next[fail[state] * m.classes + c];
+            
+            if (*t < 0) {
+                *t = f;
+            } else {
+                fail[*t] = f;
+                m.dict[*t] = (m.out[f] >= 0) ? f : m.dict[f];
+                queue[tail++] = *t;
+            }
+        }
+    }
+    
+    // Premultiply states so scanning needs no multiply per byte, States with matches are stored inverted
+    // so scanning only checks sign of transition
+    for (int i = 0; i < m.states * m.classes; i++) {
+        int t = m.next[i];
+        m.next[i] = (m.out[t] >= 0 || m.dict[t] > 0) ? ~(t * m.classes) : t * m.classes;
+    }
+    
+    int* next = (int*) ICE_STR_REALLOC(m.next, (size_t) m.states * m.classes * sizeof(int));
+    if (next != NULL) m.next = next;
+    
+    ICE_STR_FREE(fail);
+    ICE_STR_FREE(queue);
+    return m;
+}
+
+ICE_STR_API ice_str_matcher ICE_STR_CALLCONV ice_str_matcher_new(char** patterns) {
+    return ice_str_matcher_build(patterns, 0);
+}
+
+ICE_STR_API ice_str_matcher ICE_STR_CALLCONV ice_str_matcher_new_nocase(char** patterns) {
+    return ice_str_matcher_build(patterns, 1);
+}
+
+// Scans n chars of str, Reports matches in order of their end index and returns count of them (Stops at first match if stop is 1)
+ICE_STR_API int ICE_STR_CALLCONV ice_str_matcher_run(const ice_str_matcher* m, const char* str, int n, ice_str_hit* res, int max, int stop) {
+    const int* next = m->next;
+    const unsigned char* cls = m->cls;
+    int state = 0;
+    int count = 0;
+    
+    if (m->next == NULL) {
+        return 0;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        state = next[state + cls[(unsigned char) str[i]]];
+        
+        if (state >= 0) {
+            continue;
+        }
+        
+        state = ~state;
+        
+        int s = state / m->classes;
+        if (m->out[s] < 0) s = m->dict[s];
+        
+        while (s > 0) {
+            for (int p = m->out[s]; p >= 0; p = m->link[p]) {
+                if (count < max) {
+                    res[count].pattern = p;
+                    res[count].pos = i - m->lens[p] + 1;
+                    res[count].len = m->lens[p];
+                }
+                
+                count++;
+                if (stop) return count;
+            }
+            
+            s = m->dict[s];
+        }
+    }
+    
+    return count;
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_matcher_any(const ice_str_matcher* m, char* str) {
+    return (ice_str_matcher_run(m, str, ice_str_len(str), NULL, 0, 1) > 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Gives match that ends first (Longest one if several end at same index)
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_matcher_first(const ice_str_matcher* m, char* str, ice_str_hit* hit) {
+    return (ice_str_matcher_run(m, str, ice_str_len(str), hit, 1, 1) > 0) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Returns count of all matches (Could be bigger than max, Then only max hits are written)
+ICE_STR_API int ICE_STR_CALLCONV ice_str_matcher_scan(const ice_str_matcher* m, char* str, ice_str_hit* res, int max) {
+    return ice_str_matcher_run(m, str, ice_str_len(str), res, max, 0);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_matcher_scan_view(const ice_str_matcher* m, ice_str_view view, ice_str_hit* res, int max) {
+    return ice_str_matcher_run(m, view.ptr, view.len, res, max, 0);
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_matcher_free(ice_str_matcher* m) {
+    ICE_STR_FREE(m->next);
+    ICE_STR_FREE(m->out);
+    ICE_STR_FREE(m->dict);
+    ICE_STR_FREE(m->link);
+    ICE_STR_FREE(m->lens);
+    
+    m->next = NULL;
+    m->out = NULL;
+    m->dict = NULL;
+    m->link = NULL;
+    m->lens = NULL;
+    m->states = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_str BUILDER
+///////////////////////////////////////////////////////////////////////////////////////////
+// Two digits per lookup when formatting numbers
+static const char ice_str_digits[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Writes digits of num backwards ending at end, Returns pointer to first digit
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_fmt_uint(char* end, unsigned long long num) {
+    while (num >= 100) {
+        int i = (int) (num % 100) * 2;
+        num /= 100;
+        *--end = ice_str_digits[i + 1];
+        *--end = ice_str_digits[i];
+    }
+    
+    if (num >= 10) {
+        int i = (int) num * 2;
+        *--end = ice_str_digits[i + 1];
+        *--end = ice_str_digits[i];
+    } else {
+        *--end = (char) ('0' + num);
+    }
+    
+    return end;
+}
+
+// Adds chunk that holds at least need chars, Chunks grow with built string so count of chunks stays O(log n)
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_grow(ice_str_builder* b, int need) {
+    int cap = (b->len > ICE_STR_BUILDER_CHUNK) ? b->len : ICE_STR_BUILDER_CHUNK;
+    ice_str_builder_chunk* chunk = (ice_str_builder_chunk*) ICE_STR_MALLOC(sizeof(ice_str_builder_chunk));
+    
+    if (chunk == NULL) {
+        return ICE_STR_FALSE;
+    }
+    
+    if (cap < need) cap = need;
+    chunk->data = (char*) ICE_STR_MALLOC(cap + 1);
+    
+    if (chunk->data == NULL) {
+        ICE_STR_FREE(chunk);
+        return ICE_STR_FALSE;
+    }
+    
+    chunk->next = NULL;
+    chunk->len = 0;
+    chunk->cap = cap;
+    
+    if (b->tail != NULL) b->tail->next = chunk;
+    else b->head = chunk;
+    
+    b->tail = chunk;
+    return ICE_STR_TRUE;
+}
+
+ICE_STR_API ice_str_builder ICE_STR_CALLCONV ice_str_builder_new(void) {
+    ice_str_builder res;
+    
+    res.head = NULL;
+    res.tail = NULL;
+    res.len = 0;
+    return res;
+}
+
+// Fills rest of current chunk first, So only one new chunk is needed for rest of str
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_len(ice_str_builder* b, char* str, int len) {
+    ice_str_builder_chunk* chunk = b->tail;
+    
+    if (chunk != NULL) {
+        int room = chunk->cap - chunk->len;
+        int n = (len < room) ? len : room;
+        
+        memcpy(chunk->data + chunk->len, str, n);
+        chunk->len += n;
+        b->len += n;
+        str += n;
+        len -= n;
+    }
+    
+    if (len > 0) {
+        if (ice_str_builder_grow(b, len) == ICE_STR_FALSE) {
+            return ICE_STR_FALSE;
+        }
+        
+        memcpy(b->tail->data, str, len);
+        b->tail->len = len;
+        b->len += len;
+    }
+    
+    return ICE_STR_TRUE;
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append(ice_str_builder* b, char* str) {
+    return ice_str_builder_append_len(b, str, ice_str_len(str));
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_char(ice_str_builder* b, char ch) {
+    if (b->tail == NULL || b->tail->len == b->tail->cap) {
+        if (ice_str_builder_grow(b, 1) == ICE_STR_FALSE) {
+            return ICE_STR_FALSE;
+        }
+    }
+    
+    b->tail->data[b->tail->len++] = ch;
+    b->len++;
+    return ICE_STR_TRUE;
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_view(ice_str_builder* b, ice_str_view view) {
+    return ice_str_builder_append_len(b, view.ptr, view.len);
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_buf(ice_str_builder* b, const ice_str_buf* buf) {
+    return ice_str_builder_append_len(b, ice_str_buf_cstr(buf), buf->len);
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_uint(ice_str_builder* b, unsigned long long num) {
+    char tmp[24];
+    char* end = tmp + sizeof(tmp);
+    char* start = ice_str_fmt_uint(end, num);
+    return ice_str_builder_append_len(b, start, (int) (end - start));
+}
+
+// Negated as unsigned, So LLONG_MIN works too
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_int(ice_str_builder* b, long long num) {
+    char tmp[24];
+    char* end = tmp + sizeof(tmp);
+    char* start = ice_str_fmt_uint(end, (num < 0) ? (0ULL - (unsigned long long) num) : (unsigned long long) num);
+    
+    if (num < 0) *--start = '-';
+    return ice_str_builder_append_len(b, start, (int) (end - start));
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_hex(ice_str_builder* b, unsigned long long num) {
+    char tmp[16];
+    char* end = tmp + sizeof(tmp);
+    char* start = end;
+    
+    do {
+        *--start = "0123456789abcdef"[num & 15];
+        num >>= 4;
+    } while (num != 0);
+    
+    return ice_str_builder_append_len(b, start, (int) (end - start));
+}
+
+// Fixed notation with precision (0 to 9) digits after point, Rounded half away from zero
+// Digits that don't fit into 64-bit integer after scaling are written as zeros (Double has only ~17 significant digits)
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_append_double(ice_str_builder* b, double num, int precision) {
+    static const double pow10[10] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+    char tmp[340];
+    char* end = tmp + sizeof(tmp);
+    char* start = end;
+    
+    if (num != num) return ice_str_builder_append_len(b, (char*) "nan", 3);
+    if (num > 1.7976931348623157e308) return ice_str_builder_append_len(b, (char*) "inf", 3);
+    if (num < -1.7976931348623157e308) return ice_str_builder_append_len(b, (char*) "-inf", 4);
+    
+    if (precision < 0) precision = 0;
+    if (precision > 9) precision = 9;
+    
+    int neg = (num < 0);
+    double val = neg ? -num : num;
+    int digits = precision;
+    int zeros = 0;
+    
+    while (digits > 0 && val * pow10[digits] >= 1.8e19) digits--;
+    
+    double scaled = val * pow10[digits] + 0.5;
+    
+    // Only 17 digits are kept for huge values, Rest of integer part is zeros
+    while (scaled >= 1.8e19 || (zeros > 0 && scaled >= 1e17)) {
+        scaled = (scaled - 0.5) / 10 + 0.5;
+        zeros++;
+    }
+    
+    unsigned long long n = (unsigned long long) scaled;
+    
+    for (int i = digits; i < precision; i++) *--start = '0';
+    
+    for (int i = 0; i < digits; i++) {
+        *--start = (char) ('0' + n % 10);
+        n /= 10;
+    }
+    
+    if (precision > 0) *--start = '.';
+    for (int i = 0; i < zeros; i++) *--start = '0';
+    
+    start = ice_str_fmt_uint(start, n);
+    if (neg) *--start = '-';
+    
+    return ice_str_builder_append_len(b, start, (int) (end - start));
+}
+
+// Supports %s %c %d %i %u %x %f %% with l, ll and z length modifiers and .N precision for %f (6 by default)
+// Numbers are formatted by ice_str_builder_append_* (sprintf isn't used), Unknown conversions are appended as they are
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_builder_appendf(ice_str_builder* b, const char* fmt, ...) {
+    ice_str_bool res = ICE_STR_TRUE;
+    va_list args;
+    
+    va_start(args, fmt);
+    
+    while (*fmt != '\0' && res == ICE_STR_TRUE) {
+        const char* lit = fmt;
+        
+        while (*fmt != '\0' && *fmt != '%') fmt++;
+        
+        if (fmt > lit) {
+            res = ice_str_builder_append_len(b, (char*) lit, (int) (fmt - lit));
+            continue;
+        }
+        
+        const char* spec = fmt++;
+        int precision = 6;
+        int longs = 0;
+        int sized = 0;
+        
+        if (*fmt == '.') {
+            precision = 0;
+            fmt++;
+            while (*fmt >= '0' && *fmt <= '9') precision = precision * 10 + (*fmt++ - '0');
+        }
+        
+        // z is size_t (Or ptrdiff_t for signed), Which isn't long long on 32-bit targets
+        while (*fmt == 'l' || *fmt == 'z') {
+            if (*fmt == 'z') sized = 1;
+            else longs++;
+            fmt++;
+        }
+        
+        switch (*fmt) {
+            case 's': res = ice_str_builder_append(b, va_arg(args, char*)); break;
+            case 'c': res = ice_str_builder_append_char(b, (char) va_arg(args, int)); break;
+            case '%': res = ice_str_builder_append_char(b, '%'); break;
+            case 'f': res = ice_str_builder_append_double(b, va_arg(args, double), precision); break;
+            case 'd':
+            case 'i': {
+                long long num = sized ? (long long) va_arg(args, ptrdiff_t) : (longs >= 2) ? va_arg(args, long long) : ((longs == 1) ? va_arg(args, long) : va_arg(args, int));
+                res = ice_str_builder_append_int(b, num);
+                break;
+            }
+            case 'u':
+            case 'x': {
+                unsigned long long num = sized ? (unsigned long long) va_arg(args, size_t) : (longs >= 2) ? va_arg(args, unsigned long long) : ((longs == 1) ? va_arg(args, unsigned long) : va_arg(args, unsigned int));
+                res = (*fmt == 'u') ? ice_str_builder_append_uint(b, num) : ice_str_builder_append_hex(b, num);
+                break;
+            }
+            default:
+                res = ice_str_builder_append_len(b, (char*) spec, (int) (fmt - spec) + (*fmt != '\0'));
+                break;
+        }
+        
+        if (*fmt != '\0') fmt++;
+    }
+    
+    va_end(args);
+    return res;
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_builder_len(const ice_str_builder* b) {
+    return b->len;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_builder_to_str(const ice_str_builder* b) {
+    char* res = (char*) ICE_STR_MALLOC(b->len + 1);
+    int len = 0;
+    
+    if (res == NULL) {
+        return NULL;
+    }
+    
+    for (ice_str_builder_chunk* chunk = b->head; chunk != NULL; chunk = chunk->next) {
+        memcpy(res + len, chunk->data, chunk->len);
+        len += chunk->len;
+    }
+    
+    res[len] = '\0';
+    return res;
+}
+
+ICE_STR_API ice_str_buf ICE_STR_CALLCONV ice_str_builder_to_buf(const ice_str_builder* b) {
+    ice_str_buf res = ice_str_buf_new();
+    
+    if (ice_str_buf_reserve(&res, b->len) == ICE_STR_TRUE) {
+        for (ice_str_builder_chunk* chunk = b->head; chunk != NULL; chunk = chunk->next) {
+            ice_str_buf_append_len(&res, chunk->data, chunk->len);
+        }
+    }
+    
+    return res;
+}
+
+// Returns built string and frees builder, Single chunk is handed over (Shrunk to fit) instead of copied
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_builder_finish(ice_str_builder* b) {
+    char* res;
+    
+    if (b->head != NULL && b->head == b->tail) {
+        char* mem = (char*) ICE_STR_REALLOC(b->head->data, b->len + 1);
+        
+        res = (mem != NULL) ? mem : b->head->data;
+        res[b->len] = '\0';
+        ICE_STR_FREE(b->head);
+        
+        b->head = NULL;
+        b->tail = NULL;
+        b->len = 0;
+        return res;
+    }
+    
+    res = ice_str_builder_to_str(b);
+    ice_str_builder_free(b);
+    return res;
+}
+
+// Keeps last (Biggest) chunk, So builder could be reused without allocating again
+ICE_STR_API void ICE_STR_CALLCONV ice_str_builder_clear(ice_str_builder* b) {
+    ice_str_builder_chunk* chunk = b->head;
+    
+    while (chunk != b->tail) {
+        ice_str_builder_chunk* next = chunk->next;
+        ICE_STR_FREE(chunk->data);
+        ICE_STR_FREE(chunk);
+        chunk = next;
+    }
+    
+    if (b->tail != NULL) b->tail->len = 0;
+    b->head = b->tail;
+    b->len = 0;
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_builder_free(ice_str_builder* b) {
+    ice_str_builder_chunk* chunk = b->head;
+    
+    while (chunk != NULL) {
+        ice_str_builder_chunk* next = chunk->next;
+        ICE_STR_FREE(chunk->data);
+        ICE_STR_FREE(chunk);
+        chunk = next;
+    }
+    
+    b->head = NULL;
+    b->tail = NULL;
+    b->len = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_str ROPE
+///////////////////////////////////////////////////////////////////////////////////////////
+// Internal nodes always have 2 children and no node is empty, Nodes are only owned by one rope
+// Nodes that edits could need are allocated before tree is touched, So failed allocation leaves rope unchanged
+typedef struct ice_str_rope_spare {
+    ice_str_rope_node* leaf[2];
+    ice_str_rope_node* inner[2];
+    int leaves;
+    int inners;
+} ice_str_rope_spare;
+
+#define ICE_STR_ROPE_CHARS(node) ((char*) ((node) + 1))
+
+ICE_STR_API ice_str_rope_node* ICE_STR_CALLCONV ice_str_rope_leaf_new(const char* str, int len) {
+    ice_str_rope_node* res = (ice_str_rope_node*) ICE_STR_MALLOC(sizeof(ice_str_rope_node) + ICE_STR_ROPE_LEAF);
+    
+    if (res != NULL) {
+        res->left = NULL;
+        res->right = NULL;
+        res->len = len;
+        res->depth = 0;
+        memcpy(ICE_STR_ROPE_CHARS(res), str, len);
+    }
+    
+    return res;
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_rope_node_free(ice_str_rope_node* node) {
+    if (node == NULL) {
+        return;
+    }
+    
+    ice_str_rope_node_free(node->left);
+    ice_str_rope_node_free(node->right);
+    ICE_STR_FREE(node);
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_rope_fix(ice_str_rope_node* node) {
+    node->len = node->left->len + node->right->len;
+    node->depth = 1 + ((node->left->depth > node->right->depth) ? node->left->depth : node->right->depth);
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_rope_spare_new(ice_str_rope_spare* sp, int leaves, int inners) {
+    sp->leaves = 0;
+    sp->inners = 0;
+    
+    while (sp->leaves < leaves) {
+        sp->leaf[sp->leaves] = (ice_str_rope_node*) ICE_STR_MALLOC(sizeof(ice_str_rope_node) + ICE_STR_ROPE_LEAF);
+        if (sp->leaf[sp->leaves] == NULL) return ICE_STR_FALSE;
+        sp->leaves++;
+    }
+    
+    while (sp->inners < inners) {
+        sp->inner[sp->inners] = (ice_str_rope_node*) ICE_STR_MALLOC(sizeof(ice_str_rope_node));
+        if (sp->inner[sp->inners] == NULL) return ICE_STR_FALSE;
+        sp->inners++;
+    }
+    
+    return ICE_STR_TRUE;
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_rope_spare_free(ice_str_rope_spare* sp) {
+    while (sp->leaves > 0) ICE_STR_FREE(sp->leaf[--sp->leaves]);
+    while (sp->inners > 0) ICE_STR_FREE(sp->inner[--sp->inners]);
+}
+
+// Builds balanced tree from leaves [from, to) using unused inner nodes from pool
+ICE_STR_API ice_str_rope_node* ICE_STR_CALLCONV ice_str_rope_build(ice_str_rope_node** leaves, int from, int to, ice_str_rope_node** pool) {
+    if (to - from == 1) {
+        return leaves[from];
+    }
+    
+    int mid = from + (to - from) / 2;
+    ice_str_rope_node* res = *pool;
+    
+    *pool = res->left;
+    res->left = ice_str_rope_build(leaves, from, mid, pool);
+    res->right = ice_str_rope_build(leaves, mid, to, pool);
+    ice_str_rope_fix(res);
+    return res;
+}
+
+// Splits text into full leaves of balanced tree, Returns ICE_STR_FALSE (With res set to NULL) if allocation fails
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_rope_from_text(const char* str, int len, ice_str_rope_node** res) {
+    int count = (len + ICE_STR_ROPE_LEAF - 1) / ICE_STR_ROPE_LEAF;
+    ice_str_rope_node* pool = NULL;
+    ice_str_rope_node** leaves;
+    
+    *res = NULL;
+    
+    if (len <= 0) {
+        return ICE_STR_TRUE;
+    }
+    
+    leaves = (ice_str_rope_node**) ICE_STR_MALLOC(count * sizeof(ice_str_rope_node*));
+    
+    if (leaves == NULL) {
+        return ICE_STR_FALSE;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        int n = (i == count - 1) ? len - i * ICE_STR_ROPE_LEAF : ICE_STR_ROPE_LEAF;
+        ice_str_rope_node* inner = (i > 0) ? (ice_str_rope_node*) ICE_STR_MALLOC(sizeof(ice_str_rope_node)) : NULL;
+        
+        leaves[i] = ice_str_rope_leaf_new(str + i * ICE_STR_ROPE_LEAF, n);
+        
+        if (leaves[i] == NULL || (i > 0 && inner == NULL)) {
+            if (leaves[i] != NULL) ICE_STR_FREE(leaves[i]);
+            if (inner != NULL) ICE_STR_FREE(inner);
+            while (i > 0) ICE_STR_FREE(leaves[--i]);
+            
+            while (pool != NULL) {
+                inner = pool->left;
+                ICE_STR_FREE(pool);
+                pool = inner;
+            }
+            
+            ICE_STR_FREE(leaves);
+            return ICE_STR_FALSE;
+        }
+        
+        // Unused inner nodes are chained through left
+        if (inner != NULL) {
+            inner->left = pool;
+            pool = inner;
+        }
+    }
+    
+    *res = ice_str_rope_build(leaves, 0, count, &pool);
+    ICE_STR_FREE(leaves);
+    return ICE_STR_TRUE;
+}
+
+// Joins 2 trees, 2 small leaves are merged into one, Else uses inner node from spare
+ICE_STR_API ice_str_rope_node* ICE_STR_CALLCONV ice_str_rope_join(ice_str_rope_node* a, ice_str_rope_node* b, ice_str_rope_spare* sp) {
+    if (a == NULL) return b;
+    if (b == NULL) return a;
+    
+    if (a->depth == 0 && b->depth == 0 && a->len + b->len <= ICE_STR_ROPE_LEAF) {
+        memcpy(ICE_STR_ROPE_CHARS(a) + a->len, ICE_STR_ROPE_CHARS(b), b->len);
+        a->len += b->len;
+        ICE_STR_FREE(b);
+        return a;
+    }
+    
+    ice_str_rope_node* res = sp->inner[--sp->inners];
+    res->left = a;
+    res->right = b;
+    ice_str_rope_fix(res);
+    return res;
+}
+
+// Splits tree at pos into left and right trees, Nodes are reused so only splitting leaf takes node (Leaf from spare)
+ICE_STR_API void ICE_STR_CALLCONV ice_str_rope_split(ice_str_rope_node* node, int pos, ice_str_rope_node** l, ice_str_rope_node** r, ice_str_rope_spare* sp) {
+    if (node == NULL || pos <= 0) {
+        *l = NULL;
+        *r = node;
+        return;
+    }
+    
+    if (pos >= node->len) {
+        *l = node;
+        *r = NULL;
+        return;
+    }
+    
+    if (node->depth == 0) {
+        ice_str_rope_node* right = sp->leaf[--sp->leaves];
+        
+        right->left = NULL;
+        right->right = NULL;
+        right->len = node->len - pos;
+        right->depth = 0;
+        memcpy(ICE_STR_ROPE_CHARS(right), ICE_STR_ROPE_CHARS(node) + pos, right->len);
+        
+        node->len = pos;
+        *l = node;
+        *r = right;
+        return;
+    }
+    
+    int w = node->left->len;
+    ice_str_rope_node* a;
+    ice_str_rope_node* b;
+    
+    if (pos < w) {
+        ice_str_rope_split(node->left, pos, &a, &b, sp);
+        node->left = b;
+        ice_str_rope_fix(node);
+        *l = a;
+        *r = node;
+    } else if (pos > w) {
+        ice_str_rope_split(node->right, pos - w, &a, &b, sp);
+        node->right = a;
+        ice_str_rope_fix(node);
+        *l = node;
+        *r = b;
+    } else {
+        *l = node->left;
+        *r = node->right;
+        ICE_STR_FREE(node);
+    }
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_rope_count_leaves(const ice_str_rope_node* node) {
+    return (node->depth == 0) ? 1 : ice_str_rope_count_leaves(node->left) + ice_str_rope_count_leaves(node->right);
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_rope_collect(ice_str_rope_node* node, ice_str_rope_node** leaves, int* count, ice_str_rope_node** pool) {
+    if (node->depth == 0) {
+        leaves[(*count)++] = node;
+        return;
+    }
+    
+    ice_str_rope_collect(node->left, leaves, count, pool);
+    ice_str_rope_collect(node->right, leaves, count, pool);
+    node->left = *pool;
+    *pool = node;
+}
+
+// Rebuilds tree once it's much deeper than balanced tree would be (Kept as is if array of leaves can't be allocated)
+ICE_STR_API void ICE_STR_CALLCONV ice_str_rope_balance(ice_str_rope* rope) {
+    int limit = 8;
+    
+    if (rope->root == NULL) {
+        return;
+    }
+    
+    for (int n = rope->root->len / (ICE_STR_ROPE_LEAF / 2); n > 0; n >>= 1) limit += 2;
+    
+    if (rope->root->depth <= limit) {
+        return;
+    }
+    
+    int count = ice_str_rope_count_leaves(rope->root);
+    ice_str_rope_node** leaves = (ice_str_rope_node**) ICE_STR_MALLOC(count * sizeof(ice_str_rope_node*));
+    ice_str_rope_node* pool = NULL;
+    
+    if (leaves == NULL) {
+        return;
+    }
+    
+    count = 0;
+    ice_str_rope_collect(rope->root, leaves, &count, &pool);
+    rope->root = ice_str_rope_build(leaves, 0, count, &pool);
+    ICE_STR_FREE(leaves);
+}
+
+ICE_STR_API ice_str_rope ICE_STR_CALLCONV ice_str_rope_new_len(char* str, int len) {
+    ice_str_rope res;
+    ice_str_rope_from_text(str, len, &res.root);
+    return res;
+}
+
+ICE_STR_API ice_str_rope ICE_STR_CALLCONV ice_str_rope_new(char* str) {
+    return ice_str_rope_new_len(str, ice_str_len(str));
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_rope_len(const ice_str_rope* rope) {
+    return (rope->root != NULL) ? rope->root->len : 0;
+}
+
+// Returns '\0' if index is out of bounds
+ICE_STR_API char ICE_STR_CALLCONV ice_str_rope_char(const ice_str_rope* rope, int index) {
+    const ice_str_rope_node* node = rope->root;
+    
+    if (node == NULL || index < 0 || index >= node->len) {
+        return '\0';
+    }
+    
+    while (node->depth > 0) {
+        if (index < node->left->len) {
+            node = node->left;
+        } else {
+            index -= node->left->len;
+            node = node->right;
+        }
+    }
+    
+    return ICE_STR_ROPE_CHARS(node)[index];
+}
+
+// Small text that fits into leaf at pos is inserted in place without allocating
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_rope_insert_len(ice_str_rope* rope, int pos, char* str, int len) {
+    ice_str_rope_node* node = rope->root;
+    ice_str_rope_node* text;
+    ice_str_rope_node* l;
+    ice_str_rope_node* r;
+    ice_str_rope_spare sp;
+    
+    if (len <= 0) {
+        return ICE_STR_TRUE;
+    }
+    
+    pos = (pos < 0) ? 0 : ((pos > ice_str_rope_len(rope)) ? ice_str_rope_len(rope) : pos);
+    
+    if (node != NULL) {
+        int at = pos;
+        
+        while (node->depth > 0) {
+            if (at <= node->left->len) {
+                node = node->left;
+            } else {
+                at -= node->left->len;
+                node = node->right;
+            }
+        }
+        
+        if (node->len + len <= ICE_STR_ROPE_LEAF) {
+            char* chars = ICE_STR_ROPE_CHARS(node);
+            
+            memmove(chars + at + len, chars + at, node->len - at);
+            memcpy(chars + at, str, len);
+            
+            for (node = rope->root; node->depth > 0; ) {
+                node->len += len;
+                
+                if (pos <= node->left->len) {
+                    node = node->left;
+                } else {
+                    pos -= node->left->len;
+                    node = node->right;
+                }
+            }
+            
+            node->len += len;
+            return ICE_STR_TRUE;
+        }
+    }
+    
+    if (ice_str_rope_spare_new(&sp, 1, 2) == ICE_STR_FALSE || ice_str_rope_from_text(str, len, &text) == ICE_STR_FALSE) {
+        ice_str_rope_spare_free(&sp);
+        return ICE_STR_FALSE;
+    }
+    
+    ice_str_rope_split(rope->root, pos, &l, &r, &sp);
+    rope->root = ice_str_rope_join(ice_str_rope_join(l, text, &sp), r, &sp);
+    ice_str_rope_spare_free(&sp);
+    ice_str_rope_balance(rope);
+    return ICE_STR_TRUE;
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_rope_insert(ice_str_rope* rope, int pos, char* str) {
+    return ice_str_rope_insert_len(rope, pos, str, ice_str_len(str));
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_rope_append(ice_str_rope* rope, char* str) {
+    return ice_str_rope_insert_len(rope, ice_str_rope_len(rope), str, ice_str_len(str));
+}
+
+// Removes len chars starting at pos (Range is clamped to rope bounds)
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_rope_erase(ice_str_rope* rope, int pos, int len) {
+    int total = ice_str_rope_len(rope);
+    ice_str_rope_node* l;
+    ice_str_rope_node* m;
+    ice_str_rope_node* r;
+    ice_str_rope_spare sp;
+    
+    if (pos < 0) {
+        len += pos;
+        pos = 0;
+    }
+    
+    if (len > total - pos) len = total - pos;
+    
+    if (len <= 0) {
+        return ICE_STR_TRUE;
+    }
+    
+    // Range inside one leaf (That keeps some chars) is removed in place
+    ice_str_rope_node* node = rope->root;
+    int at = pos;
+    
+    while (node->depth > 0) {
+        if (at < node->left->len) {
+            node = node->left;
+        } else {
+            at -= node->left->len;
+            node = node->right;
+        }
+    }
+    
+    if (at + len <= node->len && len < node->len) {
+        char* chars = ICE_STR_ROPE_CHARS(node);
+        memmove(chars + at, chars + at + len, node->len - at - len);
+        
+        for (node = rope->root; node->depth > 0; ) {
+            node->len -= len;
+            
+            if (pos < node->left->len) {
+                node = node->left;
+            } else {
+                pos -= node->left->len;
+                node = node->right;
+            }
+        }
+        
+        node->len -= len;
+        return ICE_STR_TRUE;
+    }
+    
+    if (ice_str_rope_spare_new(&sp, 2, 1) == ICE_STR_FALSE) {
+        ice_str_rope_spare_free(&sp);
+        return ICE_STR_FALSE;
+    }
+    
+    ice_str_rope_split(rope->root, pos, &l, &m, &sp);
+    ice_str_rope_split(m, len, &m, &r, &sp);
+    ice_str_rope_node_free(m);
+    rope->root = ice_str_rope_join(l, r, &sp);
+    ice_str_rope_spare_free(&sp);
+    ice_str_rope_balance(rope);
+    return ICE_STR_TRUE;
+}
+
+// Moves all text of other into rope at pos without copying it, other becomes empty
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_rope_splice(ice_str_rope* rope, int pos, ice_str_rope* other) {
+    ice_str_rope_node* l;
+    ice_str_rope_node* r;
+    ice_str_rope_spare sp;
+    
+    if (other->root == NULL || other == rope) {
+        return (other == rope) ? ICE_STR_FALSE : ICE_STR_TRUE;
+    }
+    
+    if (ice_str_rope_spare_new(&sp, 1, 2) == ICE_STR_FALSE) {
+        ice_str_rope_spare_free(&sp);
+        return ICE_STR_FALSE;
+    }
+    
+    pos = (pos < 0) ? 0 : ((pos > ice_str_rope_len(rope)) ? ice_str_rope_len(rope) : pos);
+    
+    ice_str_rope_split(rope->root, pos, &l, &r, &sp);
+    rope->root = ice_str_rope_join(ice_str_rope_join(l, other->root, &sp), r, &sp);
+    other->root = NULL;
+    ice_str_rope_spare_free(&sp);
+    ice_str_rope_balance(rope);
+    return ICE_STR_TRUE;
+}
+
+// Copies chars [from, to) of subtree to res
+ICE_STR_API void ICE_STR_CALLCONV ice_str_rope_copy(const ice_str_rope_node* node, int from, int to, char* res) {
+    if (node->depth == 0) {
+        memcpy(res, ICE_STR_ROPE_CHARS(node) + from, to - from);
+        return;
+    }
+    
+    int w = node->left->len;
+    
+    if (from < w) {
+        ice_str_rope_copy(node->left, from, (to < w) ? to : w, res);
+    }
+    
+    if (to > w) {
+        int start = (from > w) ? from : w;
+        ice_str_rope_copy(node->right, start - w, to - w, res + (start - from));
+    }
+}
+
+// Returns substring from index from -> index to (Indexes are clamped to rope bounds)
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_rope_sub(const ice_str_rope* rope, int from, int to) {
+    int len = ice_str_rope_len(rope);
+    char* res;
+    
+    from = (from < 0) ? 0 : ((from > len) ? len : from);
+    to = (to + 1 < from) ? from : ((to + 1 > len) ? len : to + 1);
+    res = (char*) ICE_STR_MALLOC(to - from + 1);
+    
+    if (res != NULL) {
+        if (to > from) ice_str_rope_copy(rope->root, from, to, res);
+        res[to - from] = '\0';
+    }
+    
+    return res;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_rope_to_str(const ice_str_rope* rope) {
+    return ice_str_rope_sub(rope, 0, ice_str_rope_len(rope) - 1);
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_rope_free(ice_str_rope* rope) {
+    ice_str_rope_node_free(rope->root);
+    rope->root = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_str HASHING AND INTERNING
+///////////////////////////////////////////////////////////////////////////////////////////
+// wyhash (Public domain, By Wang Yi), Fast non-cryptographic 64-bit hash
+// Reads are little-endian, So big-endian machines give different (But equally good) hashes
+static const unsigned long long ice_str_wy_secret[4] = { 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL };
+
+// 64x64 -> 128-bit multiply, Low half goes to a and high half to b (Also used by number parsing and formatting)
+ICE_STR_API void ICE_STR_CALLCONV ice_str_mul128(unsigned long long* a, unsigned long long* b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t) *a * *b;
+    *a = (unsigned long long) r;
+    *b = (unsigned long long) (r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    unsigned long long ha = *a >> 32, hb = *b >> 32, la = (unsigned int) *a, lb = (unsigned int) *b;
+    unsigned long long rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+    unsigned long long c = t < rl;
+    unsigned long long lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_wy_mix(unsigned long long a, unsigned long long b) {
+    ice_str_mul128(&a, &b);
+    return a ^ b;
+}
+
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_wy_r8(const unsigned char* p) {
+    unsigned long long v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_wy_r4(const unsigned char* p) {
+    unsigned int v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_wyhash(const void* key, int len, unsigned long long seed) {
+    const unsigned char* p = (const unsigned char*) key;
+    const unsigned long long* s = ice_str_wy_secret;
+    unsigned long long a, b;
+    int i = len;
+    
+    seed ^= ice_str_wy_mix(seed ^ s[0], s[1]);
+    
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (ice_str_wy_r4(p) << 32) | ice_str_wy_r4(p + ((len >> 3) << 2));
+            b = (ice_str_wy_r4(p + len - 4) << 32) | ice_str_wy_r4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = ((unsigned long long) p[0] << 16) | ((unsigned long long) p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = 0;
+            b = 0;
+        }
+    } else {
+        if (i > 48) {
+            unsigned long long see1 = seed, see2 = seed;
+            
+            do {
+                seed = ice_str_wy_mix(ice_str_wy_r8(p) ^ s[1], ice_str_wy_r8(p + 8) ^ seed);
+                see1 = ice_str_wy_mix(ice_str_wy_r8(p + 16) ^ s[2], ice_str_wy_r8(p + 24) ^ see1);
+                see2 = ice_str_wy_mix(ice_str_wy_r8(p + 32) ^ s[3], ice_str_wy_r8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            
+            seed ^= see1 ^ see2;
+        }
+        
+        while (i > 16) {
+            seed = ice_str_wy_mix(ice_str_wy_r8(p) ^ s[1], ice_str_wy_r8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        
+        a = ice_str_wy_r8(p + i - 16);
+        b = ice_str_wy_r8(p + i - 8);
+    }
+    
+    a ^= s[1];
+    b ^= seed;
+    ice_str_mul128(&a, &b);
+    return ice_str_wy_mix(a ^ s[0] ^ (unsigned long long) len, b ^ s[1]);
+}
+
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_hash_len(char* str, int len) {
+    return ice_str_wyhash(str, len, 0);
+}
+
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_hash(char* str) {
+    return ice_str_wyhash(str, ice_str_len(str), 0);
+}
+
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_view_hash(ice_str_view view) {
+    return ice_str_wyhash(view.ptr, view.len, 0);
+}
+
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_buf_hash(const ice_str_buf* buf) {
+    return ice_str_wyhash(ice_str_buf_cstr(buf), buf->len, 0);
+}
+
+// Header stored right before chars of each interned string
+typedef struct ice_str_intern_header {
+    unsigned long long hash;
+    int len;
+    int pad;
+} ice_str_intern_header;
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_intern_len(const char* handle) {
+    return ((const ice_str_intern_header*) handle - 1)->len;
+}
+
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_intern_hash(const char* handle) {
+    return ((const ice_str_intern_header*) handle - 1)->hash;
+}
+
+ICE_STR_API ice_str_intern_pool ICE_STR_CALLCONV ice_str_intern_pool_new(void) {
+    ice_str_intern_pool res;
+    
+    memset(&res, 0, sizeof(res));
+    return res;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern_pool_lookup(const ice_str_intern_pool* pool, const char* str, int len, unsigned long long hash) {
+    if (pool->cap == 0) {
+        return NULL;
+    }
+    
+    unsigned int mask = (unsigned int) pool->cap - 1;
+    
+    for (unsigned int i = (unsigned int) hash & mask; pool->slots[i].str != NULL; i = (i + 1) & mask) {
+        char* cand = pool->slots[i].str;
+        
+        if (pool->slots[i].hash == hash && ice_str_intern_len(cand) == len && memcmp(cand, str, len) == 0) {
+            return cand;
+        }
+    }
+    
+    return NULL;
+}
+
+// Table is kept at most 3/4 full, Slots are moved by their stored hash so strings aren't hashed again
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_intern_pool_grow(ice_str_intern_pool* pool) {
+    int cap = (pool->cap == 0) ? 64 : pool->cap * 2;
+    ice_str_intern_slot* slots = (ice_str_intern_slot*) ICE_STR_CALLOC(cap, sizeof(ice_str_intern_slot));
+    
+    if (slots == NULL) {
+        return ICE_STR_FALSE;
+    }
+    
+    for (int i = 0; i < pool->cap; i++) {
+        if (pool->slots[i].str != NULL) {
+            unsigned int j = (unsigned int) pool->slots[i].hash & (unsigned int) (cap - 1);
+            while (slots[j].str != NULL) j = (j + 1) & (unsigned int) (cap - 1);
+            slots[j] = pool->slots[i];
+        }
+    }
+    
+    ICE_STR_FREE(pool->slots);
+    pool->slots = slots;
+    pool->cap = cap;
+    return ICE_STR_TRUE;
+}
+
+// Copies string with header to storage block, Strings too big for block get own block chained after current one
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern_pool_store(ice_str_intern_pool* pool, const char* str, int len, unsigned long long hash) {
+    int need = (int) ((sizeof(ice_str_intern_header) + len + 1 + 7) & ~(size_t) 7);
+    int head = (int) sizeof(ice_str_intern_header);
+    char* mem;
+    
+    if (need > ICE_STR_INTERN_BLOCK / 4) {
+        mem = (char*) ICE_STR_MALLOC(head + need);
+        if (mem == NULL) return NULL;
+        
+        if (pool->block != NULL) {
+            *(char**) mem = *(char**) pool->block;
+            *(char**) pool->block = mem;
+        } else {
+            *(char**) mem = NULL;
+            pool->block = mem;
+            pool->block_used = head + need;
+            pool->block_size = head + need;
+        }
+        
+        mem += head;
+    } else {
+        if (pool->block == NULL || pool->block_used + need > pool->block_size) {
+            char* block = (char*) ICE_STR_MALLOC(ICE_STR_INTERN_BLOCK);
+            if (block == NULL) return NULL;
+            
+            *(char**) block = pool->block;
+            pool->block = block;
+            pool->block_used = head;
+            pool->block_size = ICE_STR_INTERN_BLOCK;
+        }
+        
+        mem = pool->block + pool->block_used;
+        pool->block_used += need;
+    }
+    
+    ice_str_intern_header* h = (ice_str_intern_header*) mem;
+    h->hash = hash;
+    h->len = len;
+    h->pad = 0;
+    
+    char* res = (char*) (h + 1);
+    memcpy(res, str, len);
+    res[len] = '\0';
+    return res;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern_pool_insert(ice_str_intern_pool* pool, const char* str, int len, unsigned long long hash) {
+    char* res = ice_str_intern_pool_lookup(pool, str, len, hash);
+    
+    if (res != NULL) {
+        return res;
+    }
+    
+    if ((pool->count + 1) * 4 > pool->cap * 3 && ice_str_intern_pool_grow(pool) == ICE_STR_FALSE) {
+        return NULL;
+    }
+    
+    res = ice_str_intern_pool_store(pool, str, len, hash);
+    
+    if (res == NULL) {
+        return NULL;
+    }
+    
+    unsigned int mask = (unsigned int) pool->cap - 1;
+    unsigned int i = (unsigned int) hash & mask;
+    
+    while (pool->slots[i].str != NULL) i = (i + 1) & mask;
+    
+    pool->slots[i].hash = hash;
+    pool->slots[i].str = res;
+    pool->count++;
+    return res;
+}
+
+// Returns handle of string (Same pointer for equal strings), Or NULL if allocation failed
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern_pool_add_len(ice_str_intern_pool* pool, char* str, int len) {
+    return ice_str_intern_pool_insert(pool, str, len, ice_str_wyhash(str, len, 0));
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern_pool_add(ice_str_intern_pool* pool, char* str) {
+    return ice_str_intern_pool_add_len(pool, str, ice_str_len(str));
+}
+
+// Returns handle of string if it was interned, Else returns NULL (Doesn't add string)
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern_pool_find_len(const ice_str_intern_pool* pool, char* str, int len) {
+    return ice_str_intern_pool_lookup(pool, str, len, ice_str_wyhash(str, len, 0));
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern_pool_find(const ice_str_intern_pool* pool, char* str) {
+    return ice_str_intern_pool_find_len(pool, str, ice_str_len(str));
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_intern_pool_count(const ice_str_intern_pool* pool) {
+    return pool->count;
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_intern_pool_free(ice_str_intern_pool* pool) {
+    char* block = pool->block;
+    
+    while (block != NULL) {
+        char* prev = *(char**) block;
+        ICE_STR_FREE(block);
+        block = prev;
+    }
+    
+    ICE_STR_FREE(pool->slots);
+    memset(pool, 0, sizeof(*pool));
+}
+
+#if defined(ICE_STR_NO_THREADS)
+#  define ICE_STR_SHARD_LOCK(sh, i)
+#  define ICE_STR_SHARD_UNLOCK(sh, i)
+#elif defined(ICE_STR_MICROSOFT)
+typedef SRWLOCK ice_str_lock;
+#  define ICE_STR_SHARD_LOCK(sh, i) AcquireSRWLockExclusive(&((ice_str_lock*) (sh)->locks)[i])
+#  define ICE_STR_SHARD_UNLOCK(sh, i) ReleaseSRWLockExclusive(&((ice_str_lock*) (sh)->locks)[i])
+#else
+typedef pthread_mutex_t ice_str_lock;
+#  define ICE_STR_SHARD_LOCK(sh, i) pthread_mutex_lock(&((ice_str_lock*) (sh)->locks)[i])
+#  define ICE_STR_SHARD_UNLOCK(sh, i) pthread_mutex_unlock(&((ice_str_lock*) (sh)->locks)[i])
+#endif
+
+// Shard is picked by upper half of hash, Slots inside shard by lower half
+#define ICE_STR_SHARD_OF(hash) ((int) ((hash) >> 32) & (ICE_STR_INTERN_SHARDS - 1))
+
+// Returns sharded pool (locks is NULL if they couldn't be allocated, Then pool must not be used)
+ICE_STR_API ice_str_intern_sharded ICE_STR_CALLCONV ice_str_intern_sharded_new(void) {
+    ice_str_intern_sharded res;
+    
+    for (int i = 0; i < ICE_STR_INTERN_SHARDS; i++) {
+        res.shards[i] = ice_str_intern_pool_new();
+    }
+    
+    res.locks = NULL;
+    
+#if !defined(ICE_STR_NO_THREADS)
+    res.locks = ICE_STR_MALLOC(ICE_STR_INTERN_SHARDS * sizeof(ice_str_lock));
+    
+    if (res.locks != NULL) {
+        for (int i = 0; i < ICE_STR_INTERN_SHARDS; i++) {
+#if defined(ICE_STR_MICROSOFT)
+            InitializeSRWLock(&((ice_str_lock*) res.locks)[i]);
+#else
+            pthread_mutex_init(&((ice_str_lock*) res.locks)[i], NULL);
+#endif
+        }
+    }
+#endif
+    
+    return res;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern_sharded_add_len(ice_str_intern_sharded* sh, char* str, int len) {
+    unsigned long long hash = ice_str_wyhash(str, len, 0);
+    int i = ICE_STR_SHARD_OF(hash);
+    char* res;
+    
+    ICE_STR_SHARD_LOCK(sh, i);
+    res = ice_str_intern_pool_insert(&sh->shards[i], str, len, hash);
+    ICE_STR_SHARD_UNLOCK(sh, i);
+    return res;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern_sharded_add(ice_str_intern_sharded* sh, char* str) {
+    return ice_str_intern_sharded_add_len(sh, str, ice_str_len(str));
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_intern_sharded_find(ice_str_intern_sharded* sh, char* str) {
+    int len = ice_str_len(str);
+    unsigned long long hash = ice_str_wyhash(str, len, 0);
+    int i = ICE_STR_SHARD_OF(hash);
+    char* res;
+    
+    ICE_STR_SHARD_LOCK(sh, i);
+    res = ice_str_intern_pool_lookup(&sh->shards[i], str, len, hash);
+    ICE_STR_SHARD_UNLOCK(sh, i);
+    return res;
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_intern_sharded_count(ice_str_intern_sharded* sh) {
+    int res = 0;
+    
+    for (int i = 0; i < ICE_STR_INTERN_SHARDS; i++) {
+        ICE_STR_SHARD_LOCK(sh, i);
+        res += sh->shards[i].count;
+        ICE_STR_SHARD_UNLOCK(sh, i);
+    }
+    
+    return res;
+}
+
+// Must not be called while other threads use pool
+ICE_STR_API void ICE_STR_CALLCONV ice_str_intern_sharded_free(ice_str_intern_sharded* sh) {
+    for (int i = 0; i < ICE_STR_INTERN_SHARDS; i++) {
+        ice_str_intern_pool_free(&sh->shards[i]);
+    }
+    
+#if !defined(ICE_STR_NO_THREADS) && !defined(ICE_STR_MICROSOFT)
+    if (sh->locks != NULL) {
+        for (int i = 0; i < ICE_STR_INTERN_SHARDS; i++) {
+            pthread_mutex_destroy(&((ice_str_lock*) sh->locks)[i]);
+        }
+    }
+#endif
+    
+    ICE_STR_FREE(sh->locks);
+    sh->locks = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_str UTF-8
+///////////////////////////////////////////////////////////////////////////////////////////
+// Indexes here count codepoints instead of bytes, Text found to be pure ASCII by one SIMD pass takes byte path.
+// Codepoints are counted by their first bytes, So on invalid input stray continuation bytes stay with codepoint
+// before them and nothing is read out of bounds (Check text with ice_str_utf8_valid first if it matters).
+
+// Byte index of codepoint index (Or n if index is count of codepoints, -1 if it's bigger)
+ICE_STR_API int ICE_STR_CALLCONV ice_str_utf8_skip(ice_str_kernels* k, const char* str, int n, int index) {
+    int i;
+    
+    if (index < 0) {
+        return -1;
+    }
+    
+    i = k->ascii(str, n);
+    
+    if (index < i) {
+        return index;
+    }
+    
+    index -= i;
+    
+    // Blocks that end before codepoint are skipped by counting their first bytes with SIMD kernel
+    while (n - i >= 64) {
+        int count = k->utf8_len(str + i, 64);
+        if (count > index) break;
+        index -= count;
+        i += 64;
+    }
+    
+    for (; i < n; i++) {
+        if (((unsigned char) str[i] & 0xC0) != 0x80) {
+            if (index == 0) return i;
+            index--;
+        }
+    }
+    
+    return (index == 0) ? n : -1;
+}
+
+// Decodes codepoint at s and sets len to bytes it takes (First byte and continuation bytes after it)
+// Invalid sequences decode to U+FFFD
+ICE_STR_API int ICE_STR_CALLCONV ice_str_utf8_decode(const unsigned char* s, int n, int* len) {
+    int i = 1;
+    
+    while (i < n && (s[i] & 0xC0) == 0x80) i++;
+    *len = i;
+    
+    if (s[0] < 0x80) {
+        return s[0];
+    }
+    
+    if (ice_str_utf8_seq_len(s, n) != i) {
+        return 0xFFFD;
+    }
+    
+    switch (i) {
+        case 2: return ((s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+        case 3: return ((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+        default: return ((s[0] & 0x07) << 18) | ((s[1] & 0x3F) << 12) | ((s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+    }
+}
+
+// Codepoints that extend grapheme cluster before them (Combining marks, Spacing marks of main scripts,
+// Variation selectors, Emoji modifiers and tags), Sorted so they're binary searched
+static const int ice_str_utf8_extend[][2] = {
+    { 0x0300, 0x036F }, { 0x0483, 0x0489 }, { 0x0591, 0x05BD }, { 0x05BF, 0x05BF }, { 0x05C1, 0x05C2 },
+    { 0x05C4, 0x05C5 }, { 0x05C7, 0x05C7 }, { 0x0610, 0x061A }, { 0x064B, 0x065F }, { 0x0670, 0x0670 },
+    { 0x06D6, 0x06DC }, { 0x06DF, 0x06E4 }, { 0x06E7, 0x06E8 }, { 0x06EA, 0x06ED }, { 0x0711, 0x0711 },
+    { 0x0730, 0x074A }, { 0x07A6, 0x07B0 }, { 0x07EB, 0x07F3 }, { 0x0816, 0x082D }, { 0x0859, 0x085B },
+    { 0x08D3, 0x08FF }, { 0x0900, 0x0903 }, { 0x093A, 0x093C }, { 0x093E, 0x094F }, { 0x0951, 0x0957 },
+    { 0x0962, 0x0963 }, { 0x0981, 0x0983 }, { 0x09BC, 0x09BC }, { 0x09BE, 0x09CD }, { 0x09D7, 0x09D7 },
+    { 0x09E2, 0x09E3 }, { 0x0A01, 0x0A03 }, { 0x0A3C, 0x0A51 }, { 0x0A70, 0x0A71 }, { 0x0A75, 0x0A75 },
+    { 0x0A81, 0x0A83 }, { 0x0ABC, 0x0ABC }, { 0x0ABE, 0x0ACD }, { 0x0AE2, 0x0AE3 }, { 0x0B01, 0x0B03 },
+    { 0x0B3C, 0x0B3C }, { 0x0B3E, 0x0B57 }, { 0x0B62, 0x0B63 }, { 0x0B82, 0x0B82 }, { 0x0BBE, 0x0BCD },
+    { 0x0BD7, 0x0BD7 }, { 0x0C00, 0x0C04 }, { 0x0C3E, 0x0C56 }, { 0x0C62, 0x0C63 }, { 0x0C81, 0x0C83 },
+    { 0x0CBC, 0x0CBC }, { 0x0CBE, 0x0CD6 }, { 0x0CE2, 0x0CE3 }, { 0x0D00, 0x0D03 }, { 0x0D3B, 0x0D3C },
+    { 0x0D3E, 0x0D4D }, { 0x0D57, 0x0D57 }, { 0x0D62, 0x0D63 }, { 0x0D81, 0x0D83 }, { 0x0DCA, 0x0DDF },
+    { 0x0DF2, 0x0DF3 }, { 0x0E31, 0x0E31 }, { 0x0E34, 0x0E3A }, { 0x0E47, 0x0E4E }, { 0x0EB1, 0x0EB1 },
+    { 0x0EB4, 0x0EBC }, { 0x0EC8, 0x0ECD }, { 0x0F18, 0x0F19 }, { 0x0F35, 0x0F35 }, { 0x0F37, 0x0F37 },
+    { 0x0F39, 0x0F39 }, { 0x0F3E, 0x0F3F }, { 0x0F71, 0x0F84 }, { 0x0F86, 0x0F87 }, { 0x0F8D, 0x0FBC },
+    { 0x0FC6, 0x0FC6 }, { 0x102B, 0x103E }, { 0x1056, 0x1059 }, { 0x105E, 0x1060 }, { 0x1071, 0x1074 },
+    { 0x1082, 0x108D }, { 0x135D, 0x135F }, { 0x1712, 0x1714 }, { 0x1732, 0x1734 }, { 0x1752, 0x1753 },
+    { 0x1772, 0x1773 }, { 0x17B4, 0x17D3 }, { 0x17DD, 0x17DD }, { 0x180B, 0x180D }, { 0x18A9, 0x18A9 },
+    { 0x1920, 0x193B }, { 0x1A17, 0x1A1B }, { 0x1A55, 0x1A7F }, { 0x1AB0, 0x1AFF }, { 0x1B00, 0x1B04 },
+    { 0x1B34, 0x1B44 }, { 0x1B6B, 0x1B73 }, { 0x1B80, 0x1B82 }, { 0x1BA1, 0x1BAD }, { 0x1BE6, 0x1BF3 },
+    { 0x1C24, 0x1C37 }, { 0x1CD0, 0x1CD2 }, { 0x1CD4, 0x1CE8 }, { 0x1CED, 0x1CED }, { 0x1CF4, 0x1CF4 },
+    { 0x1CF7, 0x1CF9 }, { 0x1DC0, 0x1DFF }, { 0x200C, 0x200C }, { 0x20D0, 0x20F0 }, { 0x2CEF, 0x2CF1 },
+    { 0x2D7F, 0x2D7F }, { 0x2DE0, 0x2DFF }, { 0x302A, 0x302F }, { 0x3099, 0x309A }, { 0xA66F, 0xA672 },
+    { 0xA674, 0xA67D }, { 0xA69E, 0xA69F }, { 0xA6F0, 0xA6F1 }, { 0xA802, 0xA802 }, { 0xA806, 0xA806 },
+    { 0xA80B, 0xA80B }, { 0xA823, 0xA827 }, { 0xA880, 0xA881 }, { 0xA8B4, 0xA8C5 }, { 0xA8E0, 0xA8F1 },
+    { 0xA926, 0xA92D }, { 0xA947, 0xA953 }, { 0xA980, 0xA983 }, { 0xA9B3, 0xA9C0 }, { 0xAA29, 0xAA36 },
+    { 0xAAEB, 0xAAEF }, { 0xAAF5, 0xAAF6 }, { 0xABE3, 0xABEA }, { 0xABEC, 0xABED }, { 0xFB1E, 0xFB1E },
+    { 0xFE00, 0xFE0F }, { 0xFE20, 0xFE2F }, { 0xFF9E, 0xFF9F }, { 0x1D165, 0x1D169 }, { 0x1D16D, 0x1D172 },
+    { 0x1D17B, 0x1D182 }, { 0x1F3FB, 0x1F3FF }, { 0xE0020, 0xE007F }, { 0xE0100, 0xE01EF },
+};
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_utf8_is_extend(int cp) {
+    int lo = 0;
+    int hi = (int) (sizeof(ice_str_utf8_extend) / sizeof(ice_str_utf8_extend[0])) - 1;
+    
+    if (cp < 0x0300) {
+        return ICE_STR_FALSE;
+    }
+    
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        
+        if (cp < ice_str_utf8_extend[mid][0]) hi = mid - 1;
+        else if (cp > ice_str_utf8_extend[mid][1]) lo = mid + 1;
+        else return ICE_STR_TRUE;
+    }
+    
+    return ICE_STR_FALSE;
+}
+
+// Emoji and symbols that ZWJ joins into one cluster (Covers Extended_Pictographic blocks, Not exact list)
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_utf8_is_pictographic(int cp) {
+    return (cp == 0x00A9 || cp == 0x00AE || cp == 0x203C || cp == 0x2049 || cp == 0x2122 || cp == 0x2139 ||
+            (cp >= 0x2194 && cp <= 0x2BFF) || cp == 0x3030 || cp == 0x303D || cp == 0x3297 || cp == 0x3299 ||
+            (cp >= 0x1F000 && cp <= 0x1FAFF)) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Hangul syllable type, 1 = Leading consonant (L), 2 = Vowel (V), 3 = Trailing consonant (T), 4 = LV syllable, 5 = LVT syllable, 0 = Other
+ICE_STR_API int ICE_STR_CALLCONV ice_str_utf8_hangul(int cp) {
+    if ((cp >= 0x1100 && cp <= 0x115F) || (cp >= 0xA960 && cp <= 0xA97C)) return 1;
+    if ((cp >= 0x1160 && cp <= 0x11A7) || (cp >= 0xD7B0 && cp <= 0xD7C6)) return 2;
+    if ((cp >= 0x11A8 && cp <= 0x11FF) || (cp >= 0xD7CB && cp <= 0xD7FB)) return 3;
+    if (cp >= 0xAC00 && cp <= 0xD7A3) return ((cp - 0xAC00) % 28 == 0) ? 4 : 5;
+    return 0;
+}
+
+// Returns ICE_STR_TRUE if cp belongs to same grapheme cluster as prev (ri is count of regional indicators in row ending with prev)
+// Follows extended grapheme cluster rules except Prepend and Indic conjunct ones
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_utf8_joins(int prev, int cp, int ri) {
+    int hp, hc;
+    
+    if (prev == '\r') return (cp == '\n') ? ICE_STR_TRUE : ICE_STR_FALSE;
+    if (prev == '\n' || cp == '\r' || cp == '\n') return ICE_STR_FALSE;
+    if (cp == 0x200D || ice_str_utf8_is_extend(cp) == ICE_STR_TRUE) return ICE_STR_TRUE;
+    if (prev == 0x200D) return ice_str_utf8_is_pictographic(cp);
+    if (cp >= 0x1F1E6 && cp <= 0x1F1FF) return (ri % 2 == 1) ? ICE_STR_TRUE : ICE_STR_FALSE;
+    
+    hp = ice_str_utf8_hangul(prev);
+    hc = ice_str_utf8_hangul(cp);
+    
+    if (hp == 1) return (hc == 1 || hc == 2 || hc == 4 || hc == 5) ? ICE_STR_TRUE : ICE_STR_FALSE;
+    if (hp == 2 || hp == 4) return (hc == 2 || hc == 3) ? ICE_STR_TRUE : ICE_STR_FALSE;
+    if (hp == 3 || hp == 5) return (hc == 3) ? ICE_STR_TRUE : ICE_STR_FALSE;
+    return ICE_STR_FALSE;
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_is_ascii(char* str) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    int lenstr = k->len(str);
+    return (k->ascii(str, lenstr) == lenstr) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_utf8_valid(char* str) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    return k->utf8_valid(str, k->len(str));
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_utf8_valid_len(char* str, int len) {
+    return ice_str_get_kernels()->utf8_valid(str, len);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_utf8_len(char* str) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    return k->utf8_len(str, k->len(str));
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_utf8_offset(char* str, int index) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    return ice_str_utf8_skip(k, str, k->len(str), index);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_utf8_codepoint(char* str, int index) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    int lenstr = k->len(str);
+    int pos = ice_str_utf8_skip(k, str, lenstr, index);
+    int len;
+    
+    if (pos < 0 || pos == lenstr) {
+        return -1;
+    }
+    
+    return ice_str_utf8_decode((const unsigned char*) str + pos, lenstr - pos, &len);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_utf8_encode(int codepoint, char* res) {
+    if (codepoint < 0 || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        return 0;
+    }
+    
+    if (codepoint < 0x80) {
+        res[0] = (char) codepoint;
+        return 1;
+    }
+    
+    if (codepoint < 0x800) {
+        res[0] = (char) (0xC0 | (codepoint >> 6));
+        res[1] = (char) (0x80 | (codepoint & 0x3F));
+        return 2;
+    }
+    
+    if (codepoint < 0x10000) {
+        res[0] = (char) (0xE0 | (codepoint >> 12));
+        res[1] = (char) (0x80 | ((codepoint >> 6) & 0x3F));
+        res[2] = (char) (0x80 | (codepoint & 0x3F));
+        return 3;
+    }
+    
+    res[0] = (char) (0xF0 | (codepoint >> 18));
+    res[1] = (char) (0x80 | ((codepoint >> 12) & 0x3F));
+    res[2] = (char) (0x80 | ((codepoint >> 6) & 0x3F));
+    res[3] = (char) (0x80 | (codepoint & 0x3F));
+    return 4;
+}
+
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_utf8_char(char* str, int index) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    int lenstr = k->len(str);
+    int pos = ice_str_utf8_skip(k, str, lenstr, index);
+    int len = 0;
+    
+    if (pos >= 0 && pos < lenstr) {
+        ice_str_utf8_decode((const unsigned char*) str + pos, lenstr - pos, &len);
+    }
+    
+    return ice_str_view_to_str(ice_str_view_from_len(str + ((len > 0) ? pos : 0), len));
+}
+
+// Same as ice_str_sub with codepoint indexes (Clamped to string bounds), ASCII prefix is indexed by bytes directly
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_utf8_sub(char* str, int from, int to) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    int lenstr = k->len(str);
+    int start, end;
+    
+    if (from < 0) {
+        from = 0;
+    }
+    
+    if (to < from) {
+        return ice_str_view_to_str(ice_str_view_from_len(str, 0));
+    }
+    
+    start = ice_str_utf8_skip(k, str, lenstr, from);
+    if (start < 0) start = lenstr;
+    
+    end = ice_str_utf8_skip(k, str + start, lenstr - start, to - from + 1);
+    end = (end < 0) ? lenstr : start + end;
+    
+    return ice_str_view_to_str(ice_str_view_from_len(str + start, end - start));
+}
+
+// Reverses order of grapheme clusters, So combining marks, Emoji sequences, Flags and CR LF keep their order
+ICE_STR_API char* ICE_STR_CALLCONV ice_str_utf8_rev(char* str) {
+    ice_str_kernels* k = ice_str_get_kernels();
+    const unsigned char* s = (const unsigned char*) str;
+    int lenstr = k->len(str);
+    char* res = (char*) ICE_STR_MALLOC(lenstr + 1);
+    
+    if (res == NULL) {
+        return NULL;
+    }
+    
+    res[lenstr] = '\0';
+    
+    // ASCII text only has CR LF as multi-char cluster
+    if (k->ascii(str, lenstr) == lenstr) {
+        for (int i = 0; i < lenstr; i++) {
+            res[(lenstr - 1) - i] = str[i];
+        }
+        
+        if (k->find(str, lenstr, '\r') >= 0) {
+            for (int i = 0; i + 1 < lenstr; i++) {
+                if (res[i] == '\n' && res[i + 1] == '\r') {
+                    res[i] = '\r';
+                    res[i + 1] = '\n';
+                    i++;
+                }
+            }
+        }
+        
+        return res;
+    }
+    
+    int start = 0;
+    int prev = -1;
+    int ri = 0;
+    int i = 0;
+    
+    while (i < lenstr) {
+        int len;
+        int cp = ice_str_utf8_decode(s + i, lenstr - i, &len);
+        
+        if (i > 0 && ice_str_utf8_joins(prev, cp, ri) == ICE_STR_FALSE) {
+            memcpy(res + (lenstr - i), str + start, i - start);
+            start = i;
+        }
+        
+        ri = (cp >= 0x1F1E6 && cp <= 0x1F1FF) ? ri + 1 : 0;
+        prev = cp;
+        i += len;
+    }
+    
+    memcpy(res, str + start, lenstr - start);
+    return res;
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_view_utf8_valid(ice_str_view view) {
+    return ice_str_get_kernels()->utf8_valid(view.ptr, view.len);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_view_utf8_len(ice_str_view view) {
+    return ice_str_get_kernels()->utf8_len(view.ptr, view.len);
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_buf_utf8_valid(const ice_str_buf* buf) {
+    return ice_str_get_kernels()->utf8_valid(ice_str_buf_cstr(buf), buf->len);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_buf_utf8_len(const ice_str_buf* buf) {
+    return ice_str_get_kernels()->utf8_len(ice_str_buf_cstr(buf), buf->len);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ice_str NUMBERS
+///////////////////////////////////////////////////////////////////////////////////////////
+// Parsing and formatting never look at locale, Decimal point is always '.'.
+
+// 128 most significant bits of 5^q for q from -342 to 325 (Normalized so bit 127 is set), Rounded down except
+// for q from -27 to -1 where it's 1 more (Eisel-Lemire needs it that way), Ryu multipliers are derived from it
+static const unsigned long long ice_str_pow5_128[] = {
+    0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL, 0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL,
+    0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL, 0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL,
+    0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL, 0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL,
+    0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL, 0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL,
+    0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL, 0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL,
+    0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL, 0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL,
+    0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL, 0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL,
+    0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL, 0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL,
+    0x84A57695FE98746DULL, 0x014BB630F7604B57ULL, 0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL,
+    0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL, 0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL,
+    0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL, 0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL,
+    0xFD00B897478238D0ULL, 0x8920B098955522B4ULL, 0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL,
+    0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL, 0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL,
+    0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL, 0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL,
+    0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL, 0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL,
+    0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL, 0xEBA09271E88D976BULL, 0xF7864A44C633682EULL,
+    0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL, 0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL,
+    0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL, 0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL,
+    0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL, 0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL,
+    0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL, 0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL,
+    0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL, 0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL,
+    0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL, 0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL,
+    0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL, 0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL,
+    0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL, 0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL,
+    0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL, 0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL,
+    0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL, 0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL,
+    0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL, 0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL,
+    0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL, 0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL,
+    0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL, 0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL,
+    0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL, 0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL,
+    0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL, 0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL,
+    0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL, 0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL,
+    0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL, 0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL,
+    0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL, 0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL,
+    0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL, 0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL,
+    0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL, 0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL,
+    0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL, 0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL,
+    0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL, 0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL,
+    0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL, 0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL,
+    0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL, 0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL,
+    0xC987434744AC874EULL, 0xA327FFB266B56220ULL, 0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL,
+    0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL, 0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL,
+    0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL, 0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL,
+    0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL, 0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL,
+    0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL, 0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL,
+    0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL, 0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL,
+    0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL, 0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL,
+    0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL, 0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL,
+    0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL, 0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL,
+    0xAECC49914078536DULL, 0x58FAE9F773886E18ULL, 0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL,
+    0x888F99797A5E012DULL, 0x6D8406C952429603ULL, 0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL,
+    0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL, 0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL,
+    0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL, 0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL,
+    0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL, 0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL,
+    0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL, 0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL,
+    0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL, 0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL,
+    0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL, 0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL,
+    0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL, 0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL,
+    0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL, 0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL,
+    0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL, 0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL,
+    0xB913179899F68584ULL, 0x28E2557B59846E3FULL, 0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL,
+    0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL, 0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL,
+    0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL, 0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL,
+    0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL, 0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL,
+    0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL, 0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL,
+    0xD77485CB25823AC7ULL, 0x7D633293366B828BULL, 0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL,
+    0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL, 0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL,
+    0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL, 0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL,
+    0xCD795BE870516656ULL, 0x67902E276C921F8BULL, 0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL,
+    0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL, 0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL,
+    0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL, 0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL,
+    0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL, 0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL,
+    0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL, 0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL,
+    0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL, 0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL,
+    0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL, 0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL,
+    0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL, 0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL,
+    0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL, 0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL,
+    0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL, 0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL,
+    0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL, 0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL,
+    0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL, 0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL,
+    0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL, 0xD47487CC8470652BULL, 0x7647C3200069671FULL,
+    0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL, 0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL,
+    0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL, 0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL,
+    0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL, 0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL,
+    0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL, 0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL,
+    0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL, 0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL,
+    0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL, 0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL,
+    0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL, 0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL,
+    0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL, 0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL,
+    0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL, 0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL,
+    0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL, 0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL,
+    0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL, 0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL,
+    0x8C974F7383725573ULL, 0x1E414218C73A13FBULL, 0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL,
+    0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL, 0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL,
+    0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL, 0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL,
+    0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL, 0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL,
+    0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL, 0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL,
+    0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL, 0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL,
+    0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL, 0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL,
+    0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL, 0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL,
+    0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL, 0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL,
+    0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL, 0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL,
+    0xBE89523386091465ULL, 0xF6BBB397F1135823ULL, 0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL,
+    0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL, 0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL,
+    0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL, 0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL,
+    0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL, 0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL,
+    0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL, 0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL,
+    0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL, 0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL,
+    0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL, 0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL,
+    0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL, 0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL,
+    0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL, 0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL,
+    0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL, 0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL,
+    0x811CCC668829B887ULL, 0x0806357D5A3F525FULL, 0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL,
+    0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL, 0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL,
+    0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL, 0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL,
+    0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL, 0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL,
+    0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL, 0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL,
+    0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL, 0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL,
+    0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL, 0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL,
+    0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL, 0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL,
+    0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL, 0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL,
+    0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL, 0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL,
+    0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL, 0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL,
+    0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL, 0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL,
+    0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL, 0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL,
+    0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL, 0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL,
+    0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL, 0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL,
+    0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL, 0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL,
+    0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL, 0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL,
+    0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL, 0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL,
+    0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL, 0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL,
+    0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL, 0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL,
+    0xED246723473E3813ULL, 0x290123E9AAB23B68ULL, 0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL,
+    0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL, 0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL,
+    0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL, 0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL,
+    0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL, 0x8D590723948A535FULL, 0x579C487E5A38AD0EULL,
+    0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL, 0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL,
+    0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL, 0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL,
+    0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL, 0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL,
+    0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL, 0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL,
+    0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL, 0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL,
+    0xCDB02555653131B6ULL, 0x3792F412CB06794DULL, 0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL,
+    0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL, 0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL,
+    0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL, 0x9CED737BB6C4183DULL, 0x55464DD69685606BULL,
+    0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL, 0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL,
+    0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL, 0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL,
+    0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL, 0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL,
+    0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL, 0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL,
+    0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL, 0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL,
+    0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL, 0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL,
+    0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL, 0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL,
+    0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL, 0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL,
+    0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL, 0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL,
+    0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL, 0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL,
+    0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL, 0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL,
+    0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL, 0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL,
+    0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL, 0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL,
+    0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL, 0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL,
+    0xC612062576589DDAULL, 0x95364AFE032A819EULL, 0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL,
+    0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL, 0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL,
+    0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL, 0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL,
+    0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL, 0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL,
+    0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL, 0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL,
+    0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL, 0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL,
+    0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL, 0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL,
+    0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL, 0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL,
+    0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL, 0x89705F4136B4A597ULL, 0x31680A88F8953031ULL,
+    0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL, 0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL,
+    0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL, 0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL,
+    0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL, 0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL,
+    0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL, 0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL,
+    0x8000000000000000ULL, 0x0000000000000000ULL, 0xA000000000000000ULL, 0x0000000000000000ULL,
+    0xC800000000000000ULL, 0x0000000000000000ULL, 0xFA00000000000000ULL, 0x0000000000000000ULL,
+    0x9C40000000000000ULL, 0x0000000000000000ULL, 0xC350000000000000ULL, 0x0000000000000000ULL,
+    0xF424000000000000ULL, 0x0000000000000000ULL, 0x9896800000000000ULL, 0x0000000000000000ULL,
+    0xBEBC200000000000ULL, 0x0000000000000000ULL, 0xEE6B280000000000ULL, 0x0000000000000000ULL,
+    0x9502F90000000000ULL, 0x0000000000000000ULL, 0xBA43B74000000000ULL, 0x0000000000000000ULL,
+    0xE8D4A51000000000ULL, 0x0000000000000000ULL, 0x9184E72A00000000ULL, 0x0000000000000000ULL,
+    0xB5E620F480000000ULL, 0x0000000000000000ULL, 0xE35FA931A0000000ULL, 0x0000000000000000ULL,
+    0x8E1BC9BF04000000ULL, 0x0000000000000000ULL, 0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL,
+    0xDE0B6B3A76400000ULL, 0x0000000000000000ULL, 0x8AC7230489E80000ULL, 0x0000000000000000ULL,
+    0xAD78EBC5AC620000ULL, 0x0000000000000000ULL, 0xD8D726B7177A8000ULL, 0x0000000000000000ULL,
+    0x878678326EAC9000ULL, 0x0000000000000000ULL, 0xA968163F0A57B400ULL, 0x0000000000000000ULL,
+    0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL, 0x84595161401484A0ULL, 0x0000000000000000ULL,
+    0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL, 0xCECB8F27F4200F3AULL, 0x0000000000000000ULL,
+    0x813F3978F8940984ULL, 0x4000000000000000ULL, 0xA18F07D736B90BE5ULL, 0x5000000000000000ULL,
+    0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL, 0xFC6F7C4045812296ULL, 0x4D00000000000000ULL,
+    0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL, 0xC5371912364CE305ULL, 0x6C28000000000000ULL,
+    0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL, 0x9A130B963A6C115CULL, 0x3C7F400000000000ULL,
+    0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL, 0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL,
+    0x96769950B50D88F4ULL, 0x1314448000000000ULL, 0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL,
+    0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL, 0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL,
+    0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL, 0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL,
+    0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL, 0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL,
+    0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL, 0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL,
+    0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL, 0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL,
+    0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL, 0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL,
+    0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL, 0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL,
+    0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL, 0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL,
+    0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL, 0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL,
+    0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL, 0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL,
+    0x9F4F2726179A2245ULL, 0x01D762422C946590ULL, 0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL,
+    0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL, 0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL,
+    0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL, 0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL,
+    0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL, 0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL,
+    0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL, 0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL,
+    0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL, 0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL,
+    0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL, 0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL,
+    0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL, 0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL,
+    0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL, 0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL,
+    0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL, 0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL,
+    0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL, 0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL,
+    0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL, 0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL,
+    0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL, 0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL,
+    0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL, 0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL,
+    0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL, 0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL,
+    0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL, 0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL,
+    0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL, 0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL,
+    0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL, 0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL,
+    0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL, 0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL,
+    0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL, 0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL,
+    0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL, 0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL,
+    0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL, 0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL,
+    0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL, 0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL,
+    0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL, 0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL,
+    0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL, 0x884134FE908658B2ULL, 0x3109058D147FDCDDULL,
+    0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL, 0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL,
+    0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL, 0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL,
+    0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL, 0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL,
+    0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL, 0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL,
+    0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL, 0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL,
+    0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL, 0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL,
+    0x9AE757596946075FULL, 0x3375788DE9B06958ULL, 0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL,
+    0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL, 0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL,
+    0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL, 0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL,
+    0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL, 0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL,
+    0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL, 0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL,
+    0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL, 0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL,
+    0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL, 0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL,
+    0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL, 0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL,
+    0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL, 0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL,
+    0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL, 0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL,
+    0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL, 0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL,
+    0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL, 0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL,
+    0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL, 0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL,
+    0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL, 0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL,
+    0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL, 0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL,
+    0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL, 0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL,
+    0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL, 0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL,
+    0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL, 0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL,
+    0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL, 0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL,
+    0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL, 0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL,
+    0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL, 0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL,
+    0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL, 0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL,
+    0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL, 0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL,
+    0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL, 0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL,
+    0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL, 0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL,
+    0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL, 0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL,
+    0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL, 0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL,
+    0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL, 0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL,
+    0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL, 0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL,
+    0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL, 0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL,
+    0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL, 0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL,
+    0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL, 0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL,
+    0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL, 0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL,
+    0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL, 0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL,
+    0x8FA475791A569D10ULL, 0xF96E017D694487BCULL, 0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL,
+    0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL, 0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL,
+    0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL, 0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL,
+    0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL, 0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL,
+    0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL, 0x85C7056562757456ULL, 0xF6872D5667844E49ULL,
+    0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL, 0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL,
+    0x82A45B450226B39CULL, 0xECC0024661173473ULL, 0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL,
+    0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL, 0xFF290242C83396CEULL, 0x7E67047175A15271ULL,
+    0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL, 0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL,
+    0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL, 0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL,
+    0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL, 0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL,
+    0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL, 0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL,
+    0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL, 0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL,
+    0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL, 0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL,
+    0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL, 0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL,
+    0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL, 0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL,
+    0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL, 0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL,
+    0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL, 0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL,
+    0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL, 0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL,
+    0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL, 0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL,
+    0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL, 0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL,
+    0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL, 0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL,
+    0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL, 0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL,
+    0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL, 0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL,
+    0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL, 0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL,
+    0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL, 0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL,
+    0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL, 0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL,
+    0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL, 0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL,
+    0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL, 0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL,
+    0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL, 0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL,
+    0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL, 0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL,
+    0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL, 0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL,
+    0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL, 0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL,
+    0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL, 0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL,
+    0x8533285C936B35DEULL, 0xD53A88958F87275FULL, 0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL,
+    0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL, 0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL,
+    0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL, 0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL,
+    0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL, 0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL,
+    0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL, 0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL,
+    0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL, 0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL,
+    0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL, 0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL,
+    0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL, 0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL,
+    0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL, 0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL,
+    0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL, 0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL,
+    0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL, 0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL,
+    0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL, 0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL,
+    0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL, 0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL,
+    0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL, 0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL,
+    0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL, 0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL,
+    0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL, 0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL,
+    0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL, 0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL,
+    0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL, 0xA0555E361951C366ULL, 0xD7E105BCC332621FULL,
+    0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL, 0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL,
+    0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL, 0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL,
+    0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL, 0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL,
+    0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL, 0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL,
+    0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL, 0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL,
+    0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL, 0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL,
+    0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL, 0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL,
+    0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL, 0xB201833B35D63F73ULL, 0x2CD2CC6551E513DAULL,
+    0xDE81E40A034BCF4FULL, 0xF8077F7EA65E58D1ULL, 0x8B112E86420F6191ULL, 0xFB04AFAF27FAF782ULL,
+    0xADD57A27D29339F6ULL, 0x79C5DB9AF1F9B563ULL, 0xD94AD8B1C7380874ULL, 0x18375281AE7822BCULL,
+    0x87CEC76F1C830548ULL, 0x8F2293910D0B15B5ULL, 0xA9C2794AE3A3C69AULL, 0xB2EB3875504DDB22ULL,
+    0xD433179D9C8CB841ULL, 0x5FA60692A46151EBULL, 0x849FEEC281D7F328ULL, 0xDBC7C41BA6BCD333ULL,
+    0xA5C7EA73224DEFF3ULL, 0x12B9B522906C0800ULL, 0xCF39E50FEAE16BEFULL, 0xD768226B34870A00ULL,
+    0x81842F29F2CCE375ULL, 0xE6A1158300D46640ULL, 0xA1E53AF46F801C53ULL, 0x60495AE3C1097FD0ULL,
+    0xCA5E89B18B602368ULL, 0x385BB19CB14BDFC4ULL, 0xFCF62C1DEE382C42ULL, 0x46729E03DD9ED7B5ULL,
+    0x9E19DB92B4E31BA9ULL, 0x6C07A2C26A8346D1ULL, 0xC5A05277621BE293ULL, 0xC7098B7305241885ULL,
+};
+
+// Clinger fast path needs double operations rounded once (Not through x87 80-bit registers)
+#if (defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0) || defined(_M_X64) || defined(_M_ARM64)
+#  define ICE_STR_CLINGER 1
+#else
+#  define ICE_STR_CLINGER 0
+#endif
+
+// Doubles holding 10^0 to 10^22 exactly
+static const double ice_str_pow10_f64[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_clz64(unsigned long long x) {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    unsigned long i;
+    _BitScanReverse64(&i, x);
+    return 63 - (int) i;
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    int res = 0;
+    while (!(x & (1ULL << 63))) { x <<= 1; res++; }
+    return res;
+#endif
+}
+
+ICE_STR_API double ICE_STR_CALLCONV ice_str_f64_from_bits(unsigned long long bits) {
+    double res;
+    memcpy(&res, &bits, 8);
+    return res;
+}
+
+// Little endian 8 byte load written byte by byte, Compilers turn it into single load on little endian CPUs
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_load_le64(const unsigned char* p) {
+    return (unsigned long long) p[0] | ((unsigned long long) p[1] << 8) | ((unsigned long long) p[2] << 16) |
+           ((unsigned long long) p[3] << 24) | ((unsigned long long) p[4] << 32) | ((unsigned long long) p[5] << 40) |
+           ((unsigned long long) p[6] << 48) | ((unsigned long long) p[7] << 56);
+}
+
+// Checks if all 8 bytes are digits (Adding 6 carries into high nibble of bytes above '9')
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_is_8_digits(unsigned long long v) {
+    return (((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+// Converts 8 digits to number with 3 multiplications (Pairs, Then quads, Then both halves)
+ICE_STR_API unsigned int ICE_STR_CALLCONV ice_str_parse_8_digits(unsigned long long v) {
+    v -= 0x3030303030303030ULL;
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) + (((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return (unsigned int) v;
+}
+
+// Eisel-Lemire (Lemire, "Number Parsing at a Gigabyte per Second"), Returns bits of double nearest to w * 10^q
+// 128-bit product is always enough for exact w (Mushtak and Lemire, "Fast Number Parsing Without Fallback")
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_eisel_lemire(unsigned long long w, int q) {
+    unsigned long long lo, hi, lo2, hi2, mantissa;
+    int lz, upper, power2;
+    
+    if (w == 0 || q < -342) return 0;
+    if (q > 308) return 0x7FF0000000000000ULL;
+    
+    lz = ice_str_clz64(w);
+    w <<= lz;
+    
+    lo = w;
+    hi = ice_str_pow5_128[(q + 342) * 2];
+    ice_str_mul128(&lo, &hi);
+    
+    // Low bits of high half are all ones, So product could carry into them from second half of power
+    if ((hi & 0x1FF) == 0x1FF) {
+        lo2 = w;
+        hi2 = ice_str_pow5_128[(q + 342) * 2 + 1];
+        ice_str_mul128(&lo2, &hi2);
+        lo += hi2;
+        if (hi2 > lo) hi++;
+    }
+    
+    upper = (int) (hi >> 63);
+    mantissa = hi >> (upper + 9);
+    power2 = ((217706 * q) >> 16) + 63 + upper - lz + 1023;
+    
+    if (power2 <= 0) {
+        if (-power2 + 1 >= 64) return 0;
+        
+        mantissa >>= -power2 + 1;
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+        power2 = (mantissa < (1ULL << 52)) ? 0 : 1;
+        return ((unsigned long long) power2 << 52) | (mantissa & ((1ULL << 52) - 1));
+    }
+    
+    // Exactly halfway between 2 doubles (Only possible for small q), Round to even
+    if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << (upper + 9)) == hi) {
+        mantissa &= ~1ULL;
+    }
+    
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    
+    if (mantissa >= (2ULL << 52)) {
+        mantissa = 1ULL << 52;
+        power2++;
+    }
+    
+    if (power2 >= 0x7FF) return 0x7FF0000000000000ULL;
+    return ((unsigned long long) power2 << 52) | (mantissa & ((1ULL << 52) - 1));
+}
+
+// Decimal with up to 800 digits for numbers Eisel-Lemire can't decide (More than 19 digits), Converted by shifting
+// it by powers of 2 until it's in range of mantissa (Same algorithm as Go strconv)
+typedef struct ice_str_decimal {
+    unsigned char d[800];                   // Digits (0 to 9, No leading or trailing zeros)
+    int nd;                                 // Count of digits
+    int dp;                                 // Position of decimal point (Value is 0.d * 10^dp)
+    int trunc;                              // 1 if non-zero digits were dropped after d
+} ice_str_decimal;
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_decimal_trim(ice_str_decimal* a) {
+    while (a->nd > 0 && a->d[a->nd - 1] == 0) a->nd--;
+    if (a->nd == 0) a->dp = 0;
+}
+
+// Multiplies by 2^k (k <= 60), Digits are produced from last one so carries go left
+ICE_STR_API void ICE_STR_CALLCONV ice_str_decimal_lshift(ice_str_decimal* a, int k) {
+    unsigned char tmp[820];
+    unsigned long long carry = 0;
+    int w = 820;
+    
+    for (int r = a->nd - 1; r >= 0; r--) {
+        unsigned long long n = ((unsigned long long) a->d[r] << k) + carry;
+        tmp[--w] = (unsigned char) (n % 10);
+        carry = n / 10;
+    }
+    
+    while (carry > 0) {
+        tmp[--w] = (unsigned char) (carry % 10);
+        carry /= 10;
+    }
+    
+    int nd = 820 - w;
+    a->dp += nd - a->nd;
+    
+    if (nd > 800) {
+        for (int i = w + 800; i < 820; i++) {
+            if (tmp[i] != 0) a->trunc = 1;
+        }
+        
+        nd = 800;
+    }
+    
+    memcpy(a->d, tmp + w, nd);
+    a->nd = nd;
+    ice_str_decimal_trim(a);
+}
+
+// Divides by 2^k (k <= 60), Digits are produced from first one
+ICE_STR_API void ICE_STR_CALLCONV ice_str_decimal_rshift(ice_str_decimal* a, int k) {
+    unsigned long long n = 0;
+    unsigned long long mask = (1ULL << k) - 1;
+    int r = 0;
+    int w = 0;
+    
+    for (; (n >> k) == 0; r++) {
+        if (r >= a->nd) {
+            if (n == 0) {
+                a->nd = 0;
+                return;
+            }
+            
+            while ((n >> k) == 0) {
+                n *= 10;
+                r++;
+            }
+            
+            break;
+        }
+        
+        n = n * 10 + a->d[r];
+    }
+    
+    a->dp -= r - 1;
+    
+    for (; r < a->nd; r++) {
+        unsigned long long c = a->d[r];
+        a->d[w++] = (unsigned char) (n >> k);
+        n = ((n & mask) * 10) + c;
+    }
+    
+    while (n > 0) {
+        unsigned char dig = (unsigned char) (n >> k);
+        n &= mask;
+        
+        if (w < 800) a->d[w++] = dig;
+        else if (dig > 0) a->trunc = 1;
+        
+        n *= 10;
+    }
+    
+    a->nd = w;
+    ice_str_decimal_trim(a);
+}
+
+ICE_STR_API void ICE_STR_CALLCONV ice_str_decimal_shift(ice_str_decimal* a, int k) {
+    if (a->nd == 0) return;
+    
+    for (; k > 60; k -= 60) ice_str_decimal_lshift(a, 60);
+    for (; k < -60; k += 60) ice_str_decimal_rshift(a, 60);
+    
+    if (k > 0) ice_str_decimal_lshift(a, k);
+    else if (k < 0) ice_str_decimal_rshift(a, -k);
+}
+
+// Integer part of decimal rounded half to even (Dropped digits count as above half)
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_decimal_round(const ice_str_decimal* a) {
+    unsigned long long n = 0;
+    int i = 0;
+    int up;
+    
+    if (a->dp > 20) return 0xFFFFFFFFFFFFFFFFULL;
+    
+    for (; i < a->dp && i < a->nd; i++) n = n * 10 + a->d[i];
+    for (; i < a->dp; i++) n *= 10;
+    
+    if (a->dp < 0 || a->dp >= a->nd) up = 0;
+    else if (a->d[a->dp] == 5 && a->dp + 1 == a->nd) up = a->trunc || (a->dp > 0 && (a->d[a->dp - 1] & 1));
+    else up = (a->d[a->dp] >= 5);
+    
+    return n + up;
+}
+
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_decimal_to_bits(ice_str_decimal* a) {
+    static const int powtab[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+    unsigned long long mant;
+    int exp = 0;
+    
+    if (a->nd == 0 || a->dp < -330) return 0;
+    if (a->dp > 310) return 0x7FF0000000000000ULL;
+    
+    // Scale to [0.5, 1) by powers of 2 that move decimal point by about 1 digit each
+    while (a->dp > 0) {
+        int n = (a->dp >= 9) ? 27 : powtab[a->dp];
+        ice_str_decimal_shift(a, -n);
+        exp += n;
+    }
+    
+    while (a->dp < 0 || (a->dp == 0 && a->d[0] < 5)) {
+        int n = (-a->dp >= 9) ? 27 : powtab[-a->dp];
+        ice_str_decimal_shift(a, n);
+        exp -= n;
+    }
+    
+    exp--;
+    
+    // Subnormal, Exponent stays at minimum and mantissa loses bits instead
+    if (exp < -1022) {
+        ice_str_decimal_shift(a, exp + 1022);
+        exp = -1022;
+    }
+    
+    if (exp + 1023 >= 0x7FF) return 0x7FF0000000000000ULL;
+    
+    ice_str_decimal_shift(a, 53);
+    mant = ice_str_decimal_round(a);
+    
+    if (mant == (2ULL << 52)) {
+        mant >>= 1;
+        exp++;
+        if (exp + 1023 >= 0x7FF) return 0x7FF0000000000000ULL;
+    }
+    
+    if ((mant & (1ULL << 52)) == 0) exp = -1023;
+    return ((unsigned long long) (exp + 1023) << 52) | (mant & ((1ULL << 52) - 1));
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_match_word_nocase(const char* str, int len, const char* word) {
+    int i = 0;
+    
+    for (; word[i] != '\0'; i++) {
+        if (i >= len || ice_str_lower_table[(unsigned char) str[i]] != (unsigned char) word[i]) return ICE_STR_FALSE;
+    }
+    
+    return ICE_STR_TRUE;
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_parse_f64(char* str, int len, double* res) {
+    const unsigned char* s = (const unsigned char*) str;
+    unsigned long long w = 0;
+    unsigned long long bits;
+    int neg = 0;
+    int i = 0;
+    int digits = 0;                         // Significant digits seen (Without leading zeros)
+    int dropped = 0;                        // Integer digits that didn't fit in w
+    int truncated = 0;                      // 1 if non-zero digit didn't fit in w
+    int frac = 0;                           // Digits in w that are after decimal point
+    int int_start, frac_start = -1;
+    int exp = 0;
+    int end;
+    
+    if (i < len && (s[i] == '-' || s[i] == '+')) {
+        neg = (s[i] == '-');
+        i++;
+    }
+    
+    if (i < len && (s[i] < '0' || s[i] > '9') && s[i] != '.') {
+        if (ice_str_match_word_nocase(str + i, len - i, "nan") == ICE_STR_TRUE) {
+            *res = ice_str_f64_from_bits(0x7FF8000000000000ULL | ((unsigned long long) neg << 63));
+            return i + 3;
+        }
+        
+        if (ice_str_match_word_nocase(str + i, len - i, "inf") == ICE_STR_TRUE) {
+            *res = ice_str_f64_from_bits(0x7FF0000000000000ULL | ((unsigned long long) neg << 63));
+            return i + ((ice_str_match_word_nocase(str + i, len - i, "infinity") == ICE_STR_TRUE) ? 8 : 3);
+        }
+        
+        return 0;
+    }
+    
+    int_start = i;
+    while (i < len && s[i] == '0') i++;
+    
+    // Leading zeros are skipped, So every digit from here is significant (Taken 8 at once while they fit in w)
+    while (digits <= 11 && i + 8 <= len && ice_str_is_8_digits(ice_str_load_le64(s + i)) == ICE_STR_TRUE) {
+        w = w * 100000000 + ice_str_parse_8_digits(ice_str_load_le64(s + i));
+        digits += 8;
+        i += 8;
+    }
+    
+    for (; i < len && s[i] >= '0' && s[i] <= '9'; i++) {
+        if (digits < 19) {
+            w = w * 10 + (s[i] - '0');
+            digits++;
+        } else {
+            dropped++;
+            truncated |= (s[i] != '0');
+        }
+    }
+    
+    int int_end = i;
+    
+    if (i < len && s[i] == '.') {
+        i++;
+        frac_start = i;
+        
+        if (w == 0) {
+            while (i < len && s[i] == '0') {
+                i++;
+                frac++;
+            }
+        }
+        
+        while (digits <= 11 && i + 8 <= len && ice_str_is_8_digits(ice_str_load_le64(s + i)) == ICE_STR_TRUE) {
+            w = w * 100000000 + ice_str_parse_8_digits(ice_str_load_le64(s + i));
+            digits += 8;
+            frac += 8;
+            i += 8;
+        }
+        
+        for (; i < len && s[i] >= '0' && s[i] <= '9'; i++) {
+            if (digits < 19) {
+                w = w * 10 + (s[i] - '0');
+                digits++;
+                frac++;
+            } else {
+                truncated |= (s[i] != '0');
+            }
+        }
+    }
+    
+    // Needs at least 1 digit, "." alone isn't number
+    if (int_end == int_start && (frac_start < 0 || i == frac_start)) {
+        return 0;
+    }
+    
+    end = i;
+    
+    if (i < len && (s[i] == 'e' || s[i] == 'E')) {
+        int eneg = 0;
+        i++;
+        
+        if (i < len && (s[i] == '-' || s[i] == '+')) {
+            eneg = (s[i] == '-');
+            i++;
+        }
+        
+        if (i < len && s[i] >= '0' && s[i] <= '9') {
+            for (; i < len && s[i] >= '0' && s[i] <= '9'; i++) {
+                if (exp < 100000) exp = exp * 10 + (s[i] - '0');
+            }
+            
+            exp = eneg ? -exp : exp;
+            end = i;
+        }
+    }
+    
+    int q = exp + dropped - frac;
+    
+    if (w == 0) {
+        bits = 0;
+    } else if (!truncated && q >= -22 && q <= 22 && w <= (1ULL << 53) && ICE_STR_CLINGER) {
+        // Clinger fast path, w and 10^|q| are exact doubles so single multiply or divide rounds correctly
+        double d = (double) w;
+        d = (q < 0) ? d / ice_str_pow10_f64[-q] : d * ice_str_pow10_f64[q];
+        *res = neg ? -d : d;
+        return end;
+    } else {
+        bits = ice_str_eisel_lemire(w, q);
+        
+        // w lost digits, So real value is between w and w + 1 and both must round to same double
+        if (truncated && bits != ice_str_eisel_lemire(w + 1, q)) {
+            ice_str_decimal dec;
+            int seen_point = 0;
+            
+            dec.nd = 0;
+            dec.dp = 0;
+            dec.trunc = 0;
+            
+            for (int j = int_start; j < end && s[j] != 'e' && s[j] != 'E'; j++) {
+                if (s[j] == '.') {
+                    seen_point = 1;
+                    continue;
+                }
+                
+                if (dec.nd == 0 && s[j] == '0') {
+                    if (seen_point) dec.dp--;
+                    continue;
+                }
+                
+                if (!seen_point) dec.dp++;
+                
+                if (dec.nd < 800) dec.d[dec.nd++] = (unsigned char) (s[j] - '0');
+                else if (s[j] != '0') dec.trunc = 1;
+            }
+            
+            dec.dp += exp;
+            ice_str_decimal_trim(&dec);
+            bits = ice_str_decimal_to_bits(&dec);
+        }
+    }
+    
+    *res = ice_str_f64_from_bits(bits | ((unsigned long long) neg << 63));
+    return end;
+}
+
+// Ryu multiplier for 5^i (125 bits, Rounded down), res[0] is low half and res[1] is high half
+ICE_STR_API void ICE_STR_CALLCONV ice_str_ryu_pow5(int i, unsigned long long* res) {
+    unsigned long long hi = ice_str_pow5_128[(i + 342) * 2];
+    unsigned long long lo = ice_str_pow5_128[(i + 342) * 2 + 1];
+    
+    res[0] = (lo >> 3) | (hi << 61);
+    res[1] = hi >> 3;
+}
+
+// Ryu multiplier for 1 / 5^i (125 bits, Rounded down then incremented)
+ICE_STR_API void ICE_STR_CALLCONV ice_str_ryu_pow5_inv(int i, unsigned long long* res) {
+    unsigned long long hi = ice_str_pow5_128[(342 - i) * 2];
+    unsigned long long lo = ice_str_pow5_128[(342 - i) * 2 + 1];
+    
+    // 1 / 5^0 is power of 2, So it isn't normalized same way as others
+    if (i == 0) {
+        res[0] = 1;
+        res[1] = 1ULL << 61;
+        return;
+    }
+    
+    // Undo extra 1 table has for q from -27 to -1
+    if (i <= 27) {
+        if (lo == 0) hi--;
+        lo--;
+    }
+    
+    res[0] = ((lo >> 3) | (hi << 61)) + 1;
+    res[1] = (hi >> 3) + (res[0] == 0);
+}
+
+// (m * mul) >> j for 125-bit mul (64 < j < 128)
+ICE_STR_API unsigned long long ICE_STR_CALLCONV ice_str_ryu_mul_shift(unsigned long long m, const unsigned long long* mul, int j) {
+    unsigned long long lo0 = m, hi0 = mul[0];
+    unsigned long long lo1 = m, hi1 = mul[1];
+    
+    ice_str_mul128(&lo0, &hi0);
+    ice_str_mul128(&lo1, &hi1);
+    
+    lo1 += hi0;
+    hi1 += (lo1 < hi0);
+    j -= 64;
+    return (hi1 << (64 - j)) | (lo1 >> j);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_pow5_factor(unsigned long long v) {
+    int res = 0;
+    
+    while (v % 5 == 0) {
+        v /= 5;
+        res++;
+    }
+    
+    return res;
+}
+
+// Ryu (Adams, "Ryu: Fast Float-to-String Conversion"), Finds shortest digits that read back as same double
+// Double is mantissa * 10^exp10 after call (Only for finite non-zero doubles)
+ICE_STR_API void ICE_STR_CALLCONV ice_str_ryu(unsigned long long bits, unsigned long long* mantissa, int* exp10) {
+    unsigned long long ieee_m = bits & ((1ULL << 52) - 1);
+    int ieee_e = (int) ((bits >> 52) & 0x7FF);
+    unsigned long long m2, mv, vr, vp, vm, output;
+    unsigned long long mul[2];
+    int e2, e10, q;
+    int accept, mm_shift;
+    int vm_tz = 0, vr_tz = 0;
+    int removed = 0;
+    int last = 0;
+    
+    // Integers below 2^53 are exact, So only their trailing zeros need removing
+    if (ieee_e >= 1023 && ieee_e <= 1023 + 52) {
+        int shift = 1023 + 52 - ieee_e;
+        m2 = (1ULL << 52) | ieee_m;
+        
+        if ((m2 & ((1ULL << shift) - 1)) == 0) {
+            m2 >>= shift;
+            e10 = 0;
+            
+            while (m2 % 10 == 0) {
+                m2 /= 10;
+                e10++;
+            }
+            
+            *mantissa = m2;
+            *exp10 = e10;
+            return;
+        }
+    }
+    
+    if (ieee_e == 0) {
+        e2 = 1 - 1023 - 52 - 2;
+        m2 = ieee_m;
+    } else {
+        e2 = ieee_e - 1023 - 52 - 2;
+        m2 = (1ULL << 52) | ieee_m;
+    }
+    
+    // Halfway points round to even, So for even mantissa both bounds belong to it
+    accept = ((m2 & 1) == 0);
+    mv = 4 * m2;
+    mm_shift = (ieee_m != 0 || ieee_e <= 1);
+    
+    if (e2 >= 0) {
+        q = ((e2 * 78913) >> 18) - (e2 > 3);
+        e10 = q;
+        
+        int i = -e2 + q + 125 + ((q * 1217359) >> 19);
+        ice_str_ryu_pow5_inv(q, mul);
+        vr = ice_str_ryu_mul_shift(4 * m2, mul, i);
+        vp = ice_str_ryu_mul_shift(4 * m2 + 2, mul, i);
+        vm = ice_str_ryu_mul_shift(4 * m2 - 1 - mm_shift, mul, i);
+        
+        if (q <= 21) {
+            if (mv % 5 == 0) vr_tz = (ice_str_pow5_factor(mv) >= q);
+            else if (accept) vm_tz = (ice_str_pow5_factor(mv - 1 - mm_shift) >= q);
+            else vp -= (ice_str_pow5_factor(mv + 2) >= q);
+        }
+    } else {
+        q = ((-e2 * 732923) >> 20) - (-e2 > 1);
+        e10 = q + e2;
+        
+        int i = -e2 - q;
+        int j = q - (((i * 1217359) >> 19) + 1 - 125);
+        ice_str_ryu_pow5(i, mul);
+        vr = ice_str_ryu_mul_shift(4 * m2, mul, j);
+        vp = ice_str_ryu_mul_shift(4 * m2 + 2, mul, j);
+        vm = ice_str_ryu_mul_shift(4 * m2 - 1 - mm_shift, mul, j);
+        
+        if (q <= 1) {
+            vr_tz = 1;
+            if (accept) vm_tz = (mm_shift == 1);
+            else vp--;
+        } else if (q < 63) {
+            vr_tz = ((mv & ((1ULL << q) - 1)) == 0);
+        }
+    }
+    
+    // Removes digits while interval (vm, vp) still holds number with fewer digits
+    if (vm_tz || vr_tz) {
+        while (vp / 10 > vm / 10) {
+            vm_tz &= (vm % 10 == 0);
+            vr_tz &= (last == 0);
+            last = (int) (vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        
+        if (vm_tz) {
+            while (vm % 10 == 0) {
+                vr_tz &= (last == 0);
+                last = (int) (vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        
+        if (vr_tz && last == 5 && vr % 2 == 0) last = 4;
+        output = vr + ((vr == vm && (!accept || !vm_tz)) || last >= 5);
+    } else {
+        int up = 0;
+        
+        while (vp / 10 > vm / 10) {
+            up = (vr % 10 >= 5);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        
+        output = vr + (vr == vm || up);
+    }
+    
+    *mantissa = output;
+    *exp10 = e10 + removed;
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_fmt_f64(double num, char* res) {
+    unsigned long long bits;
+    unsigned long long mantissa;
+    char digits[24];
+    char* start;
+    char* p = res;
+    int exp10, n, dp;
+    
+    memcpy(&bits, &num, 8);
+    
+    if (((bits >> 52) & 0x7FF) == 0x7FF) {
+        if (bits & ((1ULL << 52) - 1)) {
+            memcpy(res, "nan", 4);
+            return 3;
+        }
+        
+        if (bits >> 63) *p++ = '-';
+        memcpy(p, "inf", 4);
+        return (int) (p - res) + 3;
+    }
+    
+    if (bits >> 63) *p++ = '-';
+    
+    if ((bits & 0x7FFFFFFFFFFFFFFFULL) == 0) {
+        memcpy(p, "0", 2);
+        return (int) (p - res) + 1;
+    }
+    
+    ice_str_ryu(bits, &mantissa, &exp10);
+    start = ice_str_fmt_uint(digits + 24, mantissa);
+    n = (int) (digits + 24 - start);
+    dp = n + exp10;
+    
+    // Same layout as JavaScript Number to String, Plain digits when point is near them, Else exponent
+    if (dp >= n && dp <= 21) {
+        memcpy(p, start, n);
+        memset(p + n, '0', dp - n);
+        p += dp;
+    } else if (dp > 0 && dp <= 21) {
+        memcpy(p, start, dp);
+        p[dp] = '.';
+        memcpy(p + dp + 1, start + dp, n - dp);
+        p += n + 1;
+    } else if (dp > -6 && dp <= 0) {
+        p[0] = '0';
+        p[1] = '.';
+        memset(p + 2, '0', -dp);
+        memcpy(p + 2 - dp, start, n);
+        p += 2 - dp + n;
+    } else {
+        int e = dp - 1;
+        *p++ = start[0];
+        
+        if (n > 1) {
+            *p++ = '.';
+            memcpy(p, start + 1, n - 1);
+            p += n - 1;
+        }
+        
+        *p++ = 'e';
+        *p++ = (e < 0) ? '-' : '+';
+        e = (e < 0) ? -e : e;
+        
+        if (e >= 100) *p++ = (char) ('0' + e / 100);
+        if (e >= 10) *p++ = (char) ('0' + (e / 10) % 10);
+        *p++ = (char) ('0' + e % 10);
+    }
+    
+    *p = '\0';
+    return (int) (p - res);
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_parse_i64(char* str, int len, long long* res) {
+    const unsigned char* s = (const unsigned char*) str;
+    unsigned long long n = 0;
+    int neg = 0;
+    int i = 0;
+    int start;
+    
+    if (i < len && (s[i] == '-' || s[i] == '+')) {
+        neg = (s[i] == '-');
+        i++;
+    }
+    
+    start = i;
+    while (i < len && s[i] == '0') i++;
+    
+    int digits = i;
+    
+    if (i + 8 <= len && ice_str_is_8_digits(ice_str_load_le64(s + i)) == ICE_STR_TRUE) {
+        n = ice_str_parse_8_digits(ice_str_load_le64(s + i));
+        i += 8;
+        
+        if (i + 8 <= len && ice_str_is_8_digits(ice_str_load_le64(s + i)) == ICE_STR_TRUE) {
+            n = n * 100000000 + ice_str_parse_8_digits(ice_str_load_le64(s + i));
+            i += 8;
+        }
+    }
+    
+    for (; i < len && s[i] >= '0' && s[i] <= '9'; i++) {
+        // 20 digits could overflow 64 bits, More than 20 always do
+        if (i - digits >= 19) {
+            if (i - digits >= 20 || n > (0xFFFFFFFFFFFFFFFFULL - (s[i] - '0')) / 10) return 0;
+        }
+        
+        n = n * 10 + (s[i] - '0');
+    }
+    
+    if (i == start || n > (neg ? (1ULL << 63) : (1ULL << 63) - 1)) {
+        return 0;
+    }
+    
+    *res = neg ? (long long) (0ULL - n) : (long long) n;
+    return i;
+}
+
+ICE_STR_API int ICE_STR_CALLCONV ice_str_fmt_i64(long long num, char* res) {
+    char tmp[24];
+    char* start = ice_str_fmt_uint(tmp + 24, (num < 0) ? (0ULL - (unsigned long long) num) : (unsigned long long) num);
+    int len = (int) (tmp + 24 - start);
+    
+    if (num < 0) {
+        *res++ = '-';
+    }
+    
+    memcpy(res, start, len);
+    res[len] = '\0';
+    return len + (num < 0);
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_view_parse_f64(ice_str_view view, double* res) {
+    return (view.len > 0 && ice_str_parse_f64(view.ptr, view.len, res) == view.len) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
+ICE_STR_API ice_str_bool ICE_STR_CALLCONV ice_str_view_parse_i64(ice_str_view view, long long* res) {
+    return (view.len > 0 && ice_str_parse_i64(view.ptr, view.len, res) == view.len) ? ICE_STR_TRUE : ICE_STR_FALSE;
+}
+
 #endif  // ICE_STR_IMPL
 #endif  // ICE_STR_H
@@ -0,0 +1,29 @@
+#define ICE_ARENA_IMPL
+#include "ice_arena.h"
+#define ICE_ARR_IMPL
+#define ICE_ARR_USE_ARENA
+#include <stdio.h>
+#include "ice_arr.h"
+
+int main(int argc, char** argv) {
+    ice_arena frame = ice_arena_new(0);
+    
+    for (int f = 0; f < 3; f++) {
+        ice_arena_push(&frame);
+        
+        // Allocated from frame arena, No need to free
+        ice_arr_array arr = ice_arr_new(10);
+        
+        for (int i = 0; i < arr.len; i++) {
+            ice_arr_set(&arr, i, i * f);
+        }
+        
+        printf("Frame %d: Sum is %f, Arena used %d bytes\n", f, ice_arr_sum(arr), (int) ice_arena_used(&frame));
+        
+        ice_arena_pop();
+        ice_arena_reset(&frame);
+    }
+    
+    ice_arena_free(&frame);
+    return 0;
+}